@@ -0,0 +1,1268 @@
+///
+/// @file Common_Benchmark.ino
+/// @brief Protocol for graphics and text throughput
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @see ReadMe.md for references
+/// @n
+///
+/// Release 821: First release
+///
+
+// Screen
+#include "PDLS_EXT3_Basic_Global.h"
+
+// SDK
+// #include <Arduino.h>
+#include "hV_HAL_Peripherals.h"
+
+// Include application, user and local libraries
+// #include <SPI.h>
+
+// Configuration
+#include "hV_Configuration.h"
+
+// Set parameters, 1 to select a section
+#define BENCHMARK_CLEAR 0
+#define BENCHMARK_FORMS 0
+#define BENCHMARK_TEXT 0
+#define BENCHMARK_UTF8 0
+#define BENCHMARK_BITMAP 0
+#define BENCHMARK_PARALLEL 0
+#define BENCHMARK_COMPRESSION 0
+#define BENCHMARK_STORAGE 0
+#define BENCHMARK_LAYOUT 0
+#define BENCHMARK_TILES 0
+#define BENCHMARK_GPIO 0
+#define BENCHMARK_SPI3 0
+#define BENCHMARK_CLOCK 0
+#define BENCHMARK_TRACE 0
+#define BENCHMARK_ESTIMATE 0
+#define BENCHMARK_POWER 0
+#define BENCHMARK_SOLID 0
+
+///
+/// @brief Number of shapes per run
+///
+#define BENCHMARK_NUMBER 200
+
+// Define structures and classes
+
+// Define constants and variables
+Screen_EPD_EXT3 myScreen(eScreen_EPD_266_CS_0C, boardRaspberryPiPico_RP2040);
+// Screen_EPD_EXT3 myScreen(eScreen_EPD_B98_JS_0B, boardRaspberryPiPico_RP2040);
+
+#if (BENCHMARK_PARALLEL == 1)
+
+// Second screen sharing the frame-buffer of myScreen, for the second core
+Screen_EPD_EXT3 myBand(eScreen_EPD_266_CS_0C, boardRaspberryPiPico_RP2040);
+
+///
+/// @brief Buffer for recorded commands
+///
+uint8_t recordBuffer[8192];
+
+#endif // BENCHMARK_PARALLEL
+
+#if (BENCHMARK_STORAGE == 1)
+
+///
+/// @brief Static frame-buffer, screenSizeX() * screenSizeY() / 4 bytes, here for the 2.66"
+///
+alignas(4) uint8_t frameBuffer[152 * 296 / 4];
+
+#endif // BENCHMARK_STORAGE
+
+// Prototypes
+
+// Utilities
+///
+/// @brief Report a benchmark result
+/// @param label name of the test
+/// @param number number of operations
+/// @param chrono duration, us
+///
+void report(const char * label, uint32_t number, uint32_t chrono)
+{
+    mySerial.println(formatString("%-24s %6i in %8i us = %6i us each", label, number, chrono, chrono / hV_HAL_max(number, 1)));
+}
+
+#if (BENCHMARK_STORAGE == 1) or (BENCHMARK_LAYOUT == 1) or (BENCHMARK_TILES == 1)
+
+///
+/// @brief Setting applied to the screen between end() and begin()
+/// @param value value of the setting
+/// @return RESULT_SUCCESS or RESULT_ERROR
+///
+typedef uint8_t (*screenSetting_t)(uint8_t value);
+
+///
+/// @brief Restart the screen with a setting
+/// @param setting function for the setting, as setFrameLayout()
+/// @param value value of the setting
+/// @return RESULT_SUCCESS or RESULT_ERROR
+/// @note The screen is always restarted, with the previous setting if the new one is not available.
+///
+uint8_t restartScreen(screenSetting_t setting, uint8_t value)
+{
+    myScreen.end();
+    uint8_t result = setting(value);
+    myScreen.begin();
+    return result;
+}
+
+#endif // BENCHMARK_STORAGE BENCHMARK_LAYOUT BENCHMARK_TILES
+
+// Functions
+#if (BENCHMARK_CLEAR == 1)
+
+///
+/// @brief Clear and area fill throughput, solid and dithered colours
+///
+void performClear()
+{
+    uint32_t chrono;
+    const uint16_t colours[] = {myColours.white, myColours.black, myColours.red, myColours.grey, myColours.darkRed, myColours.lightRed};
+    const char * names[] = {"white", "black", "red", "grey", "darkRed", "lightRed"};
+    uint16_t x = myScreen.screenSizeX();
+    uint16_t y = myScreen.screenSizeY();
+
+    mySerial.println(formatString("Panel %i.%02i\"", myScreen.screenDiagonal() / 100, myScreen.screenDiagonal() % 100));
+
+    for (uint8_t index = 0; index < 6; index += 1)
+    {
+        chrono = micros();
+        for (uint16_t i = 0; i < BENCHMARK_NUMBER / 10; i += 1)
+        {
+            myScreen.clear(colours[index]);
+        }
+        chrono = micros() - chrono;
+        report(formatString("Clear, %s", names[index]).c_str(), BENCHMARK_NUMBER / 10, chrono);
+    }
+
+    myScreen.setPenSolid(true);
+    for (uint8_t index = 0; index < 6; index += 1)
+    {
+        chrono = micros();
+        for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+        {
+            myScreen.rectangle(x / 8, y / 8, x * 7 / 8, y * 7 / 8, colours[index]);
+        }
+        chrono = micros() - chrono;
+        report(formatString("Rectangle, %s", names[index]).c_str(), BENCHMARK_NUMBER, chrono);
+    }
+    myScreen.setPenSolid(false);
+
+    myScreen.clear();
+}
+
+#endif // BENCHMARK_CLEAR
+
+#if (BENCHMARK_FORMS == 1)
+
+///
+/// @brief Triangles and polygons throughput
+///
+void performForms()
+{
+    uint32_t chrono;
+    uint16_t x = myScreen.screenSizeX();
+    uint16_t y = myScreen.screenSizeY();
+
+    randomSeed(1);
+    myScreen.setPenSolid(true);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.triangle(random(x), random(y), random(x), random(y), random(x), random(y), (i % 2) ? myColours.black : myColours.white);
+    }
+    chrono = micros() - chrono;
+    report("Triangles, solid", BENCHMARK_NUMBER, chrono);
+
+    // Five-point star, concave
+    point_s star[10];
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        uint16_t radius = random(8, hV_HAL_min(x, y) / 4);
+        uint16_t x0 = random(radius, x - radius);
+        uint16_t y0 = random(radius, y - radius);
+
+        for (uint8_t j = 0; j < 10; j += 1)
+        {
+            uint16_t r = (j % 2) ? radius / 2 : radius;
+            star[j].x = x0 + r * cos32x100(j * 3600) / 100;
+            star[j].y = y0 + r * sin32x100(j * 3600) / 100;
+        }
+        myScreen.polygon(star, 10, (i % 2) ? myColours.black : myColours.white);
+    }
+    chrono = micros() - chrono;
+    report("Polygons, 10 vertices", BENCHMARK_NUMBER, chrono);
+
+    myScreen.setPenSolid(false);
+}
+
+#endif // BENCHMARK_FORMS
+
+#if (BENCHMARK_TEXT == 1)
+
+///
+/// @brief Text throughput, normal and scaled
+///
+void performText()
+{
+    uint32_t chrono;
+    String text = "0123456789";
+
+    myScreen.selectFont(Font_Terminal12x16);
+    myScreen.setFontSolid(true);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.gText(0, 0, text);
+    }
+    chrono = micros() - chrono;
+    report("Text, 1x", BENCHMARK_NUMBER, chrono);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.gText(0, 0, "0123456789");
+    }
+    chrono = micros() - chrono;
+    report("Text, 1x, char array", BENCHMARK_NUMBER, chrono);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.gTextf(0, 0, myColours.black, myColours.white, "%010i", i);
+    }
+    chrono = micros() - chrono;
+    report("Text, 1x, gTextf()", BENCHMARK_NUMBER, chrono);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.gTextLarge(0, 0, text);
+    }
+    chrono = micros() - chrono;
+    report("Text, 2x", BENCHMARK_NUMBER, chrono);
+
+    for (uint8_t scale = 4; scale <= 8; scale += 4)
+    {
+        chrono = micros();
+        for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+        {
+            myScreen.gTextScaled(0, 0, text, scale, scale);
+        }
+        chrono = micros() - chrono;
+        report(formatString("Text, %ix", scale).c_str(), BENCHMARK_NUMBER, chrono);
+    }
+
+    myScreen.setFontSolid(false);
+}
+
+#endif // BENCHMARK_TEXT
+
+#if (BENCHMARK_UTF8 == 1)
+
+///
+/// @brief UTF-8 text throughput, converted and streamed
+///
+void performUTF8()
+{
+    uint32_t chrono;
+    const char * labels[] =
+    {
+        "Température 21,5 °C",
+        "Größe: 12 m²",
+        "Año 2025, señal ±3 dB",
+        "Prix : 9,90 € TTC",
+        "Œuvre « naïve » — ™",
+    };
+    const uint8_t number = sizeof(labels) / sizeof(labels[0]);
+
+    myScreen.selectFont(Font_Terminal8x12);
+    myScreen.setFontSolid(true);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.gText(0, 0, utf2iso(labels[i % number]));
+    }
+    chrono = micros() - chrono;
+    report("UTF-8, utf2iso()", BENCHMARK_NUMBER, chrono);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.gTextUTF8(0, 0, labels[i % number]);
+    }
+    chrono = micros() - chrono;
+    report("UTF-8, gTextUTF8()", BENCHMARK_NUMBER, chrono);
+
+    // Decoder only
+    volatile uint32_t count = 0;
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        const char * text = labels[i % number];
+        size_t length = strlen(text);
+        size_t index = 0;
+        while (index < length)
+        {
+            count += codePointToIso(utf8Next(text, length, index));
+        }
+    }
+    chrono = micros() - chrono;
+    report("UTF-8, decoder only", BENCHMARK_NUMBER, chrono);
+
+    myScreen.setFontSolid(false);
+}
+
+#endif // BENCHMARK_UTF8
+
+#if (BENCHMARK_BITMAP == 1)
+
+///
+/// @brief Bitmap, 64x64 pixels, black plane then red plane
+///
+uint8_t logo[2 * 64 * 64 / 8];
+
+///
+/// @brief Bitmaps against a loop of points, for each orientation
+///
+void performBitmap()
+{
+    uint32_t chrono;
+
+    // Checker-board with a red frame
+    for (uint16_t j = 0; j < 64; j += 1)
+    {
+        for (uint16_t k = 0; k < 8; k += 1)
+        {
+            logo[j * 8 + k] = ((j / 8) % 2) ? 0xf0 : 0x0f;
+            logo[64 * 8 + j * 8 + k] = ((j < 2) or (j > 61)) ? 0xff : 0x00;
+        }
+    }
+
+    for (uint8_t orientation = 0; orientation < 4; orientation += 1)
+    {
+        myScreen.setOrientation(orientation);
+
+        chrono = micros();
+        for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+        {
+            for (uint16_t j = 0; j < 64; j += 1)
+            {
+                for (uint16_t k = 0; k < 64; k += 1)
+                {
+                    myScreen.point(8 + k, 8 + j, bitRead(logo[j * 8 + k / 8], 7 - k % 8) ? myColours.black : myColours.white);
+                }
+            }
+        }
+        chrono = micros() - chrono;
+        report(formatString("Bitmap %i, point()", orientation).c_str(), BENCHMARK_NUMBER, chrono);
+
+        chrono = micros();
+        for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+        {
+            myScreen.drawBitmap(8, 8, 64, 64, logo);
+        }
+        chrono = micros() - chrono;
+        report(formatString("Bitmap %i, aligned", orientation).c_str(), BENCHMARK_NUMBER, chrono);
+
+        chrono = micros();
+        for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+        {
+            myScreen.drawBitmap(11, 8, 64, 64, logo);
+        }
+        chrono = micros() - chrono;
+        report(formatString("Bitmap %i, shifted", orientation).c_str(), BENCHMARK_NUMBER, chrono);
+
+        chrono = micros();
+        for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+        {
+            myScreen.drawBitmap(11, 8, 64, 64, logo, BITMAP_BWR | BITMAP_TRANSPARENT);
+        }
+        chrono = micros() - chrono;
+        report(formatString("Bitmap %i, BWR", orientation).c_str(), BENCHMARK_NUMBER, chrono);
+    }
+
+    myScreen.setOrientation(0);
+    myScreen.clear();
+}
+
+#endif // BENCHMARK_BITMAP
+
+#if (BENCHMARK_PARALLEL == 1) or (BENCHMARK_COMPRESSION == 1)
+
+///
+/// @brief Dashboard with forms and text
+///
+void drawDashboard()
+{
+    uint16_t x = myScreen.screenSizeX();
+    uint16_t y = myScreen.screenSizeY();
+
+    randomSeed(2);
+    myScreen.clear();
+    myScreen.setPenSolid(true);
+    for (uint16_t i = 0; i < 100; i += 1)
+    {
+        myScreen.triangle(random(x), random(y), random(x), random(y), random(x), random(y), (i % 2) ? myColours.black : myColours.grey);
+    }
+    myScreen.setPenSolid(false);
+
+    myScreen.selectFont(Font_Terminal12x16);
+    myScreen.setFontSolid(true);
+    for (uint16_t i = 0; i < y / 16; i += 1)
+    {
+        myScreen.gTextf(0, i * 16, myColours.black, myColours.white, "Line %02i", i);
+    }
+    myScreen.setFontSolid(false);
+}
+
+#endif // BENCHMARK_PARALLEL BENCHMARK_COMPRESSION
+
+#if (BENCHMARK_PARALLEL == 1)
+
+#if defined(ARDUINO_ARCH_RP2040)
+
+///
+/// @brief Setup for core 1, empty
+///
+void setup1()
+{
+    ;
+}
+
+///
+/// @brief Loop for core 1
+/// @details Replay the band of myBand when requested, FIFO as barrier
+///
+void loop1()
+{
+    rp2040.fifo.pop(); // Wait for start
+    myBand.replay(myScreen);
+    rp2040.fifo.push(0x01); // Done
+}
+
+#endif // ARDUINO_ARCH_RP2040
+
+///
+/// @brief Recorded commands replayed on one band and on two bands
+///
+void performParallel()
+{
+    uint32_t chrono;
+
+    myBand.beginShared(myScreen);
+
+    myScreen.beginRecord(recordBuffer, sizeof(recordBuffer));
+    drawDashboard();
+    if (myScreen.endRecord() == RESULT_ERROR)
+    {
+        mySerial.println("Record buffer too small");
+        return;
+    }
+
+    chrono = micros();
+    drawDashboard();
+    chrono = micros() - chrono;
+    report("Dashboard, direct", 1, chrono);
+
+    chrono = micros();
+    myScreen.replay(myScreen);
+    chrono = micros() - chrono;
+    report("Dashboard, 1 band", 1, chrono);
+
+    myScreen.setBand(0, 2);
+    myBand.setBand(1, 2);
+
+#if defined(ARDUINO_ARCH_RP2040)
+
+    chrono = micros();
+    rp2040.fifo.push(0x01); // Start core 1
+    myScreen.replay(myScreen);
+    rp2040.fifo.pop(); // Barrier before flush()
+    chrono = micros() - chrono;
+    report("Dashboard, 2 cores", 1, chrono);
+
+#else
+
+    // Single core, sequential bands
+    chrono = micros();
+    myScreen.replay(myScreen);
+    myBand.replay(myScreen);
+    chrono = micros() - chrono;
+    report("Dashboard, 2 bands", 1, chrono);
+
+#endif // ARDUINO_ARCH_RP2040
+
+    myScreen.setBand();
+}
+
+#endif // BENCHMARK_PARALLEL
+
+#if (BENCHMARK_COMPRESSION == 1)
+
+///
+/// @brief Compression ratio, decode and update times
+/// @param label name of the page
+///
+void performCompressionPage(const char * label)
+{
+    uint32_t chrono;
+    uint32_t frameSize = (uint32_t)myScreen.screenSizeX() * myScreen.screenSizeY() / 4; // Black and red planes
+    uint32_t capacity = frameEncodeBound(frameSize);
+    uint8_t * compressed = new uint8_t[capacity];
+
+    if (compressed == nullptr)
+    {
+        mySerial.println("Compression buffer not allocated");
+        return;
+    }
+
+    chrono = micros();
+    uint32_t size = myScreen.compressFrame(compressed, capacity);
+    chrono = micros() - chrono;
+    report(formatString("%s, encode", label).c_str(), 1, chrono);
+    mySerial.println(formatString("%-24s %6i -> %6i bytes = %4i.%02i:1", label, frameSize, size, frameSize / size, (frameSize * 100 / size) % 100));
+
+    // Decode only, same chunks as for the update
+    uint8_t chunk[STREAM_CHUNK_SIZE];
+    frameDecoder_s decoder;
+    frameDecodeBegin(decoder, compressed, size);
+    chrono = micros();
+    while (frameDecode(decoder, chunk, STREAM_CHUNK_SIZE) == STREAM_CHUNK_SIZE)
+    {
+        ;
+    }
+    chrono = micros() - chrono;
+    report(formatString("%s, decode", label).c_str(), 1, chrono);
+
+    chrono = micros();
+    myScreen.flush();
+    chrono = micros() - chrono;
+    report(formatString("%s, flush()", label).c_str(), 1, chrono);
+
+    chrono = micros();
+    myScreen.flushFromCompressed(compressed, size);
+    chrono = micros() - chrono;
+    report(formatString("%s, compressed", label).c_str(), 1, chrono);
+
+    delete[] compressed;
+}
+
+///
+/// @brief Compressed frames, white page and dashboard
+///
+void performCompression()
+{
+    myScreen.clear();
+    performCompressionPage("White");
+
+    drawDashboard();
+    performCompressionPage("Dashboard");
+
+    myScreen.clear();
+}
+
+#endif // BENCHMARK_COMPRESSION
+
+#if (BENCHMARK_STORAGE == 1)
+
+///
+/// @brief Select the frame-buffer storage, with the static buffer
+/// @param storage FRAMEBUFFER_INTERNAL, FRAMEBUFFER_STATIC or FRAMEBUFFER_PSRAM
+/// @return RESULT_SUCCESS or RESULT_ERROR
+///
+uint8_t setStorage(uint8_t storage)
+{
+    return myScreen.setFrameBuffer(storage, frameBuffer, sizeof(frameBuffer));
+}
+
+///
+/// @brief Fill rates for one frame-buffer storage
+/// @param label name of the storage
+/// @param storage FRAMEBUFFER_INTERNAL, FRAMEBUFFER_STATIC or FRAMEBUFFER_PSRAM
+///
+void performStoragePage(const char * label, uint8_t storage)
+{
+    uint32_t chrono;
+
+    if (restartScreen(setStorage, storage) == RESULT_ERROR)
+    {
+        return;
+    }
+
+    uint16_t x = myScreen.screenSizeX();
+    uint16_t y = myScreen.screenSizeY();
+    uint32_t bytes = (uint32_t)x * y / 4;
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER / 10; i += 1)
+    {
+        myScreen.clear();
+    }
+    chrono = micros() - chrono;
+    report(formatString("%s, clear", label).c_str(), BENCHMARK_NUMBER / 10, chrono);
+    mySerial.println(formatString("%-24s %6i kB/s", formatString("%s, clear rate", label).c_str(), (uint32_t)((uint64_t)bytes * (BENCHMARK_NUMBER / 10) * 1000000 / hV_HAL_max(chrono, 1) / 1024)));
+
+    myScreen.setPenSolid(true);
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.rectangle(x / 8, y / 8, x * 7 / 8, y * 7 / 8, myColours.black);
+    }
+    chrono = micros() - chrono;
+    report(formatString("%s, rectangle", label).c_str(), BENCHMARK_NUMBER, chrono);
+    myScreen.setPenSolid(false);
+
+    randomSeed(3);
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER * 50; i += 1)
+    {
+        myScreen.point(random(x), random(y), myColours.red);
+    }
+    chrono = micros() - chrono;
+    report(formatString("%s, points", label).c_str(), BENCHMARK_NUMBER * 50, chrono);
+}
+
+///
+/// @brief Fill rates per frame-buffer storage
+///
+void performStorage()
+{
+    performStoragePage("Internal", FRAMEBUFFER_INTERNAL);
+    performStoragePage("Static", FRAMEBUFFER_STATIC);
+
+#if defined(BOARD_HAS_PSRAM)
+
+    performStoragePage("PSRAM", FRAMEBUFFER_PSRAM);
+
+#endif // BOARD_HAS_PSRAM
+
+    // Back to the default storage
+#if defined(BOARD_HAS_PSRAM)
+
+    restartScreen(setStorage, FRAMEBUFFER_PSRAM);
+
+#else
+
+    restartScreen(setStorage, FRAMEBUFFER_INTERNAL);
+
+#endif // BOARD_HAS_PSRAM
+}
+
+#endif // BENCHMARK_STORAGE
+
+#if (BENCHMARK_LAYOUT == 1)
+
+///
+/// @brief Select the frame-buffer layout
+/// @param layout FRAMEBUFFER_LAYOUT_PLANAR or FRAMEBUFFER_LAYOUT_INTERLEAVED
+/// @return RESULT_SUCCESS or RESULT_ERROR
+///
+uint8_t setLayout(uint8_t layout)
+{
+    return myScreen.setFrameLayout(layout);
+}
+
+///
+/// @brief Fill rates and frame read for one frame-buffer layout
+/// @param label name of the layout
+/// @param layout FRAMEBUFFER_LAYOUT_PLANAR or FRAMEBUFFER_LAYOUT_INTERLEAVED
+/// @note The frame read, as for flush(), is measured with storeFrame() into RAM
+///
+void performLayoutPage(const char * label, uint8_t layout)
+{
+    uint32_t chrono;
+
+    if (restartScreen(setLayout, layout) == RESULT_ERROR)
+    {
+        return;
+    }
+
+    uint16_t x = myScreen.screenSizeX();
+    uint16_t y = myScreen.screenSizeY();
+
+    randomSeed(3);
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER * 50; i += 1)
+    {
+        myScreen.point(random(x), random(y), myColours.red);
+    }
+    chrono = micros() - chrono;
+    report(formatString("%s, points", label).c_str(), BENCHMARK_NUMBER * 50, chrono);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.circle(x / 2, y / 2, hV_HAL_min(x, y) / 2 - 2, myColours.black);
+    }
+    chrono = micros() - chrono;
+    report(formatString("%s, circles", label).c_str(), BENCHMARK_NUMBER, chrono);
+
+    myScreen.setPenSolid(true);
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.rectangle(x / 8, y / 8, x * 7 / 8, y * 7 / 8, myColours.black);
+    }
+    chrono = micros() - chrono;
+    report(formatString("%s, rectangle", label).c_str(), BENCHMARK_NUMBER, chrono);
+    myScreen.setPenSolid(false);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER / 10; i += 1)
+    {
+        myScreen.clear();
+    }
+    chrono = micros() - chrono;
+    report(formatString("%s, clear", label).c_str(), BENCHMARK_NUMBER / 10, chrono);
+
+    hV_Store_RAM myStore(1);
+    if (myStore.begin((uint32_t)x * y / 4) == RESULT_SUCCESS)
+    {
+        chrono = micros();
+        for (uint16_t i = 0; i < BENCHMARK_NUMBER / 10; i += 1)
+        {
+            myScreen.storeFrame(myStore, 0);
+        }
+        chrono = micros() - chrono;
+        report(formatString("%s, frame read", label).c_str(), BENCHMARK_NUMBER / 10, chrono);
+    }
+}
+
+///
+/// @brief Fill rates and frame read per frame-buffer layout
+/// @note Compare with the ESP32 PSRAM, where the interleaved layout avoids a second cache miss per pixel
+///
+void performLayout()
+{
+    performLayoutPage("Planar", FRAMEBUFFER_LAYOUT_PLANAR);
+    performLayoutPage("Interleaved", FRAMEBUFFER_LAYOUT_INTERLEAVED);
+
+    // Back to the default layout
+    restartScreen(setLayout, FRAMEBUFFER_LAYOUT_PLANAR);
+}
+
+#endif // BENCHMARK_LAYOUT
+
+#if (BENCHMARK_TILES == 1)
+
+///
+/// @brief Select the number of tiles
+/// @param tiles number of tiles, 0 = direct to the frame-buffer
+/// @return RESULT_SUCCESS or RESULT_ERROR
+///
+uint8_t setTiles(uint8_t tiles)
+{
+    return myScreen.setTileCache(tiles);
+}
+
+///
+/// @brief Per-pixel primitives with a number of tiles
+/// @param tiles number of tiles, 0 = direct to the frame-buffer
+///
+void performTilesPage(uint8_t tiles)
+{
+    uint32_t chrono;
+
+    if (restartScreen(setTiles, tiles) == RESULT_ERROR)
+    {
+        return;
+    }
+    myScreen.clear();
+
+    uint16_t x = myScreen.screenSizeX();
+    uint16_t y = myScreen.screenSizeY();
+
+    randomSeed(3);
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.line(random(x), random(y), random(x), random(y), myColours.black);
+    }
+    chrono = micros() - chrono;
+    report(formatString("Tiles %i, lines", tiles).c_str(), BENCHMARK_NUMBER, chrono);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.circle(x / 2, y / 2, hV_HAL_min(x, y) / 2 - 2 - (i % 16), myColours.red);
+    }
+    chrono = micros() - chrono;
+    report(formatString("Tiles %i, circles", tiles).c_str(), BENCHMARK_NUMBER, chrono);
+
+    myScreen.selectFont(0);
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        myScreen.gText(0, (i % 8) * myScreen.characterSizeY(), "ABCDEFGHIJ", myColours.black);
+    }
+    chrono = micros() - chrono;
+    report(formatString("Tiles %i, text", tiles).c_str(), BENCHMARK_NUMBER, chrono);
+
+    if (tiles > 0)
+    {
+        tileStatistics_s statistics = myScreen.getTileStatistics();
+        uint32_t total = hV_HAL_max(statistics.hits + statistics.misses, 1);
+        mySerial.println(formatString("%-24s %6i hits %6i misses %6i write-backs = %3i%% hit rate", formatString("Tiles %i, cache", tiles).c_str(), statistics.hits, statistics.misses, statistics.writeBacks, (uint32_t)((uint64_t)statistics.hits * 100 / total)));
+    }
+}
+
+///
+/// @brief Tile cache against the direct path
+/// @note Compare with the ESP32 PSRAM, where the tiles in internal RAM avoid the cache misses
+///
+void performTiles()
+{
+    performTilesPage(0);
+    performTilesPage(2);
+    performTilesPage(4);
+    performTilesPage(TILE_CACHE_MAX);
+
+    // Back to no tile cache
+    restartScreen(setTiles, 0);
+}
+
+#endif // BENCHMARK_TILES
+
+#if (BENCHMARK_GPIO == 1)
+
+///
+/// @brief GPIO and command rates, digitalWrite() against fast handles
+/// @note panelCS stays high, so the panel ignores the bytes sent
+/// @note A command toggles panelDC twice and sends two bytes, as b_sendCommandData8()
+///
+void performGPIO()
+{
+    uint32_t chrono;
+    uint8_t pinDC = myScreen.getBoardPins().panelDC;
+    hV_HAL_GPIO_s fastDC;
+    hV_HAL_GPIO_define(fastDC, pinDC);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER * 50; i += 1)
+    {
+        digitalWrite(pinDC, LOW);
+        digitalWrite(pinDC, HIGH);
+    }
+    chrono = micros() - chrono;
+    report("GPIO, digitalWrite()", BENCHMARK_NUMBER * 100, chrono);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER * 50; i += 1)
+    {
+        hV_HAL_GPIO_clear(fastDC);
+        hV_HAL_GPIO_set(fastDC);
+    }
+    chrono = micros() - chrono;
+    report("GPIO, fast handle", BENCHMARK_NUMBER * 100, chrono);
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER * 10; i += 1)
+    {
+        digitalWrite(pinDC, LOW);
+        hV_HAL_SPI_transfer(0x00);
+        digitalWrite(pinDC, HIGH);
+        hV_HAL_SPI_transfer(0x00);
+    }
+    chrono = micros() - chrono;
+    report("Command, digitalWrite()", BENCHMARK_NUMBER * 10, chrono);
+    mySerial.println(formatString("%-24s %6i commands/s", "Command, digitalWrite()", (uint32_t)((uint64_t)BENCHMARK_NUMBER * 10 * 1000000 / hV_HAL_max(chrono, 1))));
+
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER * 10; i += 1)
+    {
+        hV_HAL_GPIO_clear(fastDC);
+        hV_HAL_SPI_transfer(0x00);
+        hV_HAL_GPIO_set(fastDC);
+        hV_HAL_SPI_transfer(0x00);
+    }
+    chrono = micros() - chrono;
+    report("Command, fast handle", BENCHMARK_NUMBER * 10, chrono);
+    mySerial.println(formatString("%-24s %6i commands/s", "Command, fast handle", (uint32_t)((uint64_t)BENCHMARK_NUMBER * 10 * 1000000 / hV_HAL_max(chrono, 1))));
+}
+
+#endif // BENCHMARK_GPIO
+
+#if (BENCHMARK_SPI3 == 1)
+
+///
+/// @brief 3-wire SPI read of 128 bytes, as for the OTP, conservative against fast
+/// @note panelCS stays high, so the panel ignores the clock
+///
+void performSPI3()
+{
+    uint32_t chrono;
+    uint8_t buffer[128];
+
+    hV_HAL_SPI_end();
+    hV_HAL_SPI3_begin();
+
+    hV_HAL_SPI3_setMode(SPI3_MODE_CONSERVATIVE);
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        hV_HAL_SPI3_readBlock(buffer, sizeof(buffer));
+    }
+    chrono = micros() - chrono;
+    report("SPI3 128 bytes, conservative", BENCHMARK_NUMBER, chrono);
+
+    hV_HAL_SPI3_setMode(SPI3_MODE_FAST);
+    chrono = micros();
+    for (uint16_t i = 0; i < BENCHMARK_NUMBER; i += 1)
+    {
+        hV_HAL_SPI3_readBlock(buffer, sizeof(buffer));
+    }
+    chrono = micros() - chrono;
+    report("SPI3 128 bytes, fast", BENCHMARK_NUMBER, chrono);
+
+    // Back to the 4-wire SPI, at the clock of the panel
+    hV_HAL_SPI_begin(myScreen.getPanelClock());
+}
+
+#endif // BENCHMARK_SPI3
+
+#if (BENCHMARK_CLOCK == 1)
+
+uint32_t clockReference; ///< duration of the update at the clock of the profile, ms
+
+///
+/// @brief Check the SPI clock under test with an update
+/// @return true if the update lasts at least half of the reference update
+/// @note A panel receiving corrupted commands does not perform the update, and BUSY is released early
+///
+bool checkClock(uint32_t /* clock */)
+{
+    myScreen.flush();
+    return (myScreen.getFlushTime() * 2 >= clockReference);
+}
+
+///
+/// @brief Throughput of the frame sent to the panel for each SPI clock
+/// @note Each clock is checked with an update, compared to the update at the clock of the profile
+///
+void performClock()
+{
+    myScreen.clear();
+    for (uint16_t i = 0; i < myScreen.screenSizeX(); i += 8)
+    {
+        myScreen.line(i, 0, myScreen.screenSizeX() - i, myScreen.screenSizeY() - 1, (i % 16 == 0) ? myColours.black : myColours.red);
+    }
+
+    myScreen.flush();
+    clockReference = myScreen.getFlushTime();
+
+    uint32_t clock = myScreen.calibratePanelClock(checkClock);
+    mySerial.println(formatString("%-24s %8i Hz", "Clock, profile", myScreen.getPanelClock()));
+    mySerial.println(formatString("%-24s %8i Hz", "Clock, highest", clock));
+}
+
+#endif // BENCHMARK_CLOCK
+
+#if (BENCHMARK_TRACE == 1)
+
+///
+/// @brief Update with the trace recorder off, then on
+/// @note The buffer of 2048 events takes 16 kB, the newest events are kept
+///
+void performTrace()
+{
+    uint32_t chrono;
+
+    myScreen.clear();
+    myScreen.selectFont(Font_Terminal8x12);
+    myScreen.gText(10, 10, "Trace", myColours.black);
+
+    chrono = millis();
+    myScreen.flush();
+    chrono = millis() - chrono;
+    report("Flush, trace off", 1, chrono * 1000);
+
+    if (hV_HAL_trace_begin(2048))
+    {
+        chrono = millis();
+        myScreen.flush();
+        chrono = millis() - chrono;
+        report("Flush, trace on", 1, chrono * 1000);
+        mySerial.println(formatString("%-24s %6i events", "Trace", hV_HAL_trace_count()));
+
+        // myScreen.exportTrace(mySerial); // For extras/Trace_Replay
+        hV_HAL_trace_end();
+    }
+}
+
+#endif // BENCHMARK_TRACE
+
+#if (BENCHMARK_ESTIMATE == 1)
+
+///
+/// @brief Estimated and measured durations of updates
+/// @note The first estimate uses the default BUSY time, the next ones the learned BUSY time
+///
+void performEstimate()
+{
+    myScreen.clear();
+    myScreen.selectFont(Font_Terminal8x12);
+    myScreen.gText(10, 10, "Estimate", myColours.black);
+
+    for (uint8_t i = 0; i < 3; i += 1)
+    {
+        uint32_t estimate = myScreen.estimateFlushTime();
+        myScreen.flush();
+        mySerial.println(formatString("%-24s %6i ms estimated, %6i ms measured", "Flush", estimate, myScreen.getFlushTime()));
+    }
+}
+
+#endif // BENCHMARK_ESTIMATE
+
+#if (BENCHMARK_POWER == 1)
+
+///
+/// @brief Three updates with one power profile
+/// @param label profile
+/// @param mode power mode
+/// @param scope power scope
+///
+void performPowerProfile(const char * label, uint8_t mode, uint8_t scope)
+{
+    uint32_t chrono;
+
+    myScreen.setPowerProfile(mode, scope);
+    myScreen.resetPowerStatistics();
+
+    chrono = millis();
+    for (uint8_t i = 0; i < 3; i += 1)
+    {
+        myScreen.flush();
+    }
+    chrono = millis() - chrono;
+    report(label, 3, chrono * 1000);
+
+    powerStatistics_s statistics = myScreen.getPowerStatistics();
+    mySerial.println(formatString("%-24s %6i resumes %6i ms, %6i ms powered, %6i uJ", "Power", statistics.resumes, statistics.latencyTotal, statistics.warmTime, statistics.energy));
+}
+
+///
+/// @brief Updates with suspend after each update, then kept warm
+/// @note Without panelPower, only the bus is suspended
+///
+void performPower()
+{
+    myScreen.clear();
+    myScreen.selectFont(Font_Terminal8x12);
+    myScreen.gText(10, 10, "Power", myColours.black);
+
+    performPowerProfile("Flush, auto", POWER_MODE_AUTO, POWER_SCOPE_BUS_GPIO);
+    performPowerProfile("Flush, keep-warm", POWER_MODE_KEEP_WARM, POWER_SCOPE_BUS_GPIO);
+    myScreen.suspend(POWER_SCOPE_BUS_GPIO);
+    myScreen.setPowerProfile();
+}
+
+#endif // BENCHMARK_POWER
+
+#if (BENCHMARK_SOLID == 1)
+
+///
+/// @brief Solid colour update, with clear() and flush() then with flushSolid()
+/// @param label colour
+/// @param colour solid colour
+///
+void performSolidColour(const char * label, uint16_t colour)
+{
+    uint32_t chrono;
+    char text[24];
+
+    chrono = micros();
+    myScreen.clear(colour);
+    myScreen.flush();
+    chrono = micros() - chrono;
+    snprintf(text, sizeof(text), "Clear + flush, %s", label);
+    report(text, 1, chrono);
+
+    chrono = micros();
+    myScreen.flushSolid(colour);
+    chrono = micros() - chrono;
+    snprintf(text, sizeof(text), "Flush solid, %s", label);
+    report(text, 1, chrono);
+}
+
+///
+/// @brief Solid colour updates, frame-buffer neither filled nor read by flushSolid()
+///
+void performSolid()
+{
+    performSolidColour("black", myColours.black);
+    performSolidColour("white", myColours.white);
+}
+
+#endif // BENCHMARK_SOLID
+
+// Add setup code
+///
+/// @brief Setup
+///
+void setup()
+{
+    // mySerial = Serial by default, otherwise edit hV_HAL_Peripherals.h
+    mySerial.begin(115200);
+    delay(500);
+    mySerial.println();
+    mySerial.println("=== " __FILE__);
+    mySerial.println("=== " __DATE__ " " __TIME__);
+    mySerial.println();
+
+    mySerial.println("begin... ");
+    myScreen.begin();
+    mySerial.println(formatString("%s %ix%i", myScreen.WhoAmI().c_str(), myScreen.screenSizeX(), myScreen.screenSizeY()));
+
+    myScreen.clear();
+
+#if (BENCHMARK_CLEAR == 1)
+
+    mySerial.println("BENCHMARK_CLEAR");
+    performClear();
+
+#endif // BENCHMARK_CLEAR
+
+#if (BENCHMARK_FORMS == 1)
+
+    mySerial.println("BENCHMARK_FORMS");
+    performForms();
+
+#endif // BENCHMARK_FORMS
+
+#if (BENCHMARK_TEXT == 1)
+
+    mySerial.println("BENCHMARK_TEXT");
+    performText();
+
+#endif // BENCHMARK_TEXT
+
+#if (BENCHMARK_UTF8 == 1)
+
+    mySerial.println("BENCHMARK_UTF8");
+    performUTF8();
+
+#endif // BENCHMARK_UTF8
+
+#if (BENCHMARK_BITMAP == 1)
+
+    mySerial.println("BENCHMARK_BITMAP");
+    performBitmap();
+
+#endif // BENCHMARK_BITMAP
+
+#if (BENCHMARK_PARALLEL == 1)
+
+    mySerial.println("BENCHMARK_PARALLEL");
+    performParallel();
+
+#endif // BENCHMARK_PARALLEL
+
+#if (BENCHMARK_COMPRESSION == 1)
+
+    mySerial.println("BENCHMARK_COMPRESSION");
+    performCompression();
+
+#endif // BENCHMARK_COMPRESSION
+
+#if (BENCHMARK_STORAGE == 1)
+
+    mySerial.println("BENCHMARK_STORAGE");
+    performStorage();
+
+#endif // BENCHMARK_STORAGE
+
+#if (BENCHMARK_LAYOUT == 1)
+
+    mySerial.println("BENCHMARK_LAYOUT");
+    performLayout();
+
+#endif // BENCHMARK_LAYOUT
+
+#if (BENCHMARK_TILES == 1)
+
+    mySerial.println("BENCHMARK_TILES");
+    performTiles();
+
+#endif // BENCHMARK_TILES
+
+#if (BENCHMARK_GPIO == 1)
+
+    mySerial.println("BENCHMARK_GPIO");
+    performGPIO();
+
+#endif // BENCHMARK_GPIO
+
+#if (BENCHMARK_SPI3 == 1)
+
+    mySerial.println("BENCHMARK_SPI3");
+    performSPI3();
+
+#endif // BENCHMARK_SPI3
+
+#if (BENCHMARK_CLOCK == 1)
+
+    mySerial.println("BENCHMARK_CLOCK");
+    performClock();
+
+#endif // BENCHMARK_CLOCK
+
+#if (BENCHMARK_TRACE == 1)
+
+    mySerial.println("BENCHMARK_TRACE");
+    performTrace();
+
+#endif // BENCHMARK_TRACE
+
+#if (BENCHMARK_ESTIMATE == 1)
+
+    mySerial.println("BENCHMARK_ESTIMATE");
+    performEstimate();
+
+#endif // BENCHMARK_ESTIMATE
+
+#if (BENCHMARK_POWER == 1)
+
+    mySerial.println("BENCHMARK_POWER");
+    performPower();
+
+#endif // BENCHMARK_POWER
+
+#if (BENCHMARK_SOLID == 1)
+
+    mySerial.println("BENCHMARK_SOLID");
+    performSolid();
+
+#endif // BENCHMARK_SOLID
+
+    mySerial.println("=== ");
+    mySerial.println();
+}
+
+// Add loop code
+///
+/// @brief Loop, empty
+///
+void loop()
+{
+    delay(1000);
+}
@@ -0,0 +1,195 @@
+///
+/// @file Common_Cache.ino
+/// @brief Example of page cache for basic edition
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright All rights reserved
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// * Basic edition: for hobbyists and for basic usage
+/// @n Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+///
+/// * Evaluation edition: for professionals or organisations, no commercial usage
+/// @n All rights reserved
+///
+/// * Commercial edition: for professionals or organisations, commercial usage
+/// @n All rights reserved
+///
+/// @see ReadMe.md for references
+/// @n
+///
+
+// Screen
+#include "PDLS_EXT3_Basic_Global.h"
+
+// SDK
+// #include <Arduino.h>
+#include "hV_HAL_Peripherals.h"
+
+// Include application, user and local libraries
+// #include <SPI.h>
+
+// Configuration
+#include "hV_Configuration.h"
+
+// Set parameters
+#define DISPLAY_CACHE 1
+
+///
+/// @brief Number of pages in the cycle
+///
+#define CACHE_PAGES 4
+
+// Define structures and classes
+
+// Define variables and constants
+Screen_EPD_EXT3 myScreen(eScreen_EPD_266_CS_0C, boardRaspberryPiPico_RP2040);
+// Screen_EPD_EXT3 myScreen(eScreen_EPD_266_JS_0C, boardRaspberryPiPico_RP2040);
+
+// Three pages in RAM, less than the number of pages in the cycle
+hV_Store_RAM myStore(3);
+Cache_EPD_EXT3 myCache(myScreen, myStore);
+
+// Prototypes
+
+// Utilities
+///
+/// @brief Wait with countdown
+/// @param second duration, s
+///
+void wait(uint8_t second)
+{
+    for (uint8_t i = second; i > 0; i--)
+    {
+        mySerial.print(formatString(" > %i  \r", i));
+        delay(1000);
+    }
+    mySerial.print("         \r");
+}
+
+// Functions
+#if (DISPLAY_CACHE == 1)
+
+///
+/// @brief Render one page
+/// @param page number of the page
+///
+void drawPage(uint8_t page)
+{
+    uint16_t x = myScreen.screenSizeX();
+    uint16_t y = myScreen.screenSizeY();
+
+    myScreen.clear();
+    myScreen.selectFont(Font_Terminal12x16);
+    myScreen.gTextf(0, 0, myColours.black, myColours.white, "Page %i", page);
+
+    // One circle per page number, within the screen
+    uint16_t radius = x / (CACHE_PAGES + 2) / 2 - 2;
+    myScreen.setPenSolid(true);
+    for (uint8_t i = 0; i <= page; i += 1)
+    {
+        myScreen.circle(x * (i + 1) / (CACHE_PAGES + 2), y / 2, radius, (i % 2) ? myColours.red : myColours.black);
+    }
+    myScreen.setPenSolid(false);
+}
+
+///
+/// @brief Display one page, from the cache if possible
+/// @param page number of the page
+///
+void displayPage(uint8_t page)
+{
+    // Key from the content, here the page number
+    uint32_t key = hashFNV(&page, 1);
+    uint32_t chrono = millis();
+
+    if (myCache.flushCached(key) == RESULT_SUCCESS)
+    {
+        mySerial.println(formatString("Page %i, hit  %6i ms", page, millis() - chrono));
+    }
+    else
+    {
+        drawPage(page);
+        myScreen.flush();
+        myCache.save(key);
+        mySerial.println(formatString("Page %i, miss %6i ms", page, millis() - chrono));
+    }
+}
+
+///
+/// @brief Cycle through the pages, twice
+///
+void displayCache()
+{
+    if (myCache.begin() == RESULT_ERROR)
+    {
+        mySerial.println("Cache not available");
+        return;
+    }
+
+    const uint8_t sequence[] = {0, 1, 2, 0, 1, 2, 3, 0, 3, 1};
+    for (uint8_t index = 0; index < sizeof(sequence); index += 1)
+    {
+        displayPage(sequence[index]);
+        wait(2);
+    }
+
+    cacheStatistics_s statistics = myCache.getStatistics();
+    mySerial.println(formatString("Hits %i, misses %i, saves %i, evictions %i", statistics.hits, statistics.misses, statistics.saves, statistics.evictions));
+
+    myCache.end();
+    myStore.end();
+}
+
+#endif // DISPLAY_CACHE
+
+// Add setup code
+///
+/// @brief Setup
+///
+void setup()
+{
+    // mySerial = Serial by default, otherwise edit hV_HAL_Peripherals.h
+    mySerial.begin(115200);
+    delay(500);
+    mySerial.println();
+    mySerial.println("=== " __FILE__);
+    mySerial.println("=== " __DATE__ " " __TIME__);
+    mySerial.println();
+
+    // Start
+    mySerial.println("begin");
+    myScreen.begin();
+    mySerial.println(formatString("%s %ix%i", myScreen.WhoAmI().c_str(), myScreen.screenSizeX(), myScreen.screenSizeY()));
+
+    // Example
+#if (DISPLAY_CACHE == 1)
+
+    mySerial.println("DISPLAY_CACHE");
+    displayCache();
+    wait(8);
+
+#endif // DISPLAY_CACHE
+
+    mySerial.println("Regenerate");
+    myScreen.regenerate();
+
+    mySerial.println("=== ");
+    mySerial.println();
+}
+
+// Add loop code
+///
+/// @brief Loop, empty
+///
+void loop()
+{
+    delay(1000);
+}
@@ -0,0 +1,153 @@
+///
+/// @file Common_Console.ino
+/// @brief Example of scrolling console for basic edition
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright All rights reserved
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// * Basic edition: for hobbyists and for basic usage
+/// @n Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+///
+/// * Evaluation edition: for professionals or organisations, no commercial usage
+/// @n All rights reserved
+///
+/// * Commercial edition: for professionals or organisations, commercial usage
+/// @n All rights reserved
+///
+/// @see ReadMe.md for references
+/// @n
+///
+
+// Screen
+#include "PDLS_EXT3_Basic_Global.h"
+
+// SDK
+// #include <Arduino.h>
+#include "hV_HAL_Peripherals.h"
+
+// Include application, user and local libraries
+// #include <SPI.h>
+
+// Configuration
+#include "hV_Configuration.h"
+
+// Set parameters
+#define DISPLAY_CONSOLE 1
+
+// Define structures and classes
+
+// Define variables and constants
+Screen_EPD_EXT3 myScreen(eScreen_EPD_266_CS_0C, boardRaspberryPiPico_RP2040);
+// Screen_EPD_EXT3 myScreen(eScreen_EPD_266_JS_0C, boardRaspberryPiPico_RP2040);
+
+Console_EPD_EXT3 myConsole(myScreen);
+
+// Prototypes
+
+// Utilities
+///
+/// @brief Wait with countdown
+/// @param second duration, s
+///
+void wait(uint8_t second)
+{
+    for (uint8_t i = second; i > 0; i--)
+    {
+        mySerial.print(formatString(" > %i  \r", i));
+        delay(1000);
+    }
+    mySerial.print("         \r");
+}
+
+// Functions
+#if (DISPLAY_CONSOLE == 1)
+
+///
+/// @brief Console test screen
+/// @param flag true = default = perform flush, otherwise no
+///
+void displayConsole(bool flag = true)
+{
+    myScreen.setOrientation(ORIENTATION_LANDSCAPE);
+    uint16_t x = myScreen.screenSizeX();
+    uint16_t y = myScreen.screenSizeY();
+
+    myScreen.selectFont(Font_Terminal8x12);
+    myScreen.gText(0, 0, "Console", myColours.black);
+
+    // Console below the title, with the smallest font
+    myConsole.begin(0, myScreen.characterSizeY() + 2, x, y - myScreen.characterSizeY() - 2, Font_Terminal6x8);
+    mySerial.println(formatString("Console %ix%i", myConsole.columns(), myConsole.rows()));
+
+    // Older lines scroll up
+    for (uint8_t i = 0; i < myConsole.rows() + 4; i += 1)
+    {
+        myConsole.print("Line ");
+        myConsole.print(i);
+        myConsole.print(" millis=");
+        myConsole.println(millis());
+    }
+
+    myConsole.setColours(myColours.red, myColours.white);
+    myConsole.print("Done");
+
+    if (flag)
+    {
+        myConsole.flush();
+    }
+}
+
+#endif // DISPLAY_CONSOLE
+
+// Add setup code
+///
+/// @brief Setup
+///
+void setup()
+{
+    // mySerial = Serial by default, otherwise edit hV_HAL_Peripherals.h
+    mySerial.begin(115200);
+    delay(500);
+    mySerial.println();
+    mySerial.println("=== " __FILE__);
+    mySerial.println("=== " __DATE__ " " __TIME__);
+    mySerial.println();
+
+    // Start
+    mySerial.println("begin");
+    myScreen.begin();
+    mySerial.println(formatString("%s %ix%i", myScreen.WhoAmI().c_str(), myScreen.screenSizeX(), myScreen.screenSizeY()));
+
+    // Example
+#if (DISPLAY_CONSOLE == 1)
+
+    mySerial.println("DISPLAY_CONSOLE");
+    myScreen.clear();
+    displayConsole();
+    wait(8);
+
+#endif // DISPLAY_CONSOLE
+
+    mySerial.println("Regenerate");
+    myScreen.regenerate();
+
+    mySerial.println("=== ");
+    mySerial.println();
+}
+
+// Add loop code
+///
+/// @brief Loop, empty
+///
+void loop()
+{
+    delay(1000);
+}
@@ -0,0 +1,221 @@
+///
+/// @file Alloc_Count.cpp
+/// @brief Count the heap allocations of the text functions, computer tool
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details Allocations of the text functions, built with the minimal Arduino core of Host_Stubs.
+/// @n The tool replaces the global operator new and operator delete, and counts the calls.
+/// @n A frame is a page of lines drawn with one text path, followed by flush().
+/// For each path, the tool prints the calls and bytes per frame:
+/// * String, built for each line, as with String("Line ") + String(i),
+/// * String, built once and reused,
+/// * char array, formatted with formatBuffer(),
+/// * Flash string with F(),
+/// * gTextf().
+/// @n The lines are longer than 15 characters, so the short-string optimisation of std::string,
+/// used by String of Host_Stubs, does not hide the allocations.
+///
+/// @n Build
+/// @code
+/// c++ -std=gnu++17 -O2 -I../Host_Stubs -I../../src Alloc_Count.cpp ../Host_Stubs/Host_Stubs.cpp ../../src/*.cpp -o Alloc_Count
+/// @endcode
+///
+/// @n Usage
+/// @code
+/// ./Alloc_Count
+/// @endcode
+///
+/// @n Exit code: 0 if only the String built for each line allocates, 1 otherwise
+///
+/// Release 821: First release
+///
+
+// SDK
+#include <new>
+
+// Library
+#include "PDLS_EXT3_Basic_Global.h"
+
+///
+/// @brief Number of lines per frame
+///
+#define ALLOC_LINES 20
+
+///
+/// @brief Number of frames per path
+///
+#define ALLOC_FRAMES 4
+
+///
+/// @brief Calls and bytes counted by the operators
+///
+struct allocations_s
+{
+    uint32_t news; ///< calls to operator new and operator new[]
+    uint32_t deletes; ///< calls to operator delete and operator delete[], except nullptr
+    uint64_t bytes; ///< bytes requested
+};
+
+static allocations_s allocations = {0, 0, 0};
+
+void * operator new(size_t size)
+{
+    allocations.news += 1;
+    allocations.bytes += size;
+    void * pointer = malloc((size > 0) ? size : 1);
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void * operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void * pointer) noexcept
+{
+    if (pointer != nullptr)
+    {
+        allocations.deletes += 1;
+        free(pointer);
+    }
+}
+
+void operator delete[](void * pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void * pointer, size_t /* size */) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void * pointer, size_t /* size */) noexcept
+{
+    operator delete(pointer);
+}
+
+///
+/// @brief Text paths
+///
+enum path_e
+{
+    PATH_STRING_TEMPORARY,
+    PATH_STRING_REUSED,
+    PATH_CHAR_ARRAY,
+    PATH_FLASH,
+    PATH_TEXTF,
+    PATH_NUMBER
+};
+
+static const char * pathNames[PATH_NUMBER] =
+{
+    "String, for each line",
+    "String, reused",
+    "char array",
+    "F()",
+    "gTextf()",
+};
+
+///
+/// @brief Draw a page with one text path
+/// @param screen screen
+/// @param path text path
+/// @param frame frame number, for the values
+///
+static void drawPage(Screen_EPD_EXT3 & screen, uint8_t path, uint16_t frame)
+{
+    static const String reused = "Dashboard 0123456789";
+    char buffer[32];
+    uint16_t height = screen.characterSizeY();
+
+    screen.clear();
+    for (uint16_t line = 0; line < ALLOC_LINES; line += 1)
+    {
+        uint16_t y = line * height;
+        uint16_t value = frame * ALLOC_LINES + line;
+
+        switch (path)
+        {
+            case PATH_STRING_TEMPORARY:
+
+                screen.gText(0, y, String("Dashboard, line ") + String(value));
+                break;
+
+            case PATH_STRING_REUSED:
+
+                screen.gText(0, y, reused);
+                break;
+
+            case PATH_CHAR_ARRAY:
+
+                formatBuffer(buffer, sizeof(buffer), "Dashboard, line %i", value);
+                screen.gText(0, y, buffer);
+                break;
+
+            case PATH_FLASH:
+
+                screen.gText(0, y, F("Dashboard 0123456789"));
+                break;
+
+            case PATH_TEXTF:
+
+                screen.gTextf(0, y, myColours.black, myColours.white, "Dashboard, line %i", value);
+                break;
+
+            default:
+
+                break;
+        }
+    }
+    screen.flush();
+}
+
+///
+/// @brief Main
+/// @return 0 if only the String built for each line allocates, 1 otherwise
+///
+int main()
+{
+    Screen_EPD_EXT3 screen(eScreen_EPD_266_CS_0C, boardRaspberryPiPico_RP2040);
+    screen.begin();
+    screen.selectFont(Font_Terminal8x12);
+
+    uint32_t errors = 0;
+
+    printf("%-24s %8s %8s %8s\n", "Path, per frame", "new", "delete", "bytes");
+    for (uint8_t path = 0; path < PATH_NUMBER; path += 1)
+    {
+        // First frame not counted, for the static objects
+        drawPage(screen, path, 0);
+
+        allocations = {0, 0, 0};
+        for (uint16_t frame = 1; frame <= ALLOC_FRAMES; frame += 1)
+        {
+            drawPage(screen, path, frame);
+        }
+        allocations_s result = allocations;
+
+        printf("%-24s %8.1f %8.1f %8.1f\n", pathNames[path],
+               (double)result.news / ALLOC_FRAMES, (double)result.deletes / ALLOC_FRAMES, (double)result.bytes / ALLOC_FRAMES);
+
+        bool flagExpected = (path == PATH_STRING_TEMPORARY) ? (result.news > 0) : (result.news == 0);
+        errors += flagExpected ? 0 : 1;
+    }
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,227 @@
+///
+/// @file Band_Scaling.cpp
+/// @brief Replay recorded commands on two bands and two threads, computer tool
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details Scaling of the dual-core rendering of the Concurrency page, built with the minimal Arduino core of Host_Stubs.
+/// @n A dashboard is drawn directly, then recorded with beginRecord() and replayed with replay(),
+/// first on one thread, then on two threads with a second screen started with beginShared(), each clipped to one band with setBand().
+/// @n For each orientation, the tool checks the three images are identical with exportImage(),
+/// and prints the CPU time of each thread and the speed-up of the two bands against one replay.
+///
+/// @n Build
+/// @code
+/// c++ -std=gnu++17 -O2 -pthread -I../Host_Stubs -I../../src Band_Scaling.cpp ../Host_Stubs/Host_Stubs.cpp ../../src/*.cpp -o Band_Scaling
+/// @endcode
+/// Add -fsanitize=thread to check the two bands do not race.
+///
+/// @n Usage
+/// @code
+/// ./Band_Scaling
+/// @endcode
+///
+/// @n Exit code: 0 if all the images are identical, 1 otherwise
+///
+/// Release 821: First release
+///
+
+// SDK
+#include <thread>
+#include <vector>
+#include <time.h>
+
+// Library
+#include "PDLS_EXT3_Basic_Global.h"
+
+///
+/// @brief Print computing the FNV-1a hash of the bytes written
+///
+class HashPrint : public Print
+{
+  public:
+    uint32_t hash = 0x811c9dc5;
+
+    size_t write(uint8_t character)
+    {
+        hash = hashFNV(&character, 1, hash);
+        return 1;
+    }
+    size_t write(const uint8_t * buffer, size_t size)
+    {
+        hash = hashFNV(buffer, size, hash);
+        return size;
+    }
+};
+
+///
+/// @brief Hash of the image of the screen
+/// @param screen screen
+/// @return hash of the PPM image
+///
+static uint32_t hashScreen(Screen_EPD_EXT3 & screen)
+{
+    HashPrint output;
+    screen.exportImage(output, EXPORT_PPM);
+    return output.hash;
+}
+
+///
+/// @brief CPU time of the calling thread
+/// @return time, ms
+///
+static double threadTime()
+{
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return time.tv_sec * 1e3 + time.tv_nsec * 1e-6;
+}
+
+///
+/// @brief Draw the dashboard
+/// @param screen screen
+/// @param orientation orientation
+///
+static void dashboard(Screen_EPD_EXT3 & screen, uint8_t orientation)
+{
+    srand(3);
+    screen.setOrientation(orientation);
+    screen.clear(myColours.white);
+    uint16_t x = screen.screenSizeX();
+    uint16_t y = screen.screenSizeY();
+
+    screen.setPenSolid(true);
+    for (uint16_t i = 0; i < 300; i += 1)
+    {
+        uint16_t colour = (i % 3 == 0) ? myColours.red : (i % 2) ? myColours.black : myColours.grey;
+        screen.triangle(rand() % x, rand() % y, rand() % x, rand() % y, rand() % x, rand() % y, colour);
+    }
+
+    point_s star[10];
+    for (uint16_t i = 0; i < 100; i += 1)
+    {
+        for (uint16_t j = 0; j < 10; j += 1)
+        {
+            int32_t radius = (j % 2) ? 20 : 40;
+            star[j].x = 50 + i * 7 % (x - 100) + radius * cos32x100(j * 3600) / 100;
+            star[j].y = 50 + i * 13 % (y - 100) + radius * sin32x100(j * 3600) / 100;
+        }
+        screen.polygon(star, 10, myColours.darkRed);
+    }
+
+    screen.setPenSolid(false);
+    for (uint16_t i = 0; i < 200; i += 1)
+    {
+        screen.circle(rand() % x, rand() % y, rand() % 50, myColours.black);
+    }
+
+    screen.selectFont(Font_Terminal16x24);
+    screen.setFontSolid(true);
+    for (uint16_t i = 0; i < 40; i += 1)
+    {
+        screen.gTextScaled(0, i * 24, "Dashboard 0123456789", 2, 1);
+    }
+    screen.gTextUTF8(10, 10, "Temp\xc3\xa9rature \xe2\x82\xac");
+    screen.gTextf(10, 70, myColours.black, myColours.white, "%i", 42);
+
+    for (uint16_t i = 0; i < 50; i += 1)
+    {
+        screen.rectangle(rand() % x, rand() % y, rand() % x, rand() % y, myColours.black);
+    }
+}
+
+///
+/// @brief Restore the default settings
+/// @param screen screen
+///
+static void resetSettings(Screen_EPD_EXT3 & screen)
+{
+    screen.setOrientation(0);
+    screen.selectFont(Font_Terminal8x12);
+    screen.setFontSolid(false);
+    screen.setPenSolid(false);
+}
+
+///
+/// @brief Main
+/// @return 0 if all the images are identical, 1 otherwise
+///
+int main()
+{
+    Screen_EPD_EXT3 screen(eScreen_EPD_B98_JS_0B, boardRaspberryPiPico_RP2040);
+    Screen_EPD_EXT3 worker(eScreen_EPD_B98_JS_0B, boardRaspberryPiPico_RP2040);
+    screen.begin();
+    worker.beginShared(screen);
+
+    std::vector<uint8_t> buffer(65536);
+    uint32_t errors = 0;
+
+    for (uint8_t orientation = 0; orientation < 4; orientation += 1)
+    {
+        // Direct
+        resetSettings(screen);
+        double chrono = threadTime();
+        dashboard(screen, orientation);
+        double timeDirect = threadTime() - chrono;
+        uint32_t reference = hashScreen(screen);
+
+        // Record
+        resetSettings(screen);
+        screen.beginRecord(buffer.data(), buffer.size());
+        dashboard(screen, orientation);
+        if (screen.endRecord() == RESULT_ERROR)
+        {
+            printf("Record buffer too small\n");
+            return 1;
+        }
+
+        // Replay on one thread
+        screen.clear(myColours.red);
+        chrono = threadTime();
+        screen.replay(screen);
+        double timeReplay = threadTime() - chrono;
+        bool flagReplay = (hashScreen(screen) == reference);
+
+        // Replay on two threads, one band each
+        resetSettings(screen);
+        screen.clear(myColours.red);
+        screen.setBand(0, 2);
+        worker.setBand(1, 2);
+        double timeBand0 = 0;
+        double timeBand1 = 0;
+        std::thread thread0([&]()
+        {
+            double start = threadTime();
+            screen.replay(screen);
+            timeBand0 = threadTime() - start;
+        });
+        std::thread thread1([&]()
+        {
+            double start = threadTime();
+            worker.replay(screen);
+            timeBand1 = threadTime() - start;
+        });
+        thread0.join();
+        thread1.join();
+        screen.setBand();
+        bool flagBands = (hashScreen(screen) == reference);
+
+        double timeBands = (timeBand0 > timeBand1) ? timeBand0 : timeBand1;
+        printf("Orientation %i: direct %.1f ms, replay %.1f ms, bands %.1f and %.1f ms, x%.2f, %s\n",
+               orientation, timeDirect, timeReplay, timeBand0, timeBand1, timeReplay / timeBands,
+               (flagReplay and flagBands) ? "identical" : "different");
+
+        errors += (flagReplay ? 0 : 1) + (flagBands ? 0 : 1);
+    }
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+///
+/// @file Flush_Estimate.cpp
+/// @brief Check estimateFlushTime() against a simulated panel, computer tool
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details Estimate of the duration of an update, built with the minimal Arduino core of Host_Stubs.
+/// @n The simulated panel advances the clock of Host_Stubs for each byte sent,
+/// at the clock of the SPI transaction plus a fixed time per byte for the CPU.
+/// After the refresh command, BUSY stays low for a time depending on the film and the temperature,
+/// with a random variation of 2%.
+/// @n For monochrome and colour screens, the tool compares estimateFlushTime() with the duration of flush():
+/// * before any update, with the default BUSY time,
+/// * after some updates, at 25 °C, at 5 °C and with a slower SPI clock,
+/// * after updates from other sources, as flushFromReader(),
+/// and checks no update is estimated at 60 °C and resetFlushTime() restores the default.
+///
+/// @n Build
+/// @code
+/// c++ -std=gnu++17 -O2 -I../Host_Stubs -I../../src Flush_Estimate.cpp ../Host_Stubs/Host_Stubs.cpp ../../src/*.cpp -o Flush_Estimate
+/// @endcode
+///
+/// @n Usage
+/// @code
+/// ./Flush_Estimate
+/// @endcode
+///
+/// @n Exit code: 0 if the learned estimates are within ESTIMATE_TOLERANCE, 1 otherwise
+///
+/// Release 821: First release
+///
+
+// SDK
+#include <math.h>
+
+// Library
+#include "PDLS_EXT3_Basic_Global.h"
+
+///
+/// @brief Tolerance for the learned estimates, %
+///
+#define ESTIMATE_TOLERANCE 5.0
+
+///
+/// @brief CPU time per byte sent, ns
+///
+#define SIMULATION_BYTE_NS 400
+
+///
+/// @brief Screens to check
+///
+struct screen_s
+{
+    eScreen_EPD_t screen; ///< screen
+    uint8_t refresh; ///< refresh command
+    uint32_t busy; ///< BUSY time at 25 °C, ms
+};
+
+static const screen_s screens[] =
+{
+    {eScreen_EPD_266_CS_0C, 0x12, 3000},
+    {eScreen_EPD_417_JS_0D, 0x12, 15000},
+    {eScreen_EPD_581_CS_0B, 0x15, 3900},
+    {eScreen_EPD_741_JS_0B, 0x15, 19500},
+    {eScreen_EPD_969_JS_0B, 0x15, 19500},
+    {eScreen_EPD_B98_CS_0B, 0x15, 3900},
+};
+
+///
+/// @brief Simulated panel
+///
+struct simulation_s
+{
+    pins_t pins; ///< pins of the board
+    uint8_t refresh; ///< refresh command
+    uint32_t busy; ///< BUSY time at 25 °C, ms
+    int8_t temperature; ///< temperature, °C
+    uint32_t busyUntil; ///< end of BUSY low, ms
+    uint64_t nanos; ///< time not yet added to the clock, ns
+};
+
+static simulation_s simulation;
+
+///
+/// @brief Send a byte to the simulated panel
+/// @param value byte sent
+/// @return 0x00
+///
+static uint8_t simulateByte(uint8_t value)
+{
+    simulation.nanos += 8000000000ULL / hostClockSPI + SIMULATION_BYTE_NS;
+    delayMicroseconds(simulation.nanos / 1000);
+    simulation.nanos %= 1000;
+
+    if ((hostPinValue(simulation.pins.panelDC) == LOW) and (value == simulation.refresh))
+    {
+        double busy = simulation.busy * (1.0 + (25 - simulation.temperature) * 0.03) * (0.98 + 0.04 * (rand() % 1000) / 1000.0);
+        simulation.busyUntil = millis() + (uint32_t)busy;
+    }
+    return 0x00;
+}
+
+///
+/// @brief Read BUSY from the simulated panel
+/// @param pin pin
+/// @return LOW while busy, HIGH otherwise
+///
+static int simulateRead(uint8_t pin)
+{
+    if (pin == simulation.pins.panelBusy)
+    {
+        return (millis() < simulation.busyUntil) ? LOW : HIGH;
+    }
+    return HIGH;
+}
+
+///
+/// @brief Compare the estimate with the duration of flush()
+/// @param screen screen
+/// @param label name of the step
+/// @return error, %
+///
+static double compare(Screen_EPD_EXT3 & screen, const char * label)
+{
+    uint32_t estimate = screen.estimateFlushTime();
+    uint32_t chrono = millis();
+    screen.flush();
+    chrono = millis() - chrono;
+
+    double error = 100.0 * ((double)estimate - chrono) / hV_HAL_max(chrono, (uint32_t)1);
+    printf("    %-16s %3i C estimate %6i ms, flush() %6i ms, %+6.1f%%\n", label, simulation.temperature, estimate, chrono, error);
+    return error;
+}
+
+///
+/// @brief Set the temperature of the screen and the simulated panel
+/// @param screen screen
+/// @param temperature temperature, °C
+///
+static void setTemperature(Screen_EPD_EXT3 & screen, int8_t temperature)
+{
+    simulation.temperature = temperature;
+    screen.setTemperatureC(temperature);
+}
+
+///
+/// @brief Reader for flushFromReader()
+///
+static uint32_t readPattern(uint8_t * buffer, uint32_t /* offset */, uint32_t size)
+{
+    memset(buffer, 0x55, size);
+    return size;
+}
+
+///
+/// @brief Main
+/// @return 0 if the learned estimates are within ESTIMATE_TOLERANCE, 1 otherwise
+///
+int main()
+{
+    uint32_t errors = 0;
+    double worst = 0;
+
+    srand(47);
+    for (const screen_s & item : screens)
+    {
+        Screen_EPD_EXT3 screen(item.screen, boardRaspberryPiPico_RP2040);
+        screen.begin();
+        printf("%s\n", screen.WhoAmI().c_str());
+
+        simulation.pins = screen.getBoardPins();
+        simulation.refresh = item.refresh;
+        simulation.busy = item.busy;
+        simulation.busyUntil = 0;
+        simulation.nanos = 0;
+        hostTransferHook = simulateByte;
+        hostReadHook = simulateRead;
+
+        screen.clear();
+        screen.setPenSolid(true);
+        screen.circle(screen.screenSizeX() / 2, screen.screenSizeY() / 2, 40, myColours.black);
+        screen.setPenSolid(false);
+
+        // Default, then learned, at 25 °C
+        setTemperature(screen, 25);
+        compare(screen, "default");
+        for (uint8_t i = 0; i < 3; i += 1)
+        {
+            double error = compare(screen, "learned");
+            if (i > 0)
+            {
+                worst = hV_HAL_max(worst, fabs(error));
+            }
+        }
+
+        // Nearest band, then learned, at 5 °C
+        setTemperature(screen, 5);
+        compare(screen, "nearest band");
+        for (uint8_t i = 0; i < 2; i += 1)
+        {
+            double error = compare(screen, "learned");
+            worst = hV_HAL_max(worst, fabs(error));
+        }
+
+        // Slower SPI clock
+        screen.setPanelClock(4000000);
+        double error = compare(screen, "4 MHz");
+        worst = hV_HAL_max(worst, fabs(error));
+        screen.setPanelClock();
+
+        // Other sources, transfer time unchanged
+        screen.flushSolid(myColours.white);
+        screen.flushFromReader(readPattern);
+        error = compare(screen, "other sources");
+        worst = hV_HAL_max(worst, fabs(error));
+
+        // No update
+        setTemperature(screen, 60);
+        if (screen.estimateFlushTime() != 0)
+        {
+            printf("    Update estimated at 60 C\n");
+            errors += 1;
+        }
+
+        // Default restored
+        setTemperature(screen, 25);
+        uint32_t learned = screen.estimateFlushTime();
+        screen.resetFlushTime();
+        uint32_t restored = screen.estimateFlushTime();
+        if ((screen.getFlushTime() != 0) or (restored == learned))
+        {
+            printf("    Default not restored\n");
+            errors += 1;
+        }
+
+        hostTransferHook = nullptr;
+        hostReadHook = nullptr;
+        screen.end();
+    }
+
+    printf("Worst learned error %.1f%%, tolerance %.1f%%\n", worst, ESTIMATE_TOLERANCE);
+    errors += (worst <= ESTIMATE_TOLERANCE) ? 0 : 1;
+
+    return (errors == 0) ? 0 : 1;
+}
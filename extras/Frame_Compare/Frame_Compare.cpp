@@ -0,0 +1,238 @@
+///
+/// @file Frame_Compare.cpp
+/// @brief Compare images exported by exportImage(), computer tool
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details The inputs are binary PBM or PPM images, as written by exportImage(),
+/// for example a golden image and a snapshot.
+/// @n The tool reports the number of different pixels and the rectangle containing them.
+/// The optional difference image shows the golden image in grey and the different pixels in red.
+///
+/// @n Build
+/// @code
+/// c++ -O2 Frame_Compare.cpp -o Frame_Compare
+/// @endcode
+///
+/// @n Usage
+/// @code
+/// ./Frame_Compare golden.ppm snapshot.ppm [difference.ppm]
+/// @endcode
+///
+/// @n Exit code: 0 if same, 1 if different, 2 if error
+///
+/// Release 821: First release
+///
+
+// SDK
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+///
+/// @brief Image with 3 bytes per pixel
+///
+struct image_s
+{
+    uint32_t sizeX; ///< width, pixels
+    uint32_t sizeY; ///< height, pixels
+    uint8_t * pixels; ///< red, green, blue
+};
+
+///
+/// @brief Read a number of the header
+/// @param file file to read from
+/// @return number, -1 if error
+///
+static long readNumber(FILE * file)
+{
+    int character = fgetc(file);
+
+    // Spaces and comments
+    while ((character == ' ') or (character == '\t') or (character == '\n') or (character == '\r') or (character == '#'))
+    {
+        if (character == '#')
+        {
+            while ((character != '\n') and (character != EOF))
+            {
+                character = fgetc(file);
+            }
+        }
+        character = fgetc(file);
+    }
+
+    if ((character < '0') or (character > '9'))
+    {
+        return -1;
+    }
+
+    long value = 0;
+    while ((character >= '0') and (character <= '9'))
+    {
+        value = value * 10 + character - '0';
+        character = fgetc(file);
+    }
+    // One white space after the number, consumed
+    return value;
+}
+
+///
+/// @brief Read a binary PBM or PPM image
+/// @param name file name
+/// @param image image to fill
+/// @return true if success
+///
+static bool readImage(const char * name, image_s & image)
+{
+    FILE * file = fopen(name, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Cannot open %s\n", name);
+        return false;
+    }
+
+    bool result = false;
+    int kind = 0;
+    if (fgetc(file) == 'P')
+    {
+        kind = fgetc(file);
+    }
+
+    long sizeX = readNumber(file);
+    long sizeY = readNumber(file);
+    long maximum = (kind == '6') ? readNumber(file) : 1;
+
+    if (((kind == '4') or (kind == '6')) and (sizeX > 0) and (sizeY > 0) and (maximum == 255 or kind == '4'))
+    {
+        image.sizeX = sizeX;
+        image.sizeY = sizeY;
+        image.pixels = (uint8_t *)malloc((size_t)sizeX * sizeY * 3);
+        result = (image.pixels != NULL);
+
+        uint32_t rowSize = (sizeX + 7) / 8;
+        uint8_t * row = (uint8_t *)malloc(rowSize);
+        for (long y = 0; result and (y < sizeY); y += 1)
+        {
+            uint8_t * pixel = image.pixels + (size_t)y * sizeX * 3;
+            if (kind == '6')
+            {
+                result = (fread(pixel, 3, sizeX, file) == (size_t)sizeX);
+            }
+            else
+            {
+                result = (row != NULL) and (fread(row, 1, rowSize, file) == rowSize);
+                for (long x = 0; result and (x < sizeX); x += 1)
+                {
+                    // PBM, 1 = black
+                    uint8_t value = ((row[x / 8] >> (7 - x % 8)) & 0x01) ? 0x00 : 0xff;
+                    pixel[x * 3] = value;
+                    pixel[x * 3 + 1] = value;
+                    pixel[x * 3 + 2] = value;
+                }
+            }
+        }
+        free(row);
+    }
+
+    if (result == false)
+    {
+        fprintf(stderr, "Invalid image %s\n", name);
+    }
+    fclose(file);
+    return result;
+}
+
+///
+/// @brief Main
+/// @param argc number of arguments
+/// @param argv arguments: golden image, image to check, optional difference image
+/// @return 0 if same, 1 if different, 2 if error
+///
+int main(int argc, char ** argv)
+{
+    if ((argc != 3) and (argc != 4))
+    {
+        fprintf(stderr, "Usage: %s golden.ppm snapshot.ppm [difference.ppm]\n", argv[0]);
+        return 2;
+    }
+
+    image_s golden;
+    image_s snapshot;
+    if ((readImage(argv[1], golden) == false) or (readImage(argv[2], snapshot) == false))
+    {
+        return 2;
+    }
+
+    if ((golden.sizeX != snapshot.sizeX) or (golden.sizeY != snapshot.sizeY))
+    {
+        printf("Different sizes: %ux%u and %ux%u\n", golden.sizeX, golden.sizeY, snapshot.sizeX, snapshot.sizeY);
+        return 1;
+    }
+
+    uint32_t count = 0;
+    uint32_t x1 = golden.sizeX, y1 = golden.sizeY, x2 = 0, y2 = 0;
+    for (uint32_t y = 0; y < golden.sizeY; y += 1)
+    {
+        for (uint32_t x = 0; x < golden.sizeX; x += 1)
+        {
+            uint8_t * pixelGolden = golden.pixels + ((size_t)y * golden.sizeX + x) * 3;
+            uint8_t * pixelSnapshot = snapshot.pixels + ((size_t)y * golden.sizeX + x) * 3;
+            bool flagSame = (pixelGolden[0] == pixelSnapshot[0]) and (pixelGolden[1] == pixelSnapshot[1]) and (pixelGolden[2] == pixelSnapshot[2]);
+
+            if (flagSame)
+            {
+                // Golden image in grey, reused as difference image
+                uint8_t value = 0x80 + (((uint16_t)pixelGolden[0] + pixelGolden[1] + pixelGolden[2]) / 3) / 2;
+                pixelGolden[0] = value;
+                pixelGolden[1] = value;
+                pixelGolden[2] = value;
+            }
+            else
+            {
+                count += 1;
+                x1 = (x < x1) ? x : x1;
+                y1 = (y < y1) ? y : y1;
+                x2 = (x > x2) ? x : x2;
+                y2 = (y > y2) ? y : y2;
+                pixelGolden[0] = 0xff;
+                pixelGolden[1] = 0x00;
+                pixelGolden[2] = 0x00;
+            }
+        }
+    }
+
+    if (count == 0)
+    {
+        printf("Same images, %ux%u\n", golden.sizeX, golden.sizeY);
+    }
+    else
+    {
+        printf("%u different pixels, from %u.%u to %u.%u\n", count, x1, y1, x2, y2);
+    }
+
+    if (argc == 4)
+    {
+        FILE * file = fopen(argv[3], "wb");
+        if (file == NULL)
+        {
+            fprintf(stderr, "Cannot write %s\n", argv[3]);
+            return 2;
+        }
+        fprintf(file, "P6\n%u %u\n255\n", golden.sizeX, golden.sizeY);
+        fwrite(golden.pixels, 3, (size_t)golden.sizeX * golden.sizeY, file);
+        fclose(file);
+    }
+
+    free(golden.pixels);
+    free(snapshot.pixels);
+    return (count == 0) ? 0 : 1;
+}
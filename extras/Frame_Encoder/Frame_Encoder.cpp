@@ -0,0 +1,105 @@
+///
+/// @file Frame_Encoder.cpp
+/// @brief Compress frames for flushFromCompressed(), computer tool
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details The input is a raw image with the layout of the frame-buffer,
+/// black plane then red plane, screenSizeX() * screenSizeY() / 8 bytes each,
+/// as read by flushFromReader().
+/// @n The output is a header file with a constant array, for flushFromCompressed().
+///
+/// @n Build with the library codec
+/// @code
+/// c++ -O2 -I../../src Frame_Encoder.cpp ../../src/hV_Frame_Codec.cpp -o Frame_Encoder
+/// @endcode
+///
+/// @n Usage
+/// @code
+/// ./Frame_Encoder page.bin pageCompressed > pageCompressed.h
+/// @endcode
+///
+/// Release 821: First release
+///
+
+// SDK
+#include <stdio.h>
+#include <stdlib.h>
+
+// Codec
+#include "hV_Frame_Codec.h"
+
+///
+/// @brief Main
+/// @param argc number of arguments
+/// @param argv arguments: input file, array name
+/// @return 0 if success, 1 otherwise
+///
+int main(int argc, char ** argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: %s image.bin arrayName > arrayName.h\n", argv[0]);
+        return 1;
+    }
+
+    FILE * input = fopen(argv[1], "rb");
+    if (input == NULL)
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    fseek(input, 0, SEEK_END);
+    long size = ftell(input);
+    fseek(input, 0, SEEK_SET);
+    if (size <= 0)
+    {
+        fprintf(stderr, "Empty file %s\n", argv[1]);
+        fclose(input);
+        return 1;
+    }
+
+    uint8_t * source = (uint8_t *)malloc(size);
+    uint32_t capacity = frameEncodeBound(size);
+    uint8_t * destination = (uint8_t *)malloc(capacity);
+    if ((source == NULL) or (destination == NULL) or (fread(source, 1, size, input) != (size_t)size))
+    {
+        fprintf(stderr, "Cannot read %s\n", argv[1]);
+        fclose(input);
+        return 1;
+    }
+    fclose(input);
+
+    uint32_t length = frameEncode(source, size, destination, capacity);
+
+    printf("//\n");
+    printf("// %s, compressed from %s\n", argv[2], argv[1]);
+    printf("// %li bytes compressed into %u bytes\n", size, length);
+    printf("//\n\n");
+    printf("const uint8_t %s[%u] =\n{", argv[2], length);
+    for (uint32_t index = 0; index < length; index += 1)
+    {
+        printf("%s0x%02x", (index % 16 == 0) ? "\n    " : " ", destination[index]);
+        if (index + 1 < length)
+        {
+            printf(",");
+        }
+    }
+    printf("\n};\n");
+
+    fprintf(stderr, "%s: %li bytes compressed into %u bytes, ratio %li.%02li:1\n", argv[2], size, length, size / length, (size * 100 / length) % 100);
+
+    free(source);
+    free(destination);
+    return 0;
+}
@@ -0,0 +1,352 @@
+///
+/// @file Arduino.h
+/// @brief Minimal Arduino core to build the library on the computer
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details Only for the host programs under the extras folder, not for a board.
+/// @n The GPIOs are kept in memory, the pins in input mode read HIGH, so the panel is never busy.
+/// @n delay() and delayMicroseconds() do not wait, they advance the clock returned by millis() and micros().
+/// @n Serial writes to the standard output.
+/// @n The hooks let a tool simulate a device on the GPIOs, for example the BUSY signal or the 3-wire SPI.
+///
+/// Release 821: First release
+/// Release 821: Added hooks for the GPIOs
+///
+
+#ifndef HOST_ARDUINO_RELEASE
+///
+/// @brief Release
+///
+#define HOST_ARDUINO_RELEASE 821
+
+// SDK
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string>
+#include <algorithm>
+
+///
+/// @name GPIO constants
+/// @{
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define NOT_A_PIN 0xff
+/// @}
+
+///
+/// @name SPI constants
+/// @{
+#define MSBFIRST 1
+#define LSBFIRST 0
+#define SPI_MODE0 0
+#define SCK 18
+#define MOSI 19
+/// @}
+
+///
+/// @name Flash and bit macros
+/// @{
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define vsnprintf_P vsnprintf
+#define strlen_P strlen
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+/// @}
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+using std::min;
+using std::max;
+
+///
+/// @name GPIO and time
+/// @{
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+uint32_t micros();
+uint32_t millis();
+/// @}
+
+///
+/// @name Hooks for the simulations, nullptr by default
+/// @{
+
+///
+/// @brief Hook called by digitalWrite(), after the pin is written
+/// @param pin pin
+/// @param value HIGH or LOW
+///
+typedef void (*hostWriteHook_t)(uint8_t pin, uint8_t value);
+
+///
+/// @brief Hook called by digitalRead() for the pins not in output mode, instead of HIGH
+/// @param pin pin
+/// @return HIGH or LOW
+///
+typedef int (*hostReadHook_t)(uint8_t pin);
+
+extern hostWriteHook_t hostWriteHook;
+extern hostReadHook_t hostReadHook;
+
+///
+/// @brief Get the mode of a pin
+/// @param pin pin
+/// @return INPUT, OUTPUT or INPUT_PULLUP
+///
+uint8_t hostPinMode(uint8_t pin);
+
+///
+/// @brief Get the last value written to a pin
+/// @param pin pin
+/// @return HIGH or LOW
+///
+uint8_t hostPinValue(uint8_t pin);
+/// @}
+
+///
+/// @name Maths
+/// @{
+inline long map(long value, long fromLow, long fromHigh, long toLow, long toHigh)
+{
+    return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+inline long random(long high)
+{
+    return rand() % high;
+}
+inline long random(long low, long high)
+{
+    return low + rand() % (high - low);
+}
+inline void randomSeed(unsigned seed)
+{
+    srand(seed);
+}
+/// @}
+
+///
+/// @brief String, on std::string
+///
+class String
+{
+  public:
+    String(const char * text = "") : s(text ? text : "") {}
+    String(const std::string & text) : s(text) {}
+    String(char character) : s(1, character) {}
+    String(int value) : s(std::to_string(value)) {}
+    String(unsigned value) : s(std::to_string(value)) {}
+    String(long value) : s(std::to_string(value)) {}
+    String(unsigned long value) : s(std::to_string(value)) {}
+
+    unsigned length() const
+    {
+        return s.size();
+    }
+    unsigned char reserve(unsigned size)
+    {
+        s.reserve(size);
+        return 1;
+    }
+    char charAt(unsigned index) const
+    {
+        return (index < s.size()) ? s[index] : 0;
+    }
+    char operator[](unsigned index) const
+    {
+        return charAt(index);
+    }
+    const char * c_str() const
+    {
+        return s.c_str();
+    }
+    void toCharArray(char * buffer, unsigned size) const
+    {
+        strncpy(buffer, s.c_str(), size);
+        if (size > 0)
+        {
+            buffer[size - 1] = 0;
+        }
+    }
+    String substring(unsigned first, unsigned last) const
+    {
+        return String(s.substr(first, last - first));
+    }
+    String substring(unsigned first) const
+    {
+        return String(s.substr(first));
+    }
+    String operator+(const String & other) const
+    {
+        return String(s + other.s);
+    }
+    String & operator+=(const String & other)
+    {
+        s += other.s;
+        return *this;
+    }
+    bool operator==(const String & other) const
+    {
+        return s == other.s;
+    }
+
+    std::string s;
+};
+
+inline String operator+(const char * text, const String & other)
+{
+    return String(std::string(text) + other.s);
+}
+
+///
+/// @brief Print
+///
+class Print
+{
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t character) = 0;
+    virtual size_t write(const uint8_t * buffer, size_t size)
+    {
+        size_t result = 0;
+        while (size-- > 0)
+        {
+            result += write(*buffer++);
+        }
+        return result;
+    }
+    size_t write(const char * text)
+    {
+        return write((const uint8_t *)text, strlen(text));
+    }
+    size_t print(const String & text)
+    {
+        return write((const uint8_t *)text.c_str(), text.length());
+    }
+    size_t print(const char * text)
+    {
+        return write(text);
+    }
+    size_t print(char character)
+    {
+        return write((uint8_t)character);
+    }
+    size_t print(int value)
+    {
+        return print(String(value));
+    }
+    size_t print(unsigned value)
+    {
+        return print(String(value));
+    }
+    size_t print(long value)
+    {
+        return print(String(value));
+    }
+    size_t print(unsigned long value)
+    {
+        return print(String(value));
+    }
+    size_t println()
+    {
+        return write("\n");
+    }
+    template <class T> size_t println(const T & value)
+    {
+        size_t result = print(value);
+        return result + println();
+    }
+    virtual void flush() {}
+    virtual int availableForWrite()
+    {
+        return 0;
+    }
+};
+
+///
+/// @brief Stream
+///
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    size_t readBytes(uint8_t * buffer, size_t size)
+    {
+        size_t index = 0;
+        while (index < size)
+        {
+            int character = read();
+            if (character < 0)
+            {
+                break;
+            }
+            buffer[index] = character;
+            index += 1;
+        }
+        return index;
+    }
+    size_t readBytes(char * buffer, size_t size)
+    {
+        return readBytes((uint8_t *)buffer, size);
+    }
+};
+
+///
+/// @brief Serial on the standard output
+///
+class HostSerial : public Stream
+{
+  public:
+    void begin(long) {}
+    size_t write(uint8_t character)
+    {
+        putchar(character);
+        return 1;
+    }
+    using Print::write;
+    int available()
+    {
+        return 0;
+    }
+    int read()
+    {
+        return -1;
+    }
+    int peek()
+    {
+        return -1;
+    }
+    operator bool()
+    {
+        return true;
+    }
+};
+
+extern HostSerial Serial;
+
+#endif // HOST_ARDUINO_RELEASE
@@ -0,0 +1,99 @@
+///
+/// @file Host_Stubs.cpp
+/// @brief Minimal Arduino core to build the library on the computer
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @see Arduino.h for the behaviour
+///
+/// Release 821: First release
+/// Release 821: Added hooks for the GPIOs and SPI
+///
+
+// SDK
+#include <chrono>
+#include <atomic>
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "Wire.h"
+
+HostSerial Serial;
+SPIClass SPI;
+TwoWire Wire;
+
+hostWriteHook_t hostWriteHook = nullptr;
+hostReadHook_t hostReadHook = nullptr;
+hostTransferHook_t hostTransferHook = nullptr;
+uint32_t hostClockSPI = 0;
+
+// Pins written by the flushing thread only, see the Concurrency page
+static uint8_t hostValues[256];
+static uint8_t hostModes[256];
+
+// Clock advanced by delay(), atomic as read by all threads
+static std::atomic<uint32_t> hostDelay(0);
+static const auto hostStart = std::chrono::steady_clock::now();
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    hostModes[pin] = mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    hostValues[pin] = value;
+    if (hostWriteHook != nullptr)
+    {
+        hostWriteHook(pin, value);
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    if (hostModes[pin] == OUTPUT)
+    {
+        return hostValues[pin];
+    }
+    return (hostReadHook != nullptr) ? hostReadHook(pin) : HIGH;
+}
+
+uint8_t hostPinMode(uint8_t pin)
+{
+    return hostModes[pin];
+}
+
+uint8_t hostPinValue(uint8_t pin)
+{
+    return hostValues[pin];
+}
+
+void delay(uint32_t ms)
+{
+    hostDelay += ms * 1000;
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    hostDelay += us;
+}
+
+uint32_t micros()
+{
+    uint32_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostStart).count();
+    return elapsed + hostDelay;
+}
+
+uint32_t millis()
+{
+    return micros() / 1000;
+}
@@ -0,0 +1,79 @@
+///
+/// @file SPI.h
+/// @brief Minimal SPI library to build the library on the computer
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details The bytes sent are discarded, the bytes received are 0x00,
+/// unless a tool sets hostTransferHook to simulate the device.
+///
+/// Release 821: First release
+/// Release 821: Added hook for the bytes and clock of the transaction
+///
+
+#ifndef HOST_SPI_RELEASE
+///
+/// @brief Release
+///
+#define HOST_SPI_RELEASE 821
+
+#include "Arduino.h"
+
+struct SPISettings
+{
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+///
+/// @brief Hook called by transfer() for each byte, nullptr by default
+/// @param value byte sent
+/// @return byte received
+///
+typedef uint8_t (*hostTransferHook_t)(uint8_t value);
+
+extern hostTransferHook_t hostTransferHook;
+
+///
+/// @brief Clock of the last transaction, Hz
+///
+extern uint32_t hostClockSPI;
+
+class SPIClass
+{
+  public:
+    void begin() {}
+    void begin(int, int, int) {}
+    void end() {}
+    void beginTransaction(SPISettings settings)
+    {
+        hostClockSPI = settings.clock;
+    }
+    void endTransaction() {}
+    uint8_t transfer(uint8_t value)
+    {
+        return (hostTransferHook != nullptr) ? hostTransferHook(value) : 0x00;
+    }
+    void transfer(void * buffer, size_t size)
+    {
+        uint8_t * bytes = (uint8_t *)buffer;
+        for (size_t index = 0; index < size; index += 1)
+        {
+            bytes[index] = transfer(bytes[index]);
+        }
+    }
+};
+
+extern SPIClass SPI;
+
+#endif // HOST_SPI_RELEASE
@@ -0,0 +1,60 @@
+///
+/// @file Wire.h
+/// @brief Minimal Wire library to build the library on the computer
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details No device answers.
+///
+/// Release 821: First release
+///
+
+#ifndef HOST_WIRE_RELEASE
+///
+/// @brief Release
+///
+#define HOST_WIRE_RELEASE 821
+
+#include "Arduino.h"
+
+class TwoWire
+{
+  public:
+    void begin() {}
+    void end() {}
+    void setClock(long) {}
+    void beginTransmission(uint8_t) {}
+    int endTransmission()
+    {
+        return 0;
+    }
+    size_t write(uint8_t)
+    {
+        return 1;
+    }
+    int requestFrom(uint8_t, size_t)
+    {
+        return 0;
+    }
+    int available()
+    {
+        return 0;
+    }
+    int read()
+    {
+        return 0;
+    }
+};
+
+extern TwoWire Wire;
+
+#endif // HOST_WIRE_RELEASE
@@ -0,0 +1,175 @@
+///
+/// @file Render_Stress.cpp
+/// @brief Render and flush on two threads, computer tool
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details Stress test of the ownership rules of the Concurrency page, built with the minimal Arduino core of Host_Stubs.
+/// @n One thread renders the frames, alternately into two screens, with the text and utility functions.
+/// The other thread takes each screen at hand-over, hashes its image with exportImage() and calls flush().
+/// The hand-over uses a release store and an acquire load.
+/// @n Each hash is compared with the hash of the same frame rendered on a single thread.
+/// @n Build with ThreadSanitizer, which reports any data race
+/// @code
+/// c++ -std=gnu++17 -O1 -g -fsanitize=thread -pthread -I../Host_Stubs -I../../src Render_Stress.cpp ../Host_Stubs/Host_Stubs.cpp ../../src/*.cpp -o Render_Stress
+/// @endcode
+///
+/// @n Usage
+/// @code
+/// ./Render_Stress [frames]
+/// @endcode
+///
+/// @n Exit code: 0 if all the frames are identical, 1 otherwise
+///
+/// Release 821: First release
+///
+
+// SDK
+#include <thread>
+#include <atomic>
+#include <vector>
+
+// Library
+#include "PDLS_EXT3_Basic_Global.h"
+
+///
+/// @brief Print computing the FNV-1a hash of the bytes written
+///
+class HashPrint : public Print
+{
+  public:
+    uint32_t hash = 0x811c9dc5;
+
+    size_t write(uint8_t character)
+    {
+        hash = hashFNV(&character, 1, hash);
+        return 1;
+    }
+    size_t write(const uint8_t * buffer, size_t size)
+    {
+        hash = hashFNV(buffer, size, hash);
+        return size;
+    }
+};
+
+///
+/// @brief Hash of the image of the screen
+/// @param screen screen
+/// @return hash of the PPM image
+///
+static uint32_t hashScreen(Screen_EPD_EXT3 & screen)
+{
+    HashPrint output;
+    screen.exportImage(output, EXPORT_PPM);
+    return output.hash;
+}
+
+///
+/// @brief Render one frame
+/// @param screen screen
+/// @param frame frame number
+///
+static void render(Screen_EPD_EXT3 & screen, uint32_t frame)
+{
+    char label[32];
+    char iso[16];
+
+    screen.clear();
+    screen.selectFont(Font_Terminal8x12);
+    formatBuffer(label, sizeof(label), "Frame %i", frame);
+    screen.gText(0, 0, label);
+    screen.gTextf(0, 20, myColours.black, myColours.white, "%i", frame * 7);
+    screen.gText(0, 40, formatString("%i", frame * 13));
+    screen.gText(0, 60, utf2iso(String("Caf\xc3\xa9")));
+    utf2iso("\xe2\x82\xac", iso, sizeof(iso));
+    screen.gText(60, 60, iso);
+    screen.gTextUTF8(0, 80, "\xc3\xa9t\xc3\xa9");
+
+    screen.setPenSolid(true);
+    screen.triangle(10, 100 + frame % 50, 100, 120, 50, 200, myColours.black);
+    screen.setPenSolid(false);
+    screen.circle(100, 200, 10 + frame % 30, myColours.black);
+}
+
+///
+/// @brief Main
+/// @param argc number of arguments
+/// @param argv arguments: optional number of frames
+/// @return 0 if all the frames are identical, 1 otherwise
+///
+int main(int argc, char ** argv)
+{
+    uint32_t frames = (argc > 1) ? atoi(argv[1]) : 100;
+
+    Screen_EPD_EXT3 screenA(eScreen_EPD_266_CS_0C, boardRaspberryPiPico_RP2040);
+    Screen_EPD_EXT3 screenB(eScreen_EPD_266_CS_0C, boardRaspberryPiPico_RP2040);
+    screenA.begin();
+    screenB.begin();
+    Screen_EPD_EXT3 * screens[2] = {&screenA, &screenB};
+
+    // Reference on a single thread
+    std::vector<uint32_t> reference(frames);
+    for (uint32_t frame = 0; frame < frames; frame += 1)
+    {
+        render(screenA, frame);
+        reference[frame] = hashScreen(screenA);
+    }
+
+    // Render and flush on two threads
+    std::vector<uint32_t> flushed(frames);
+    std::atomic<int32_t> ready(-1);
+    std::atomic<int32_t> done(-1);
+
+    std::thread threadRender([&]()
+    {
+        for (int32_t frame = 0; frame < (int32_t)frames; frame += 1)
+        {
+            // Wait until the screen is back from the flushing thread
+            while (done.load(std::memory_order_acquire) < frame - 2)
+            {
+                std::this_thread::yield();
+            }
+            render(*screens[frame % 2], frame);
+            ready.store(frame, std::memory_order_release);
+        }
+    });
+
+    std::thread threadFlush([&]()
+    {
+        for (int32_t frame = 0; frame < (int32_t)frames; frame += 1)
+        {
+            while (ready.load(std::memory_order_acquire) < frame)
+            {
+                std::this_thread::yield();
+            }
+            flushed[frame] = hashScreen(*screens[frame % 2]);
+            screens[frame % 2]->flush();
+            done.store(frame, std::memory_order_release);
+        }
+    });
+
+    threadRender.join();
+    threadFlush.join();
+
+    uint32_t errors = 0;
+    for (uint32_t frame = 0; frame < frames; frame += 1)
+    {
+        if (flushed[frame] != reference[frame])
+        {
+            printf("Frame %u different\n", frame);
+            errors += 1;
+        }
+    }
+
+    printf("%u frames, %u different\n", frames, errors);
+    return (errors == 0) ? 0 : 1;
+}
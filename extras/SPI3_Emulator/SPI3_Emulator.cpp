@@ -0,0 +1,305 @@
+///
+/// @file SPI3_Emulator.cpp
+/// @brief Check the 3-wire SPI against an emulated controller, computer tool
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details 3-wire SPI of hV_HAL_Peripherals, built with the minimal Arduino core of Host_Stubs.
+/// @n The emulated controller samples or presents one bit on each rising edge of the clock while CS is low,
+/// with the data pin in output or input mode.
+/// The bytes written are recorded with the level of DC, the bytes read come from a random memory,
+/// and CS high restarts both.
+/// @n For SPI3_MODE_FAST and SPI3_MODE_CONSERVATIVE, the tool checks
+/// * hV_HAL_SPI3_write(), hV_HAL_SPI3_read() and hV_HAL_SPI3_readBlock() against the controller,
+/// * begin() of each screen writes and reads the same bytes with the same number of edges in both modes,
+/// and the next flush() sends the same bytes on the 4-wire SPI.
+///
+/// @n Build
+/// @code
+/// c++ -std=gnu++17 -O2 -I../Host_Stubs -I../../src SPI3_Emulator.cpp ../Host_Stubs/Host_Stubs.cpp ../../src/*.cpp -o SPI3_Emulator
+/// @endcode
+///
+/// @n Usage
+/// @code
+/// ./SPI3_Emulator
+/// @endcode
+///
+/// @n Exit code: 0 if both modes match the controller and each other, 1 otherwise
+///
+/// Release 821: First release
+///
+
+// SDK
+#include <vector>
+
+// Library
+#include "PDLS_EXT3_Basic_Global.h"
+
+///
+/// @brief Size of the memory of the controller
+///
+#define EMULATOR_MEMORY 256
+
+///
+/// @brief Emulated controller
+///
+struct emulator_s
+{
+    uint8_t pinClock; ///< clock, SCK
+    uint8_t pinData; ///< data, MOSI
+    uint8_t pinCS; ///< chip select
+    uint8_t pinDC; ///< data or command
+    uint8_t memory[EMULATOR_MEMORY]; ///< bytes to read
+    uint16_t indexRead; ///< next byte to read
+    uint8_t bit; ///< bit of the current byte, 0..7
+    uint8_t shift; ///< byte being written
+    uint8_t output; ///< level presented on the data pin
+    uint32_t edges; ///< rising edges with CS low
+    uint32_t reads; ///< bytes read
+    std::vector<uint16_t> written; ///< bytes written, with DC in bit 8
+};
+
+static emulator_s emulator;
+
+///
+/// @brief Write hook, clock and CS
+///
+static void emulatorWrite(uint8_t pin, uint8_t value)
+{
+    if (pin == emulator.pinCS)
+    {
+        emulator.indexRead = 0;
+        emulator.bit = 0;
+        emulator.shift = 0;
+        return;
+    }
+
+    if ((pin != emulator.pinClock) or (value != HIGH) or (hostPinValue(emulator.pinCS) != LOW))
+    {
+        return;
+    }
+
+    emulator.edges += 1;
+    if (hostPinMode(emulator.pinData) == OUTPUT)
+    {
+        // Sample
+        emulator.shift = (emulator.shift << 1) | (hostPinValue(emulator.pinData) & 0x01);
+        emulator.bit += 1;
+        if (emulator.bit == 8)
+        {
+            emulator.written.push_back(hostPinValue(emulator.pinDC) << 8 | emulator.shift);
+            emulator.bit = 0;
+            emulator.shift = 0;
+        }
+    }
+    else
+    {
+        // Present
+        emulator.output = (emulator.memory[emulator.indexRead] >> (7 - emulator.bit)) & 0x01;
+        emulator.bit += 1;
+        if (emulator.bit == 8)
+        {
+            emulator.indexRead = (emulator.indexRead + 1) % EMULATOR_MEMORY;
+            emulator.reads += 1;
+            emulator.bit = 0;
+        }
+    }
+}
+
+///
+/// @brief Read hook, data
+///
+static int emulatorRead(uint8_t pin)
+{
+    return (pin == emulator.pinData) ? emulator.output : HIGH;
+}
+
+///
+/// @brief Bytes sent on the 4-wire SPI, with DC in bit 8
+///
+static std::vector<uint16_t> record;
+
+///
+/// @brief Record a byte sent on the 4-wire SPI
+/// @param value byte sent
+/// @return 0x00
+///
+static uint8_t recordByte(uint8_t value)
+{
+    record.push_back(hostPinValue(emulator.pinDC) << 8 | value);
+    return 0x00;
+}
+
+///
+/// @brief Start the controller
+/// @param pins pins of the board
+/// @param seed seed for the memory
+///
+static void emulatorBegin(const pins_t & pins, uint16_t seed)
+{
+    emulator.pinClock = SCK;
+    emulator.pinData = MOSI;
+    emulator.pinCS = pins.panelCS;
+    emulator.pinDC = pins.panelDC;
+
+    srand(seed);
+    for (uint16_t index = 0; index < EMULATOR_MEMORY; index += 1)
+    {
+        emulator.memory[index] = rand();
+    }
+    emulator.indexRead = 0;
+    emulator.bit = 0;
+    emulator.shift = 0;
+    emulator.output = HIGH;
+    emulator.edges = 0;
+    emulator.reads = 0;
+    emulator.written.clear();
+
+    hostWriteHook = emulatorWrite;
+    hostReadHook = emulatorRead;
+}
+
+///
+/// @brief Stop the controller
+///
+static void emulatorEnd()
+{
+    hostWriteHook = nullptr;
+    hostReadHook = nullptr;
+}
+
+///
+/// @brief Write and read against the controller
+/// @param mode SPI3_MODE_FAST or SPI3_MODE_CONSERVATIVE
+/// @return 0 if the bytes match, 1 otherwise
+///
+static uint32_t checkFunctions(uint8_t mode)
+{
+    const pins_t pins = boardRaspberryPiPico_RP2040;
+    uint8_t buffer[128];
+    uint32_t errors = 0;
+
+    pinMode(pins.panelCS, OUTPUT);
+    pinMode(pins.panelDC, OUTPUT);
+    digitalWrite(pins.panelCS, HIGH);
+    emulatorBegin(pins, 44);
+
+    hV_HAL_SPI3_begin();
+    hV_HAL_SPI3_setMode(mode);
+
+    // Command then data
+    digitalWrite(pins.panelCS, LOW);
+    digitalWrite(pins.panelDC, LOW);
+    hV_HAL_SPI3_write(0xa2);
+    digitalWrite(pins.panelDC, HIGH);
+    hV_HAL_SPI3_write(0x5c);
+
+    // Single bytes, then a block
+    buffer[0] = hV_HAL_SPI3_read();
+    buffer[1] = hV_HAL_SPI3_read();
+    hV_HAL_SPI3_readBlock(buffer + 2, sizeof(buffer) - 2);
+    digitalWrite(pins.panelCS, HIGH);
+
+    std::vector<uint16_t> expected = {0x00a2, 0x015c};
+    errors += (emulator.written == expected) ? 0 : 1;
+    errors += (memcmp(buffer, emulator.memory, sizeof(buffer)) == 0) ? 0 : 1;
+    errors += (emulator.edges == 8 * (2 + sizeof(buffer))) ? 0 : 1;
+
+    emulatorEnd();
+    printf("%-24s %s\n", (mode == SPI3_MODE_FAST) ? "Functions, fast" : "Functions, conservative", (errors == 0) ? "match" : "different");
+    return errors;
+}
+
+///
+/// @brief Result of begin() and flush() for one mode
+///
+struct result_s
+{
+    String name; ///< name of the screen
+    std::vector<uint16_t> written; ///< bytes written on the 3-wire SPI
+    uint32_t reads; ///< bytes read on the 3-wire SPI
+    uint32_t edges; ///< rising edges of the clock
+    std::vector<uint16_t> flushed; ///< bytes sent on the 4-wire SPI by flush()
+};
+
+///
+/// @brief Start a screen and flush it, with the controller
+/// @param screen screen
+/// @param mode SPI3_MODE_FAST or SPI3_MODE_CONSERVATIVE
+/// @return result
+///
+static result_s runScreen(eScreen_EPD_t screen, uint8_t mode)
+{
+    result_s result;
+
+    hV_HAL_SPI3_setMode(mode);
+    emulatorBegin(boardRaspberryPiPico_RP2040, 7);
+
+    Screen_EPD_EXT3 myScreen(screen, boardRaspberryPiPico_RP2040);
+    myScreen.begin();
+
+    result.name = myScreen.WhoAmI();
+    result.written = emulator.written;
+    result.reads = emulator.reads;
+    result.edges = emulator.edges;
+
+    myScreen.clear();
+    myScreen.setPenSolid(true);
+    myScreen.circle(myScreen.screenSizeX() / 2, myScreen.screenSizeY() / 2, 40, myColours.black);
+    myScreen.setPenSolid(false);
+
+    emulatorEnd();
+    record.clear();
+    hostTransferHook = recordByte;
+    myScreen.flush();
+    hostTransferHook = nullptr;
+    result.flushed = record;
+
+    myScreen.end();
+    return result;
+}
+
+///
+/// @brief Main
+/// @return 0 if both modes match the controller and each other, 1 otherwise
+///
+int main()
+{
+    const eScreen_EPD_t screens[] =
+    {
+        eScreen_EPD_266_CS_0C,
+        eScreen_EPD_417_JS_0D,
+        eScreen_EPD_581_JS_0B,
+        eScreen_EPD_741_JS_0B,
+        eScreen_EPD_969_JS_0B,
+        eScreen_EPD_B98_CS_0B,
+    };
+    uint32_t errors = 0;
+
+    errors += checkFunctions(SPI3_MODE_FAST);
+    errors += checkFunctions(SPI3_MODE_CONSERVATIVE);
+
+    for (eScreen_EPD_t screen : screens)
+    {
+        result_s fast = runScreen(screen, SPI3_MODE_FAST);
+        result_s conservative = runScreen(screen, SPI3_MODE_CONSERVATIVE);
+
+        bool flag = (fast.written == conservative.written) and (fast.reads == conservative.reads)
+                    and (fast.edges == conservative.edges) and (fast.flushed == conservative.flushed);
+        printf("%s: %3zu bytes written, %3i read, %5i edges, %6zu bytes flushed, %s\n",
+               fast.name.c_str(), fast.written.size(), fast.reads, fast.edges, fast.flushed.size(), flag ? "same" : "different");
+        errors += flag ? 0 : 1;
+    }
+
+    hV_HAL_SPI3_setMode();
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,258 @@
+///
+/// @file Stream_Identity.cpp
+/// @brief Check the updates without frame-buffer against flush(), computer tool
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details Identity of the bus output, built with the minimal Arduino core of Host_Stubs.
+/// @n For each screen, a random image is flushed with flush() and each byte sent on the bus is recorded,
+/// with the levels of DC, CS and CSS.
+/// The same image is then sent with flushFromReader(), flushFromStream() and flushFromCompressed(),
+/// and the tool checks the records are identical.
+/// @n The stream provides the black plane only for the monochrome screens,
+/// and the bytes in the panel order for the 9.69" and 11.98" colour screens.
+/// @n The tool also checks a truncated stream returns RESULT_ERROR,
+/// and the frame-buffer is left unchanged.
+///
+/// @n Build
+/// @code
+/// c++ -std=gnu++17 -O2 -I../Host_Stubs -I../../src Stream_Identity.cpp ../Host_Stubs/Host_Stubs.cpp ../../src/*.cpp -o Stream_Identity
+/// @endcode
+///
+/// @n Usage
+/// @code
+/// ./Stream_Identity
+/// @endcode
+///
+/// @n Exit code: 0 if all the outputs are identical, 1 otherwise
+///
+/// Release 821: First release
+///
+
+// SDK
+#include <vector>
+
+// Library
+#include "PDLS_EXT3_Basic_Global.h"
+
+///
+/// @brief Screens to check
+///
+struct screen_s
+{
+    eScreen_EPD_t screen; ///< screen
+    bool flagMono; ///< black plane only
+    bool flagHalves; ///< 9.69" and 11.98", two halves
+};
+
+static const screen_s screens[] =
+{
+    {eScreen_EPD_266_CS_0C, true, false},
+    {eScreen_EPD_266_JS_0C, false, false},
+    {eScreen_EPD_417_JS_0D, false, false},
+    {eScreen_EPD_741_CS_0B, true, false},
+    {eScreen_EPD_741_JS_0B, false, false},
+    {eScreen_EPD_969_JS_0B, false, true},
+    {eScreen_EPD_B98_CS_0B, true, true},
+    {eScreen_EPD_B98_JS_0B, false, true},
+};
+
+///
+/// @brief Byte sent on the bus, with the levels of DC, CS and CSS
+///
+static std::vector<uint32_t> record;
+
+static pins_t recordPins;
+
+///
+/// @brief Record a byte sent on the bus
+/// @param value byte sent
+/// @return 0x00
+///
+static uint8_t recordByte(uint8_t value)
+{
+    uint32_t levels = hostPinValue(recordPins.panelDC) << 2 | hostPinValue(recordPins.panelCS) << 1;
+    if (recordPins.panelCSS != NOT_CONNECTED)
+    {
+        levels |= hostPinValue(recordPins.panelCSS);
+    }
+    record.push_back(levels << 8 | value);
+    return 0x00;
+}
+
+///
+/// @brief Image for the reader, in the frame-buffer layout
+///
+static std::vector<uint8_t> image;
+
+///
+/// @brief Reader for flushFromReader()
+///
+static uint32_t readImage(uint8_t * buffer, uint32_t offset, uint32_t size)
+{
+    if (offset >= image.size())
+    {
+        return 0;
+    }
+    size = hV_HAL_min(size, (uint32_t)(image.size() - offset));
+    memcpy(buffer, image.data() + offset, size);
+    return size;
+}
+
+///
+/// @brief Stream on an array
+///
+class ArrayStream : public Stream
+{
+  public:
+    std::vector<uint8_t> data;
+    size_t position = 0;
+
+    int available()
+    {
+        return data.size() - position;
+    }
+    int read()
+    {
+        return (position < data.size()) ? data[position++] : -1;
+    }
+    int peek()
+    {
+        return (position < data.size()) ? data[position] : -1;
+    }
+    size_t write(uint8_t)
+    {
+        return 0;
+    }
+};
+
+///
+/// @brief Read the frame-buffer
+/// @param screen screen
+/// @return black plane then red plane
+///
+static std::vector<uint8_t> readFrame(Screen_EPD_EXT3 & screen)
+{
+    hV_Store_RAM store(1);
+    std::vector<uint8_t> frame(screen.getFrameSize());
+    store.begin(frame.size());
+    screen.storeFrame(store, 0);
+    store.read(0, 0, frame.data(), frame.size());
+    return frame;
+}
+
+///
+/// @brief Report a check
+/// @param label name of the check
+/// @param flag result of the check
+/// @return 0 if passed, 1 otherwise
+///
+static uint32_t check(const char * label, bool flag)
+{
+    if (not flag)
+    {
+        printf("    %s: different\n", label);
+    }
+    return flag ? 0 : 1;
+}
+
+///
+/// @brief Main
+/// @return 0 if all the outputs are identical, 1 otherwise
+///
+int main()
+{
+    uint32_t errors = 0;
+
+    for (const screen_s & item : screens)
+    {
+        Screen_EPD_EXT3 screen(item.screen, boardRaspberryPiPico_RP2040);
+        screen.begin();
+        recordPins = screen.getBoardPins();
+
+        // Random image, red included
+        srand(5);
+        screen.clear();
+        uint16_t x = screen.screenSizeX();
+        uint16_t y = screen.screenSizeY();
+        screen.setPenSolid(true);
+        for (uint16_t i = 0; i < 200; i += 1)
+        {
+            uint16_t colour = (i % 3 == 0) ? myColours.red : (i % 2) ? myColours.black : myColours.grey;
+            screen.triangle(rand() % x, rand() % y, rand() % x, rand() % y, rand() % x, rand() % y, colour);
+        }
+        screen.setPenSolid(false);
+        image = readFrame(screen);
+
+        uint32_t size = image.size();
+        std::vector<uint8_t> compressed(frameEncodeBound(size));
+        compressed.resize(screen.compressFrame(compressed.data(), compressed.size()));
+
+        hostTransferHook = recordByte;
+
+        record.clear();
+        screen.flush();
+        std::vector<uint32_t> reference = record;
+
+        // Frame-buffer cleared, so the other sources are not read from it
+        screen.clear(myColours.black);
+        std::vector<uint8_t> frame = readFrame(screen);
+        uint32_t errorsScreen = 0;
+
+        record.clear();
+        uint8_t result = screen.flushFromReader(readImage);
+        errorsScreen += check("flushFromReader()", (result == RESULT_SUCCESS) and (record == reference));
+
+        ArrayStream stream;
+        uint32_t half = size / 4;
+        if (item.flagMono)
+        {
+            stream.data.assign(image.begin(), image.begin() + size / 2);
+        }
+        else if (item.flagHalves)
+        {
+            // Panel order, first half of both planes, then second half of both planes
+            for (uint8_t index = 0; index < 4; index += 1)
+            {
+                uint32_t start = (index % 2) * 2 * half + (index / 2) * half;
+                stream.data.insert(stream.data.end(), image.begin() + start, image.begin() + start + half);
+            }
+        }
+        else
+        {
+            stream.data = image;
+        }
+        record.clear();
+        result = screen.flushFromStream(stream);
+        errorsScreen += check("flushFromStream()", (result == RESULT_SUCCESS) and (record == reference) and (stream.available() == 0));
+
+        record.clear();
+        result = screen.flushFromCompressed(compressed.data(), compressed.size());
+        errorsScreen += check("flushFromCompressed()", (result == RESULT_SUCCESS) and (record == reference));
+
+        ArrayStream truncated;
+        truncated.data.assign(image.begin(), image.begin() + 1000);
+        record.clear();
+        result = screen.flushFromStream(truncated);
+        errorsScreen += check("truncated stream", (result == RESULT_ERROR) and (record.size() == reference.size()));
+
+        hostTransferHook = nullptr;
+        errorsScreen += check("frame-buffer", readFrame(screen) == frame);
+
+        printf("%s: %i bytes, %i compressed, %zu bytes sent, %s\n", screen.WhoAmI().c_str(), size, (uint32_t)compressed.size(), reference.size(),
+               (errorsScreen == 0) ? "identical" : "different");
+        errors += errorsScreen;
+        screen.end();
+    }
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,488 @@
+///
+/// @file Trace_Replay.cpp
+/// @brief Replay a trace exported by exportTrace(), computer tool
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// @details The input is the text written by exportTrace(), for example captured from the serial port.
+/// Other lines are ignored.
+/// @n The events are replayed into a simulated controller, one per half for the large screens:
+/// the bytes sent with DC low are commands, the bytes sent with DC high are data of the last command.
+/// @n The tool prints the timeline, with the runs of data bytes combined, then a summary.
+/// The optional image is rebuilt from the last first and second frames received,
+/// with the same size and colours as exportImage() in orientation 0.
+///
+/// @n Build
+/// @code
+/// c++ -O2 Trace_Replay.cpp -o Trace_Replay
+/// @endcode
+///
+/// @n Usage
+/// @code
+/// ./Trace_Replay trace.txt [image.ppm]
+/// @endcode
+///
+/// @n Exit code: 0 if success, 1 if events were dropped or frames are incomplete, 2 if error
+///
+/// Release 821: First release
+///
+
+// SDK
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define FAMILY_SMALL 0x01 ///< Same as hV_List_Constants.h
+#define FAMILY_LARGE 0x03 ///< Same as hV_List_Constants.h
+#define NOT_CONNECTED 0xff ///< Same as hV_List_Boards.h
+
+///
+/// @brief Screen and panel pins, from the first line
+///
+struct screen_s
+{
+    uint32_t sizeH; ///< small size, pixels
+    uint32_t sizeV; ///< large size, pixels
+    uint32_t family; ///< FAMILY_SMALL, FAMILY_MEDIUM or FAMILY_LARGE
+    char film; ///< film
+    uint32_t pinDC; ///< DC
+    uint32_t pinCS; ///< CS, master
+    uint32_t pinCSS; ///< CSS, slave
+    uint32_t pinBusy; ///< BUSY
+    uint32_t pinReset; ///< RESET
+};
+
+///
+/// @brief Growing array of bytes
+///
+struct bytes_s
+{
+    uint8_t * data; ///< bytes
+    uint32_t size; ///< number of bytes
+    uint32_t capacity; ///< allocated
+};
+
+///
+/// @brief Simulated controller
+///
+struct controller_s
+{
+    int command; ///< last command, -1 if none
+    bytes_s data; ///< data of the last command
+    bytes_s first; ///< data of the last first frame, 0x10
+    bytes_s second; ///< data of the last second frame, 0x11 or 0x13
+    uint32_t commands; ///< number of commands
+    uint32_t bytes; ///< number of data bytes
+};
+
+///
+/// @brief Add a byte
+/// @param bytes array
+/// @param value byte
+///
+static void addByte(bytes_s & bytes, uint8_t value)
+{
+    if (bytes.size == bytes.capacity)
+    {
+        bytes.capacity = (bytes.capacity == 0) ? 4096 : bytes.capacity * 2;
+        bytes.data = (uint8_t *)realloc(bytes.data, bytes.capacity);
+        if (bytes.data == NULL)
+        {
+            fprintf(stderr, "Out of memory\n");
+            exit(2);
+        }
+    }
+    bytes.data[bytes.size] = value;
+    bytes.size += 1;
+}
+
+///
+/// @brief Copy an array
+/// @param destination array
+/// @param source array
+///
+static void copyBytes(bytes_s & destination, const bytes_s & source)
+{
+    destination.size = 0;
+    for (uint32_t index = 0; index < source.size; index += 1)
+    {
+        addByte(destination, source.data[index]);
+    }
+}
+
+///
+/// @brief End of the current command, data kept for the frames
+/// @param controller controller
+/// @param secondFrame command of the second frame
+///
+static void closeCommand(controller_s & controller, int secondFrame)
+{
+    if (controller.command == 0x10)
+    {
+        copyBytes(controller.first, controller.data);
+    }
+    else if (controller.command == secondFrame)
+    {
+        copyBytes(controller.second, controller.data);
+    }
+    controller.command = -1;
+    controller.data.size = 0;
+}
+
+///
+/// @brief Name of a pin
+/// @param screen screen with the pins
+/// @param pin pin number
+/// @return name
+///
+static const char * pinName(const screen_s & screen, uint32_t pin)
+{
+    static char name[16];
+
+    if (pin == screen.pinDC)
+    {
+        return "DC";
+    }
+    else if (pin == screen.pinCS)
+    {
+        return "CS";
+    }
+    else if ((pin == screen.pinCSS) and (pin != NOT_CONNECTED))
+    {
+        return "CSS";
+    }
+    else if (pin == screen.pinBusy)
+    {
+        return "BUSY";
+    }
+    else if (pin == screen.pinReset)
+    {
+        return "RESET";
+    }
+    snprintf(name, sizeof(name), "pin %u", pin);
+    return name;
+}
+
+///
+/// @brief Write the image rebuilt from the frames
+/// @param name file name
+/// @param screen screen
+/// @param black first frame, both halves for the large screens
+/// @param red second frame, both halves for the large screens
+/// @return true if success
+///
+static bool writeImage(const char * name, const screen_s & screen, const uint8_t * black, const uint8_t * red)
+{
+    FILE * file = fopen(name, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Cannot write %s\n", name);
+        return false;
+    }
+
+    uint32_t bufferSizeH = screen.sizeH / 8;
+    uint32_t pageColourSize = screen.sizeV * bufferSizeH;
+
+    // Orientation 0, native coordinates swapped, see s_orientCoordinates() and s_getZ()
+    fprintf(file, "P6\n%u %u\n255\n", screen.sizeH, screen.sizeV);
+    for (uint32_t y = 0; y < screen.sizeV; y += 1)
+    {
+        for (uint32_t x = 0; x < screen.sizeH; x += 1)
+        {
+            uint32_t x1 = y;
+            uint32_t y1 = x;
+            uint32_t z1 = 0;
+            if (screen.family == FAMILY_LARGE)
+            {
+                if (y1 >= screen.sizeH / 2)
+                {
+                    y1 -= screen.sizeH / 2;
+                    z1 += pageColourSize / 2;
+                }
+                z1 += x1 * (bufferSizeH / 2) + y1 / 8;
+            }
+            else
+            {
+                z1 = x1 * bufferSizeH + y1 / 8;
+            }
+            uint8_t b1 = 7 - (y1 % 8);
+
+            uint8_t pixel[3] = {0xff, 0xff, 0xff}; // white
+            if ((red[z1] >> b1) & 0x01)
+            {
+                pixel[1] = 0x00; // red
+                pixel[2] = 0x00;
+            }
+            else if ((black[z1] >> b1) & 0x01)
+            {
+                pixel[0] = 0x00; // black
+                pixel[1] = 0x00;
+                pixel[2] = 0x00;
+            }
+            fwrite(pixel, 1, 3, file);
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+///
+/// @brief Main
+/// @param argc number of arguments
+/// @param argv arguments: trace, optional image
+/// @return 0 if success, 1 if incomplete, 2 if error
+///
+int main(int argc, char ** argv)
+{
+    if ((argc != 2) and (argc != 3))
+    {
+        fprintf(stderr, "Usage: %s trace.txt [image.ppm]\n", argv[0]);
+        return 2;
+    }
+
+    FILE * file = fopen(argv[1], "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 2;
+    }
+
+    screen_s screen;
+    memset(&screen, 0, sizeof(screen));
+    bool flagScreen = false;
+    bool flagTrace = false;
+    unsigned long events = 0;
+    unsigned long dropped = 0;
+
+    controller_s controllers[2];
+    memset(controllers, 0, sizeof(controllers));
+    controllers[0].command = -1;
+    controllers[1].command = -1;
+
+    uint8_t levels[256];
+    memset(levels, 1, sizeof(levels)); // HIGH
+
+    int secondFrame = 0x11;
+    unsigned long timeFirst = 0;
+    unsigned long timeLast = 0;
+    unsigned long timeWait = 0;
+    unsigned long totalWait = 0;
+    unsigned long totalDelay = 0;
+    unsigned long runBytes = 0; // data bytes not printed yet
+    unsigned long runTime = 0;
+    unsigned long count = 0;
+
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        char film = 0;
+        if (sscanf(line, "hV screen %u %u family %u film %c dc %u cs %u css %u busy %u reset %u", &screen.sizeH, &screen.sizeV, &screen.family, &film, &screen.pinDC, &screen.pinCS, &screen.pinCSS, &screen.pinBusy, &screen.pinReset) == 9)
+        {
+            screen.film = film;
+            secondFrame = (screen.family == FAMILY_SMALL) ? 0x13 : 0x11;
+            flagScreen = true;
+            continue;
+        }
+        if (sscanf(line, "hV trace 1 events %lu dropped %lu", &events, &dropped) == 2)
+        {
+            flagTrace = true;
+            continue;
+        }
+        if (strncmp(line, "hV trace end", 12) == 0)
+        {
+            break;
+        }
+        if ((flagScreen == false) or (flagTrace == false))
+        {
+            continue;
+        }
+
+        unsigned long time;
+        char kind;
+        unsigned pin;
+        unsigned value;
+        if (sscanf(line, "%lu %c %u %u", &time, &kind, &pin, &value) != 4)
+        {
+            continue;
+        }
+
+        if (count == 0)
+        {
+            timeFirst = time;
+        }
+        count += 1;
+        timeLast = time;
+        double milliseconds = (time - timeFirst) / 1000.0;
+
+        // Data bytes printed as one run
+        if ((runBytes > 0) and ((kind != 'S') or (levels[screen.pinDC] == 0)))
+        {
+            printf("%10.3f ms  data %lu bytes\n", (runTime - timeFirst) / 1000.0, runBytes);
+            runBytes = 0;
+        }
+
+        switch (kind)
+        {
+            case 'S':
+            {
+                uint8_t data = value & 0xff;
+                uint32_t repeat = (value >> 8) + 1;
+                bool flagCommand = (levels[screen.pinDC] == 0);
+
+                if (flagCommand)
+                {
+                    printf("%10.3f ms  command 0x%02x%s%s\n", milliseconds, data, (levels[screen.pinCS] == 0) ? " master" : "", ((screen.pinCSS != NOT_CONNECTED) and (levels[screen.pinCSS] == 0)) ? " slave" : "");
+                }
+                else
+                {
+                    if (runBytes == 0)
+                    {
+                        runTime = time;
+                    }
+                    runBytes += repeat;
+                }
+
+                for (uint8_t index = 0; index < 2; index += 1)
+                {
+                    uint32_t pinSelect = (index == 0) ? screen.pinCS : screen.pinCSS;
+                    if ((pinSelect == NOT_CONNECTED) or (levels[pinSelect] != 0))
+                    {
+                        continue;
+                    }
+
+                    controller_s & controller = controllers[index];
+                    if (flagCommand)
+                    {
+                        closeCommand(controller, secondFrame);
+                        controller.command = data;
+                        controller.commands += repeat;
+                    }
+                    else
+                    {
+                        for (uint32_t i = 0; i < repeat; i += 1)
+                        {
+                            addByte(controller.data, data);
+                        }
+                        controller.bytes += repeat;
+                    }
+                }
+                break;
+            }
+
+            case 'H':
+            case 'L':
+
+                levels[pin & 0xff] = (kind == 'H') ? 1 : 0;
+                if ((pin != screen.pinDC) and (pin != screen.pinCS) and (pin != screen.pinCSS))
+                {
+                    printf("%10.3f ms  %s %s\n", milliseconds, pinName(screen, pin), (kind == 'H') ? "HIGH" : "LOW");
+                }
+                break;
+
+            case 'D':
+
+                printf("%10.3f ms  delay %u ms\n", milliseconds, value);
+                totalDelay += value * 1000UL;
+                break;
+
+            case 'U':
+
+                totalDelay += value;
+                break;
+
+            case 'W':
+
+                timeWait = time;
+                break;
+
+            case 'R':
+
+                printf("%10.3f ms  %s %s after %.3f ms\n", milliseconds, pinName(screen, pin), value ? "HIGH" : "LOW", (time - timeWait) / 1000.0);
+                totalWait += time - timeWait;
+                break;
+
+            default:
+
+                break;
+        }
+    }
+    fclose(file);
+
+    if (runBytes > 0)
+    {
+        printf("%10.3f ms  data %lu bytes\n", (runTime - timeFirst) / 1000.0, runBytes);
+    }
+
+    if ((flagScreen == false) or (flagTrace == false))
+    {
+        fprintf(stderr, "No trace in %s\n", argv[1]);
+        return 2;
+    }
+
+    closeCommand(controllers[0], secondFrame);
+    closeCommand(controllers[1], secondFrame);
+
+    printf("\n");
+    printf("Screen %ux%u, family %u, film %c\n", screen.sizeH, screen.sizeV, screen.family, screen.film);
+    printf("Events %lu of %lu, dropped %lu\n", count, events, dropped);
+    printf("Duration %.3f ms, BUSY %.3f ms, delays %.3f ms\n", (timeLast - timeFirst) / 1000.0, totalWait / 1000.0, totalDelay / 1000.0);
+    printf("Master %u commands, %u data bytes\n", controllers[0].commands, controllers[0].bytes);
+    if (screen.pinCSS != NOT_CONNECTED)
+    {
+        printf("Slave %u commands, %u data bytes\n", controllers[1].commands, controllers[1].bytes);
+    }
+
+    int result = (dropped == 0) ? 0 : 1;
+
+    if (argc == 3)
+    {
+        uint32_t pageColourSize = screen.sizeV * screen.sizeH / 8;
+        uint32_t halves = (screen.family == FAMILY_LARGE) ? 2 : 1;
+        uint32_t frameSize = pageColourSize / halves;
+
+        uint8_t * black = (uint8_t *)calloc(pageColourSize, 1);
+        uint8_t * red = (uint8_t *)calloc(pageColourSize, 1);
+        if ((black == NULL) or (red == NULL))
+        {
+            fprintf(stderr, "Out of memory\n");
+            return 2;
+        }
+
+        for (uint32_t half = 0; half < halves; half += 1)
+        {
+            const controller_s & controller = controllers[half];
+            if ((controller.first.size != frameSize) or (controller.second.size != frameSize))
+            {
+                printf("Incomplete frames for the %s, %u and %u bytes, %u expected\n", (half == 0) ? "master" : "slave", controller.first.size, controller.second.size, frameSize);
+                result = 1;
+            }
+            if (controller.first.size > 0)
+            {
+                memcpy(black + half * frameSize, controller.first.data, (controller.first.size < frameSize) ? controller.first.size : frameSize);
+            }
+            if (controller.second.size > 0)
+            {
+                memcpy(red + half * frameSize, controller.second.data, (controller.second.size < frameSize) ? controller.second.size : frameSize);
+            }
+        }
+
+        if (writeImage(argv[2], screen, black, red) == false)
+        {
+            return 2;
+        }
+        free(black);
+        free(red);
+    }
+
+    return result;
+}
@@ -0,0 +1,192 @@
+//
+// Cache_EPD_EXT3.cpp
+// Library C++ code
+// ----------------------------------
+//
+// Project Pervasive Displays Library Suite
+// Based on highView technology
+//
+// Created by Rei Vilo, 21 Feb 2025
+//
+// Copyright (c) Rei Vilo, 2010-2025
+// Licence Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+// For exclusive use with Pervasive Displays screens
+// Portions (c) Pervasive Displays, 2010-2025
+//
+// Release 821: Added page cache with backing store
+// Release 821: Slot size from getFrameSize(), store left to the caller
+//
+
+// Library header
+#include "Cache_EPD_EXT3.h"
+
+Cache_EPD_EXT3::Cache_EPD_EXT3(Screen_EPD_EXT3 & screen, hV_Store & store)
+    : k_screen(screen), k_store(store)
+{
+    k_keys = nullptr;
+    k_uses = nullptr;
+    k_clock = 0;
+    k_slots = 0;
+    resetStatistics();
+}
+
+Cache_EPD_EXT3::~Cache_EPD_EXT3()
+{
+    end();
+}
+
+uint8_t Cache_EPD_EXT3::begin()
+{
+    end();
+
+    // Black and red planes, as the frame-buffer
+    if (k_store.begin(k_screen.getFrameSize()) == RESULT_ERROR)
+    {
+        return RESULT_ERROR;
+    }
+
+    uint16_t slots = k_store.slots();
+    k_keys = new uint32_t[slots];
+    k_uses = new uint32_t[slots];
+    if ((k_keys == nullptr) or (k_uses == nullptr))
+    {
+        mySerial.println(formatString("hV * Cache %i pages not allocated", slots));
+        end();
+        return RESULT_ERROR;
+    }
+
+    k_slots = slots;
+    clear();
+    resetStatistics();
+    return RESULT_SUCCESS;
+}
+
+void Cache_EPD_EXT3::end()
+{
+    if (k_keys != nullptr)
+    {
+        delete[] k_keys;
+        k_keys = nullptr;
+    }
+    if (k_uses != nullptr)
+    {
+        delete[] k_uses;
+        k_uses = nullptr;
+    }
+    k_slots = 0;
+}
+
+uint16_t Cache_EPD_EXT3::k_find(uint32_t key)
+{
+    for (uint16_t slot = 0; slot < k_slots; slot += 1)
+    {
+        if ((k_uses[slot] > 0) and (k_keys[slot] == key))
+        {
+            return slot;
+        }
+    }
+    return k_slots;
+}
+
+uint8_t Cache_EPD_EXT3::flushCached(uint32_t key)
+{
+    uint16_t slot = k_find(key);
+    if (slot == k_slots)
+    {
+        k_statistics.misses += 1;
+        return RESULT_ERROR;
+    }
+
+    k_statistics.hits += 1;
+    k_clock += 1;
+    k_uses[slot] = k_clock;
+    return k_screen.flushFromStore(k_store, slot);
+}
+
+uint8_t Cache_EPD_EXT3::save(uint32_t key)
+{
+    if (k_slots == 0)
+    {
+        return RESULT_ERROR;
+    }
+
+    // Same key, otherwise free slot, otherwise least recently used
+    uint16_t slot = k_find(key);
+    if (slot == k_slots)
+    {
+        slot = 0;
+        for (uint16_t index = 1; index < k_slots; index += 1)
+        {
+            if (k_uses[index] < k_uses[slot])
+            {
+                slot = index;
+            }
+        }
+
+        if (k_uses[slot] > 0)
+        {
+            k_statistics.evictions += 1;
+        }
+    }
+
+    if (k_screen.storeFrame(k_store, slot) == RESULT_ERROR)
+    {
+        k_uses[slot] = 0;
+        return RESULT_ERROR;
+    }
+
+    k_statistics.saves += 1;
+    k_clock += 1;
+    k_keys[slot] = key;
+    k_uses[slot] = k_clock;
+    return RESULT_SUCCESS;
+}
+
+bool Cache_EPD_EXT3::contains(uint32_t key)
+{
+    return (k_find(key) < k_slots);
+}
+
+void Cache_EPD_EXT3::invalidate(uint32_t key)
+{
+    uint16_t slot = k_find(key);
+    if (slot < k_slots)
+    {
+        k_uses[slot] = 0;
+    }
+}
+
+void Cache_EPD_EXT3::clear()
+{
+    for (uint16_t slot = 0; slot < k_slots; slot += 1)
+    {
+        k_uses[slot] = 0;
+    }
+    k_clock = 0;
+}
+
+uint16_t Cache_EPD_EXT3::pages()
+{
+    uint16_t count = 0;
+    for (uint16_t slot = 0; slot < k_slots; slot += 1)
+    {
+        if (k_uses[slot] > 0)
+        {
+            count += 1;
+        }
+    }
+    return count;
+}
+
+cacheStatistics_s Cache_EPD_EXT3::getStatistics()
+{
+    return k_statistics;
+}
+
+void Cache_EPD_EXT3::resetStatistics()
+{
+    k_statistics.hits = 0;
+    k_statistics.misses = 0;
+    k_statistics.saves = 0;
+    k_statistics.evictions = 0;
+}
@@ -0,0 +1,181 @@
+///
+/// @file Cache_EPD_EXT3.h
+/// @brief Page cache with backing store
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @n @b B-SML-G
+/// * Edition: Basic
+/// * Family: Small, Medium, Large
+/// * Update: Global
+/// * Feature: none
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright All rights reserved
+/// @copyright For exclusive use with Pervasive Displays screens
+/// @copyright Portions (c) Pervasive Displays, 2010-2025
+///
+/// * Basic edition: for hobbyists and for basic usage
+/// @n Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @see https://creativecommons.org/licenses/by-sa/4.0/
+///
+/// @n Consider the Evaluation or Commercial editions for professionals or organisations and for commercial usage
+///
+/// * Evaluation edition: for professionals or organisations, evaluation only, no commercial usage
+/// @n All rights reserved
+///
+/// * Commercial edition: for professionals or organisations, commercial usage
+/// @n All rights reserved
+///
+/// * Viewer edition: for professionals or organisations
+/// @n All rights reserved
+///
+/// * Documentation
+/// @n All rights reserved
+///
+
+// Screen
+#include "Screen_EPD_EXT3.h"
+
+// Checks
+#if (SCREEN_EPD_EXT3_RELEASE < 821)
+#error Required SCREEN_EPD_EXT3_RELEASE 821
+#endif // SCREEN_EPD_EXT3_RELEASE
+
+#ifndef CACHE_EPD_EXT3_RELEASE
+///
+/// @brief Library release number
+///
+#define CACHE_EPD_EXT3_RELEASE 821
+
+///
+/// @brief Statistics of the cache
+///
+struct cacheStatistics_s
+{
+    uint32_t hits; ///< pages found and displayed
+    uint32_t misses; ///< pages not found
+    uint32_t saves; ///< pages saved
+    uint32_t evictions; ///< pages removed to save another one
+};
+
+///
+/// @brief Page cache
+/// @details Rendered frames kept in a backing store, one page per slot, with a key per page
+/// @n The key is an identifier or a hash of the content, see hashFNV().
+/// When the store is full, the least recently used page is replaced.
+/// @note Typical use
+/// @code
+/// if (myCache.flushCached(key) == RESULT_ERROR)
+/// {
+///     drawPage();
+///     myScreen.flush();
+///     myCache.save(key);
+/// }
+/// @endcode
+/// @note A hit updates the display from the store, without rendering.
+/// The frame-buffer is not modified, so it no longer matches the display.
+///
+class Cache_EPD_EXT3
+{
+  public:
+    ///
+    /// @brief Constructor
+    /// @param screen screen to display on
+    /// @param store backing store, for example hV_Store_RAM
+    ///
+    Cache_EPD_EXT3(Screen_EPD_EXT3 & screen, hV_Store & store);
+
+    ///
+    /// @brief Destructor
+    ///
+    ~Cache_EPD_EXT3();
+
+    ///
+    /// @brief Initialise the cache and the store
+    /// @return RESULT_SUCCESS or RESULT_ERROR
+    /// @note The slot size is the size of the frame-buffer of the screen, already started.
+    ///
+    uint8_t begin();
+
+    ///
+    /// @brief Release the cache
+    /// @note The store is left to the caller, for example to call its end().
+    ///
+    void end();
+
+    ///
+    /// @brief Update the display with a cached page
+    /// @param key key of the page
+    /// @return RESULT_SUCCESS if the page is cached and displayed, RESULT_ERROR otherwise
+    ///
+    uint8_t flushCached(uint32_t key);
+
+    ///
+    /// @brief Save the frame-buffer as a page
+    /// @param key key of the page
+    /// @return RESULT_SUCCESS or RESULT_ERROR
+    /// @note A page with the same key is replaced.
+    /// Otherwise a free slot is used, or the least recently used page is evicted.
+    ///
+    uint8_t save(uint32_t key);
+
+    ///
+    /// @brief Check whether a page is cached
+    /// @param key key of the page
+    /// @return true if cached
+    /// @note Statistics and usage are not updated.
+    ///
+    bool contains(uint32_t key);
+
+    ///
+    /// @brief Remove a page
+    /// @param key key of the page
+    ///
+    void invalidate(uint32_t key);
+
+    ///
+    /// @brief Remove all the pages
+    ///
+    void clear();
+
+    ///
+    /// @brief Number of pages
+    /// @return number of cached pages
+    ///
+    uint16_t pages();
+
+    ///
+    /// @brief Statistics
+    /// @return hits, misses, saves and evictions since begin() or resetStatistics()
+    ///
+    cacheStatistics_s getStatistics();
+
+    ///
+    /// @brief Reset the statistics
+    ///
+    void resetStatistics();
+
+  protected:
+    /// @cond
+
+    // Slot of a key, k_slots if not found
+    uint16_t k_find(uint32_t key);
+
+    Screen_EPD_EXT3 & k_screen;
+    hV_Store & k_store;
+    uint32_t * k_keys;
+    uint32_t * k_uses; // last use, 0 = free slot
+    uint32_t k_clock;
+    uint16_t k_slots;
+    cacheStatistics_s k_statistics;
+
+    /// @endcond
+};
+
+#endif // CACHE_EPD_EXT3_RELEASE
@@ -0,0 +1,305 @@
+//
+// Console_EPD_EXT3.cpp
+// Library C++ code
+// ----------------------------------
+//
+// Project Pervasive Displays Library Suite
+// Based on highView technology
+//
+// Created by Rei Vilo, 21 Feb 2025
+//
+// Copyright (c) Rei Vilo, 2010-2025
+// Licence Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+// For exclusive use with Pervasive Displays screens
+// Portions (c) Pervasive Displays, 2010-2025
+//
+// Release 821: Added scrolling console with Print functions
+// Release 821: Region cleared with a solid rectangle, drawn in normal mode
+//
+
+// Library header
+#include "Console_EPD_EXT3.h"
+
+Console_EPD_EXT3::Console_EPD_EXT3(Screen_EPD_EXT3 & screen)
+    : c_screen(screen)
+{
+    c_grid = nullptr;
+    c_x0 = 0;
+    c_y0 = 0;
+    c_columns = 0;
+    c_rows = 0;
+    c_sizeX = 0;
+    c_sizeY = 0;
+    c_column = 0;
+    c_row = 0;
+    c_textColour = myColours.black;
+    c_backColour = myColours.white;
+    c_font = 0;
+    c_orientation = 0;
+    c_flagNewLine = false;
+}
+
+Console_EPD_EXT3::~Console_EPD_EXT3()
+{
+    end();
+}
+
+uint8_t Console_EPD_EXT3::begin(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy, uint8_t font)
+{
+    end();
+
+    c_orientation = c_screen.getOrientation();
+    c_oldFont = c_screen.getFont();
+    c_screen.selectFont(font);
+    c_font = c_screen.getFont();
+    c_sizeX = c_screen.characterSizeX();
+    c_sizeY = c_screen.characterSizeY();
+    c_screen.selectFont(c_oldFont);
+
+    // Region clipped to the screen
+    uint16_t sizeX = c_screen.screenSizeX();
+    uint16_t sizeY = c_screen.screenSizeY();
+    if ((x0 >= sizeX) or (y0 >= sizeY))
+    {
+        mySerial.println(formatString("hV * Console %i.%i out of screen", x0, y0));
+        return RESULT_ERROR;
+    }
+    dx = hV_HAL_min(dx, (uint16_t)(sizeX - x0));
+    dy = hV_HAL_min(dy, (uint16_t)(sizeY - y0));
+
+    c_x0 = x0;
+    c_y0 = y0;
+    c_columns = dx / c_sizeX;
+    c_rows = dy / c_sizeY;
+
+    if ((c_columns == 0) or (c_rows == 0))
+    {
+        mySerial.println(formatString("hV * Console %ix%i too small for font %i", dx, dy, c_font));
+        return RESULT_ERROR;
+    }
+
+    c_grid = new char[c_columns * c_rows];
+    if (c_grid == nullptr)
+    {
+        mySerial.println(formatString("hV * Console %ix%i not allocated", c_columns, c_rows));
+        c_columns = 0;
+        c_rows = 0;
+        return RESULT_ERROR;
+    }
+
+    clear();
+    return RESULT_SUCCESS;
+}
+
+void Console_EPD_EXT3::end()
+{
+    if (c_grid != nullptr)
+    {
+        delete[] c_grid;
+        c_grid = nullptr;
+    }
+    c_columns = 0;
+    c_rows = 0;
+}
+
+void Console_EPD_EXT3::setColours(uint16_t textColour, uint16_t backColour)
+{
+    c_textColour = textColour;
+    c_backColour = backColour;
+}
+
+void Console_EPD_EXT3::clear()
+{
+    if (c_grid == nullptr)
+    {
+        return;
+    }
+
+    memset(c_grid, ' ', c_columns * c_rows);
+    c_column = 0;
+    c_row = 0;
+    c_flagNewLine = false;
+
+    c_select();
+    c_fill();
+    c_restore();
+}
+
+void Console_EPD_EXT3::redraw()
+{
+    if (c_grid == nullptr)
+    {
+        return;
+    }
+
+    c_select();
+    c_fill();
+    for (uint16_t row = 0; row < c_rows; row += 1)
+    {
+        for (uint16_t column = 0; column < c_columns; column += 1)
+        {
+            // Spaces already drawn by c_fill()
+            if (c_grid[row * c_columns + column] != ' ')
+            {
+                c_drawCell(column, row);
+            }
+        }
+    }
+    c_restore();
+}
+
+void Console_EPD_EXT3::setCursor(uint16_t column, uint16_t row)
+{
+    c_column = hV_HAL_min(column, (uint16_t)(c_columns - 1));
+    c_row = hV_HAL_min(row, (uint16_t)(c_rows - 1));
+    c_flagNewLine = false;
+}
+
+uint16_t Console_EPD_EXT3::columns()
+{
+    return c_columns;
+}
+
+uint16_t Console_EPD_EXT3::rows()
+{
+    return c_rows;
+}
+
+size_t Console_EPD_EXT3::write(uint8_t character)
+{
+    if (c_grid == nullptr)
+    {
+        return 0;
+    }
+
+    c_select();
+    c_put(character);
+    c_restore();
+    return 1;
+}
+
+size_t Console_EPD_EXT3::write(const uint8_t * buffer, size_t size)
+{
+    if (c_grid == nullptr)
+    {
+        return 0;
+    }
+
+    c_select();
+    for (size_t index = 0; index < size; index += 1)
+    {
+        c_put(buffer[index]);
+    }
+    c_restore();
+    return size;
+}
+
+void Console_EPD_EXT3::flush()
+{
+    c_screen.flush();
+}
+
+void Console_EPD_EXT3::c_select()
+{
+    c_oldFont = c_screen.getFont();
+    c_oldOrientation = c_screen.getOrientation();
+    c_oldFontSolid = c_screen.getFontSolid();
+    c_oldDrawMode = c_screen.getDrawMode();
+
+    c_screen.selectFont(c_font);
+    c_screen.setFontSolid(true);
+    c_screen.setDrawMode(DRAW_MODE_NORMAL);
+    if (c_oldOrientation != c_orientation)
+    {
+        c_screen.setOrientation(c_orientation);
+    }
+}
+
+void Console_EPD_EXT3::c_restore()
+{
+    c_screen.selectFont(c_oldFont);
+    c_screen.setFontSolid(c_oldFontSolid);
+    c_screen.setDrawMode(c_oldDrawMode);
+    if (c_oldOrientation != c_orientation)
+    {
+        c_screen.setOrientation(c_oldOrientation);
+    }
+}
+
+void Console_EPD_EXT3::c_put(uint8_t character)
+{
+    if (character == '\n')
+    {
+        c_column = 0;
+        if (c_row + 1 < c_rows)
+        {
+            c_row += 1;
+        }
+        else
+        {
+            // Scroll delayed until the next character
+            c_flagNewLine = true;
+        }
+    }
+    else if (character == '\r')
+    {
+        c_column = 0;
+    }
+    else if (character == '\f')
+    {
+        memset(c_grid, ' ', c_columns * c_rows);
+        c_column = 0;
+        c_row = 0;
+        c_flagNewLine = false;
+        c_fill();
+    }
+    else if (character >= ' ')
+    {
+        if (c_flagNewLine)
+        {
+            c_newLine();
+            c_flagNewLine = false;
+        }
+
+        // Wrap at the end of the line
+        if (c_column >= c_columns)
+        {
+            c_column = 0;
+            if (c_row + 1 < c_rows)
+            {
+                c_row += 1;
+            }
+            else
+            {
+                c_newLine();
+            }
+        }
+
+        c_grid[c_row * c_columns + c_column] = character;
+        c_drawCell(c_column, c_row);
+        c_column += 1;
+    }
+}
+
+void Console_EPD_EXT3::c_drawCell(uint16_t column, uint16_t row)
+{
+    c_screen.gText(c_x0 + column * c_sizeX, c_y0 + row * c_sizeY, c_grid + row * c_columns + column, 1, c_textColour, c_backColour);
+}
+
+void Console_EPD_EXT3::c_newLine()
+{
+    // Pixels moved up by one line, last line filled with background colour
+    c_screen.scrollArea(c_x0, c_y0, c_x0 + c_columns * c_sizeX - 1, c_y0 + c_rows * c_sizeY - 1, 0, -(int16_t)c_sizeY, c_backColour);
+
+    memmove(c_grid, c_grid + c_columns, (c_rows - 1) * c_columns);
+    memset(c_grid + (c_rows - 1) * c_columns, ' ', c_columns);
+}
+
+void Console_EPD_EXT3::c_fill()
+{
+    // Solid rectangle, normal mode set by c_select()
+    bool oldPenSolid = c_screen.getPenSolid();
+    c_screen.setPenSolid(true);
+    c_screen.dRectangle(c_x0, c_y0, c_columns * c_sizeX, c_rows * c_sizeY, c_backColour);
+    c_screen.setPenSolid(oldPenSolid);
+}
@@ -0,0 +1,194 @@
+///
+/// @file Console_EPD_EXT3.h
+/// @brief Scrolling console on top of the Terminal fonts
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @n @b B-SML-G
+/// * Edition: Basic
+/// * Family: Small, Medium, Large
+/// * Update: Global
+/// * Feature: none
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright All rights reserved
+/// @copyright For exclusive use with Pervasive Displays screens
+/// @copyright Portions (c) Pervasive Displays, 2010-2025
+///
+/// * Basic edition: for hobbyists and for basic usage
+/// @n Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @see https://creativecommons.org/licenses/by-sa/4.0/
+///
+/// @n Consider the Evaluation or Commercial editions for professionals or organisations and for commercial usage
+///
+/// * Evaluation edition: for professionals or organisations, evaluation only, no commercial usage
+/// @n All rights reserved
+///
+/// * Commercial edition: for professionals or organisations, commercial usage
+/// @n All rights reserved
+///
+/// * Viewer edition: for professionals or organisations
+/// @n All rights reserved
+///
+/// * Documentation
+/// @n All rights reserved
+///
+
+// Screen
+#include "Screen_EPD_EXT3.h"
+
+// Checks
+#if (SCREEN_EPD_EXT3_RELEASE < 821)
+#error Required SCREEN_EPD_EXT3_RELEASE 821
+#endif // SCREEN_EPD_EXT3_RELEASE
+
+#ifndef CONSOLE_EPD_EXT3_RELEASE
+///
+/// @brief Library release number
+///
+#define CONSOLE_EPD_EXT3_RELEASE 821
+
+///
+/// @brief Scrolling console
+/// @details Grid of characters in a region of the screen, with Print functions
+/// @note Each character is rendered once, when written.
+/// A new line at the bottom moves the region up by one line with scrollArea().
+/// @note The region and the font are set by begin().
+/// The orientation is the one of the screen when begin() is called.
+/// Both are restored after each write, so the screen remains available for other drawings.
+/// @note Not to be used while recording, as scrollArea() is not recorded.
+///
+class Console_EPD_EXT3 : public Print
+{
+  public:
+    ///
+    /// @brief Constructor
+    /// @param screen screen to write on
+    ///
+    Console_EPD_EXT3(Screen_EPD_EXT3 & screen);
+
+    ///
+    /// @brief Destructor
+    ///
+    ~Console_EPD_EXT3();
+
+    ///
+    /// @brief Initialise the console
+    /// @param x0 top left coordinate, x-axis
+    /// @param y0 top left coordinate, y-axis
+    /// @param dx width of the region, pixels
+    /// @param dy height of the region, pixels
+    /// @param font font number, default = 0
+    /// @return RESULT_SUCCESS or RESULT_ERROR
+    /// @note The region is reduced to a whole number of characters.
+    /// @note The grid is allocated on the heap and released by end().
+    ///
+    uint8_t begin(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy, uint8_t font = 0);
+
+    ///
+    /// @brief Release the console
+    ///
+    void end();
+
+    ///
+    /// @brief Set the colours
+    /// @param textColour colour for the characters, default = black
+    /// @param backColour colour for the background, default = white
+    /// @note Applies to the next characters; use redraw() for the whole console
+    ///
+    void setColours(uint16_t textColour = myColours.black, uint16_t backColour = myColours.white);
+
+    ///
+    /// @brief Clear the console and move the cursor to the top left corner
+    ///
+    void clear();
+
+    ///
+    /// @brief Draw again the whole console from the grid of characters
+    /// @note For example, after the region has been overwritten
+    ///
+    void redraw();
+
+    ///
+    /// @brief Move the cursor
+    /// @param column column, 0..columns()-1
+    /// @param row row, 0..rows()-1
+    ///
+    void setCursor(uint16_t column, uint16_t row);
+
+    ///
+    /// @brief Number of columns
+    /// @return number of characters per line
+    ///
+    uint16_t columns();
+
+    ///
+    /// @brief Number of rows
+    /// @return number of lines
+    ///
+    uint16_t rows();
+
+    ///
+    /// @brief Write one character
+    /// @param character character to write
+    /// @return 1 if written, 0 otherwise
+    /// @note \\n moves to the next line, \\r to the beginning of the line and \\f clears the console.
+    /// Other control characters are ignored.
+    /// @note The new line at the bottom of the console is delayed until the next character,
+    /// so println() does not leave an empty last line.
+    ///
+    size_t write(uint8_t character);
+
+    ///
+    /// @brief Write a buffer of characters
+    /// @param buffer characters to write
+    /// @param size number of characters
+    /// @return number of characters written
+    /// @note Font and orientation selected once for the whole buffer
+    ///
+    size_t write(const uint8_t * buffer, size_t size);
+
+    using Print::write;
+
+    ///
+    /// @brief Update the display
+    /// @note Calls flush() of the screen
+    ///
+    void flush();
+
+  protected:
+    /// @cond
+
+    // Font and orientation of the console
+    void c_select();
+    void c_restore();
+
+    // Characters
+    void c_put(uint8_t character);
+    void c_drawCell(uint16_t column, uint16_t row);
+    void c_newLine();
+    void c_fill();
+
+    Screen_EPD_EXT3 & c_screen;
+    char * c_grid;
+    uint16_t c_x0, c_y0;
+    uint16_t c_columns, c_rows;
+    uint16_t c_sizeX, c_sizeY;
+    uint16_t c_column, c_row;
+    uint16_t c_textColour, c_backColour;
+    uint8_t c_font, c_orientation;
+    bool c_flagNewLine;
+
+    // Saved screen settings
+    uint8_t c_oldFont, c_oldOrientation, c_oldDrawMode;
+    bool c_oldFontSolid;
+
+    /// @endcond
+};
+
+#endif // CONSOLE_EPD_EXT3_RELEASE
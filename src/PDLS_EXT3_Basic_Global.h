@@ -44,6 +44,8 @@
 #define PDLS_EXT3_BASIC_RELEASE 812
 
 #include "Screen_EPD_EXT3.h"
+#include "Console_EPD_EXT3.h"
+#include "Cache_EPD_EXT3.h"
 
 #endif // PDLS_EXT3_BASIC_RELEASE
 
@@ -34,6 +34,29 @@
 // Release 804: Improved power management
 // Release 805: Improved stability
 // Release 806: New library for Wide temperature only
+// Release 821: Added bands and shared frame-buffer for parallel rendering
+// Release 821: Added word-wide pattern fills for clear() and areas
+// Release 821: Added region raster operations and drawing modes, s_getPoint()
+// Release 821: Recorded drawing mode and invertArea()
+// Release 821: Recorded drawBitmap()
+// Release 821: Added drawBitmap() for 1-bpp and black-white-red bitmaps
+// Release 821: Added flushFromReader() and flushFromStream() without frame-buffer
+// Release 821: Added flushFromCompressed() and compressFrame()
+// Release 821: Added exportImage() to PBM and PPM
+// Release 821: Added flushFromStore() and storeFrame()
+// Release 821: Added frame-buffer storage selection and end()
+// Release 821: Added interleaved frame-buffer layout
+// Release 821: Added tile cache in front of the frame-buffer
+// Release 821: Areas filled in the tile cache for the cached rows
+// Release 821: Read OTP with 3-wire SPI block read
+// Release 821: Added SPI clock profiles and calibratePanelClock()
+// Release 821: Panel resumed at each step of calibratePanelClock()
+// Release 821: Added exportTrace(), COG delays recorded by the trace recorder
+// Release 821: Added estimateFlushTime() with learned BUSY time
+// Release 821: Added keep-warm power mode, bus suspend and power statistics
+// Release 821: Content-preserving regenerate() with constant frames
+// Release 821: Added flushSolid() without frame-buffer
+// Release 821: SCREEN_EPD_EXT3_RELEASE 821, added getDrawMode() and getFrameSize()
 //
 
 // Library header
@@ -97,7 +120,7 @@ void Screen_EPD_EXT3::COG_LargeCJ_getDataOTP()
             digitalWrite(b_pin.panelDC, LOW); // Command
             digitalWrite(b_pin.panelCS, LOW); // Select
             hV_HAL_SPI3_write(0xb9);
-            delay(5);
+            hV_HAL_delayMilliseconds(5);
             break;
 
         case DRIVER_8:
@@ -129,7 +152,7 @@ void Screen_EPD_EXT3::COG_LargeCJ_getDataOTP()
             digitalWrite(b_pin.panelDC, LOW); // Command
             digitalWrite(b_pin.panelCS, LOW); // Select
             hV_HAL_SPI3_write(0xa8);
-            delay(5);
+            hV_HAL_delayMilliseconds(5);
             break;
 
         default:
@@ -145,10 +168,7 @@ void Screen_EPD_EXT3::COG_LargeCJ_getDataOTP()
     // hV_HAL_log(LEVEL_DEBUG, "Dummy read 0x%02x", ui8);
 
     // Populate COG_data
-    for (uint16_t index = 0; index < _readBytes; index += 1)
-    {
-        COG_data[index] = hV_HAL_SPI3_read(); // Read OTP
-    }
+    hV_HAL_SPI3_readBlock(COG_data, _readBytes); // Read OTP
 
     // End of OTP reading
     digitalWrite(b_pin.panelCS, HIGH); // Unselect
@@ -195,11 +215,10 @@ void Screen_EPD_EXT3::COG_LargeCJ_sendImageData()
     // 9.69 and 11.98 combine two half-screens, hence two frames with adjusted (u_pageColourSize >> 1) size
     uint32_t u_subPageColourSize = (u_pageColourSize >> 1);
 
-    FRAMEBUFFER_TYPE blackBuffer = s_newImage;
-    FRAMEBUFFER_TYPE redBuffer = s_newImage + u_pageColourSize;
-
     // Application note § 4. Input image to the EPD
     // Application note § 3.2 Send image to the EPD
+    // Frames from the frame-buffer, the reader or the stream, see s_sendFrame()
+    // Master then slave, each with first frame then second frame
     if (u_codeDriver == DRIVER_B)
     {
         // Send image data
@@ -208,7 +227,7 @@ void Screen_EPD_EXT3::COG_LargeCJ_sendImageData()
 
         // Master
         b_sendIndexDataSelect(0x12, &COG_data[0x12], 3, PANEL_CS_MASTER); // RAM_RW
-        b_sendIndexDataSelect(0x10, blackBuffer, u_subPageColourSize, PANEL_CS_MASTER); // First frame
+        s_sendFrame(0x10, 0, u_subPageColourSize, PANEL_CS_MASTER); // First frame
 
         b_sendIndexDataSelect(0x12, &COG_data[0x12], 3, PANEL_CS_MASTER); // RAM_RW
 
@@ -221,13 +240,13 @@ void Screen_EPD_EXT3::COG_LargeCJ_sendImageData()
 
             default:
 
-                b_sendIndexDataSelect(0x11, redBuffer, u_subPageColourSize, PANEL_CS_MASTER); // Second frame
+                s_sendFrame(0x11, u_pageColourSize, u_subPageColourSize, PANEL_CS_MASTER); // Second frame
                 break;
         }
 
         // Slave
         b_sendIndexDataSelect(0x12, &COG_data[0x12], 3, PANEL_CS_SLAVE); // RAM_RW
-        b_sendIndexDataSelect(0x10, blackBuffer + u_subPageColourSize, u_subPageColourSize, PANEL_CS_SLAVE); // First frame
+        s_sendFrame(0x10, u_subPageColourSize, u_subPageColourSize, PANEL_CS_SLAVE); // First frame
 
         b_sendIndexDataSelect(0x12, &COG_data[0x12], 3, PANEL_CS_SLAVE); // RAM_RW
 
@@ -240,7 +259,7 @@ void Screen_EPD_EXT3::COG_LargeCJ_sendImageData()
 
             default:
 
-                b_sendIndexDataSelect(0x11, redBuffer + u_subPageColourSize, u_subPageColourSize, PANEL_CS_SLAVE); // Second frame
+                s_sendFrame(0x11, u_pageColourSize + u_subPageColourSize, u_subPageColourSize, PANEL_CS_SLAVE); // Second frame
                 break;
         }
     }
@@ -252,7 +271,7 @@ void Screen_EPD_EXT3::COG_LargeCJ_sendImageData()
 
         // Master
         b_sendIndexDataSelect(0x12, &COG_data[0x13], 3, PANEL_CS_MASTER); // RAM_RW
-        b_sendIndexDataSelect(0x10, blackBuffer, u_subPageColourSize, PANEL_CS_MASTER); // First frame
+        s_sendFrame(0x10, 0, u_subPageColourSize, PANEL_CS_MASTER); // First frame
 
         b_sendIndexDataSelect(0x12, &COG_data[0x13], 3, PANEL_CS_MASTER); // RAM_RW
 
@@ -265,13 +284,13 @@ void Screen_EPD_EXT3::COG_LargeCJ_sendImageData()
 
             default:
 
-                b_sendIndexDataSelect(0x11, redBuffer, u_subPageColourSize, PANEL_CS_MASTER); // Second frame
+                s_sendFrame(0x11, u_pageColourSize, u_subPageColourSize, PANEL_CS_MASTER); // Second frame
                 break;
         }
 
         // Slave
         b_sendIndexDataSelect(0x12, &COG_data[0x13], 3, PANEL_CS_SLAVE); // RAM_RW
-        b_sendIndexDataSelect(0x10, blackBuffer + u_subPageColourSize, u_subPageColourSize, PANEL_CS_SLAVE); // First frame
+        s_sendFrame(0x10, u_subPageColourSize, u_subPageColourSize, PANEL_CS_SLAVE); // First frame
 
         b_sendIndexDataSelect(0x12, &COG_data[0x13], 3, PANEL_CS_SLAVE); // RAM_RW
 
@@ -284,7 +303,7 @@ void Screen_EPD_EXT3::COG_LargeCJ_sendImageData()
 
             default:
 
-                b_sendIndexDataSelect(0x11, redBuffer + u_subPageColourSize, u_subPageColourSize, PANEL_CS_SLAVE); // Second frame
+                s_sendFrame(0x11, u_pageColourSize + u_subPageColourSize, u_subPageColourSize, PANEL_CS_SLAVE); // Second frame
                 break;
         }
     }
@@ -299,52 +318,52 @@ void Screen_EPD_EXT3::COG_LargeCJ_update()
     {
         // Initial COG
         b_sendCommandDataSelect8(0x05, 0x7d, PANEL_CS_BOTH);
-        delay(200);
+        hV_HAL_delayMilliseconds(200);
         b_sendCommandDataSelect8(0x05, 0x00, PANEL_CS_BOTH);
-        delay(10);
+        hV_HAL_delayMilliseconds(10);
 
         b_sendCommandDataSelect8(0xd8, COG_data[0x1c], PANEL_CS_BOTH); // MS_SYNC
         b_sendCommandDataSelect8(0xd6, COG_data[0x1d], PANEL_CS_BOTH); // BVSS
 
         b_sendCommandDataSelect8(0xa7, 0x10, PANEL_CS_BOTH);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandDataSelect8(0xa7, 0x00, PANEL_CS_BOTH);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         // Master
         b_sendCommandDataSelect8(0x44, 0x00, PANEL_CS_MASTER);
         b_sendCommandDataSelect8(0x45, 0x80, PANEL_CS_MASTER);
 
         b_sendCommandDataSelect8(0xa7, 0x10, PANEL_CS_MASTER);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandDataSelect8(0xa7, 0x00, PANEL_CS_MASTER);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         b_sendCommandDataSelect8(0x44, 0x06, PANEL_CS_MASTER);
         uint8_t indexTemperature = u_temperature * 2 + 0x50; // Temperature 0x82@25C
         b_sendCommandDataSelect8(0x45, indexTemperature, PANEL_CS_MASTER);
 
         b_sendCommandDataSelect8(0xa7, 0x10, PANEL_CS_MASTER);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandDataSelect8(0xa7, 0x00, PANEL_CS_MASTER);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         // SLAVE
         b_sendCommandDataSelect8(0x44, 0x00, PANEL_CS_SLAVE);
         b_sendCommandDataSelect8(0x45, 0x80, PANEL_CS_SLAVE);
 
         b_sendCommandDataSelect8(0xa7, 0x10, PANEL_CS_SLAVE);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandDataSelect8(0xa7, 0x00, PANEL_CS_SLAVE);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         b_sendCommandDataSelect8(0x44, 0x06, PANEL_CS_SLAVE);
         b_sendCommandDataSelect8(0x45, indexTemperature, PANEL_CS_SLAVE);
 
         b_sendCommandDataSelect8(0xa7, 0x10, PANEL_CS_SLAVE);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandDataSelect8(0xa7, 0x00, PANEL_CS_SLAVE);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         // After
         b_sendCommandDataSelect8(0x60, COG_data[0x0b], PANEL_CS_BOTH); // TCON
@@ -356,20 +375,20 @@ void Screen_EPD_EXT3::COG_LargeCJ_update()
     {
         // Initial COG
         b_sendCommandDataSelect8(0x05, 0x7d, PANEL_CS_BOTH);
-        delay(200);
+        hV_HAL_delayMilliseconds(200);
         b_sendCommandDataSelect8(0x05, 0x00, PANEL_CS_BOTH);
-        delay(10);
+        hV_HAL_delayMilliseconds(10);
 
         b_sendCommandDataSelect8(0xc2, 0x3f, PANEL_CS_BOTH);
-        delay(1);
+        hV_HAL_delayMilliseconds(1);
 
         b_sendCommandDataSelect8(0xd8, COG_data[0x1d], PANEL_CS_BOTH); // MS_SYNC
         b_sendCommandDataSelect8(0xd6, COG_data[0x1e], PANEL_CS_BOTH); // BVSS
 
         b_sendCommandDataSelect8(0xa7, 0x10, PANEL_CS_BOTH);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandDataSelect8(0xa7, 0x00, PANEL_CS_BOTH);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         uint8_t data03[2] = {0x00, COG_data[0x12]}; // OSC
         b_sendIndexDataSelect(0x03, data03, 2, PANEL_CS_BOTH); // OSC mtp_0x12
@@ -379,35 +398,35 @@ void Screen_EPD_EXT3::COG_LargeCJ_update()
         b_sendCommandDataSelect8(0x45, 0x80, PANEL_CS_MASTER);
 
         b_sendCommandDataSelect8(0xa7, 0x10, PANEL_CS_MASTER);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandDataSelect8(0xa7, 0x00, PANEL_CS_MASTER);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         b_sendCommandDataSelect8(0x44, 0x06, PANEL_CS_MASTER);
         uint8_t indexTemperature = u_temperature * 2 + 0x50; // Temperature 0x82@25C
         b_sendCommandDataSelect8(0x45, indexTemperature, PANEL_CS_MASTER);
 
         b_sendCommandDataSelect8(0xa7, 0x10, PANEL_CS_MASTER);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandDataSelect8(0xa7, 0x00, PANEL_CS_MASTER);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         // Slave
         b_sendCommandDataSelect8(0x44, 0x00, PANEL_CS_SLAVE);
         b_sendCommandDataSelect8(0x45, 0x80, PANEL_CS_SLAVE);
 
         b_sendCommandDataSelect8(0xa7, 0x10, PANEL_CS_SLAVE);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandDataSelect8(0xa7, 0x00, PANEL_CS_SLAVE);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         b_sendCommandDataSelect8(0x44, 0x06, PANEL_CS_SLAVE);
         b_sendCommandDataSelect8(0x45, indexTemperature, PANEL_CS_SLAVE);
 
         b_sendCommandDataSelect8(0xa7, 0x10, PANEL_CS_SLAVE);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandDataSelect8(0xa7, 0x00, PANEL_CS_SLAVE);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         // After
         b_sendCommandDataSelect8(0x60, COG_data[0x0b], PANEL_CS_BOTH); // TCON
@@ -466,11 +485,11 @@ void Screen_EPD_EXT3::COG_LargeCJ_update()
 
                 if (DELAY_SCALE > 0)
                 {
-                    delay(DELAY_VALUE); // ms
+                    hV_HAL_delayMilliseconds(DELAY_VALUE); // ms
                 }
                 else
                 {
-                    delayMicroseconds(10 * DELAY_VALUE); //10 us
+                    hV_HAL_delayMicroseconds(10 * DELAY_VALUE); //10 us
                 }
             }
         }
@@ -489,22 +508,22 @@ void Screen_EPD_EXT3::COG_LargeCJ_update()
 
                 if (DELAY_a_SCALE > 0)
                 {
-                    delay(DELAY_a_VALUE); // ms
+                    hV_HAL_delayMilliseconds(DELAY_a_VALUE); // ms
                 }
                 else
                 {
-                    delayMicroseconds(10 * DELAY_a_VALUE); // 10 us
+                    hV_HAL_delayMicroseconds(10 * DELAY_a_VALUE); // 10 us
                 }
 
                 b_sendCommandDataSelect8(0x09, BST_SW_b, PANEL_CS_BOTH);
 
                 if (DELAY_b_SCALE > 0)
                 {
-                    delay(DELAY_b_VALUE); // ms
+                    hV_HAL_delayMilliseconds(DELAY_b_VALUE); // ms
                 }
                 else
                 {
-                    delayMicroseconds(10 * DELAY_b_VALUE); // 10 us
+                    hV_HAL_delayMicroseconds(10 * DELAY_b_VALUE); // 10 us
                 }
             }
         }
@@ -532,10 +551,10 @@ void Screen_EPD_EXT3::COG_LargeCJ_powerOff()
         case eScreen_EPD_B98_GS_08:
 
             b_sendCommandDataSelect8(0x09, 0x7f, PANEL_CS_BOTH);
-            delay(20);
+            hV_HAL_delayMilliseconds(20);
             b_sendCommandDataSelect8(0x05, 0x7d, PANEL_CS_BOTH);
             b_sendCommandDataSelect8(0x09, 0x00, PANEL_CS_BOTH);
-            delay(200);
+            hV_HAL_delayMilliseconds(200);
             break;
 
         case eScreen_EPD_969_CS_0B:
@@ -545,7 +564,7 @@ void Screen_EPD_EXT3::COG_LargeCJ_powerOff()
             b_sendCommandDataSelect8(0x09, 0x7f, PANEL_CS_BOTH);
             b_sendCommandDataSelect8(0x05, 0x3d, PANEL_CS_BOTH);
             b_sendCommandDataSelect8(0x09, 0x7e, PANEL_CS_BOTH);
-            delay(15);
+            hV_HAL_delayMilliseconds(15);
             b_sendCommandDataSelect8(0x09, 0x00, PANEL_CS_BOTH);
             break;
 
@@ -554,7 +573,7 @@ void Screen_EPD_EXT3::COG_LargeCJ_powerOff()
             b_sendCommandDataSelect8(0x09, 0x7b, PANEL_CS_BOTH);
             b_sendCommandDataSelect8(0x05, 0x3d, PANEL_CS_BOTH);
             b_sendCommandDataSelect8(0x09, 0x7a, PANEL_CS_BOTH);
-            delay(15);
+            hV_HAL_delayMilliseconds(15);
             b_sendCommandDataSelect8(0x09, 0x00, PANEL_CS_BOTH);
             break;
 
@@ -563,6 +582,53 @@ void Screen_EPD_EXT3::COG_LargeCJ_powerOff()
             break;
     }
 }
+
+uint32_t Screen_EPD_EXT3::COG_LargeCJ_estimate(bool flagReset)
+{
+    // Delays of COG_LargeCJ_initial(), COG_LargeCJ_update() and COG_LargeCJ_powerOff(), in us
+    // One more COG_LargeCJ_reset() if resume() resets the panel
+    uint32_t result = flagReset ? 2 * 625000 : 625000;
+
+    // Initial COG and 5 steps of 2 * 100 ms
+    if (u_codeDriver == DRIVER_B)
+    {
+        result += 210000 + 1000000;
+    }
+    else if (u_codeDriver == DRIVER_8)
+    {
+        result += 211000 + 1000000;
+    }
+
+    // DC/DC Soft-start, b_select() 500 us per command
+    result += s_estimateSoftStart((u_codeDriver == DRIVER_B) ? 0x28 : 0x20, 500);
+
+    // DC-DC off
+    switch (u_eScreen_EPD)
+    {
+        case eScreen_EPD_969_CS_08:
+        case eScreen_EPD_969_JS_08:
+        case eScreen_EPD_B98_CS_08:
+        case eScreen_EPD_B98_FS_08:
+        case eScreen_EPD_B98_GS_08:
+
+            result += 220000;
+            break;
+
+        case eScreen_EPD_969_CS_0B:
+        case eScreen_EPD_969_JS_0B:
+        case eScreen_EPD_B98_JS_0B:
+        case eScreen_EPD_B98_CS_0B:
+
+            result += 15000;
+            break;
+
+        default:
+
+            break;
+    }
+
+    return result;
+}
 //
 // --- End of Large screens with C or J film
 //
@@ -601,7 +667,7 @@ void Screen_EPD_EXT3::COG_MediumCJ_getDataOTP()
             digitalWrite(b_pin.panelDC, LOW); // Command
             digitalWrite(b_pin.panelCS, LOW); // Select
             hV_HAL_SPI3_write(0xb9);
-            delay(5);
+            hV_HAL_delayMilliseconds(5);
             break;
 
         case DRIVER_8:
@@ -633,7 +699,7 @@ void Screen_EPD_EXT3::COG_MediumCJ_getDataOTP()
             digitalWrite(b_pin.panelDC, LOW); // Command
             digitalWrite(b_pin.panelCS, LOW); // Select
             hV_HAL_SPI3_write(0xa8);
-            delay(5);
+            hV_HAL_delayMilliseconds(5);
             break;
 
         default:
@@ -649,10 +715,7 @@ void Screen_EPD_EXT3::COG_MediumCJ_getDataOTP()
     // hV_HAL_log(LEVEL_DEBUG, "Dummy read 0x%02x", ui8);
 
     // Populate COG_data
-    for (uint16_t index = 0; index < _readBytes; index += 1)
-    {
-        COG_data[index] = hV_HAL_SPI3_read(); // Read OTP
-    }
+    hV_HAL_SPI3_readBlock(COG_data, _readBytes); // Read OTP
 
     // End of OTP reading
     digitalWrite(b_pin.panelCS, HIGH); // Unselect
@@ -700,16 +763,14 @@ void Screen_EPD_EXT3::COG_MediumCJ_sendImageData()
 {
     // Application note § 4. Input image to the EPD
     // Application note § 3.2 Send image to the EPD
-    FRAMEBUFFER_TYPE blackBuffer = s_newImage;
-    FRAMEBUFFER_TYPE redBuffer = s_newImage + u_pageColourSize;
-
+    // Frames from the frame-buffer, the reader or the stream, see s_sendFrame()
     if (u_codeDriver == DRIVER_B)
     {
         // Send image data
         b_sendIndexData(0x13, &COG_data[0x15], 6); // DUW
         b_sendIndexData(0x90, &COG_data[0x0c], 4); // DRFW
         b_sendIndexData(0x12, &COG_data[0x12], 3); // RAM_RW
-        b_sendIndexData(0x10, blackBuffer, u_pageColourSize); // First frame
+        s_sendFrame(0x10, 0, u_pageColourSize); // First frame
 
         b_sendIndexData(0x12, &COG_data[0x12], 3); // RAM_RW
 
@@ -722,7 +783,7 @@ void Screen_EPD_EXT3::COG_MediumCJ_sendImageData()
 
             default:
 
-                b_sendIndexData(0x11, redBuffer, u_pageColourSize); // Second frame
+                s_sendFrame(0x11, u_pageColourSize, u_pageColourSize); // Second frame
                 break;
         }
     }
@@ -732,7 +793,7 @@ void Screen_EPD_EXT3::COG_MediumCJ_sendImageData()
         b_sendIndexData(0x13, &COG_data[0x16], 6); // DUW
         b_sendIndexData(0x90, &COG_data[0x0c], 4); // DRFW
         b_sendIndexData(0x12, &COG_data[0x13], 3); // RAM_RW
-        b_sendIndexData(0x10, blackBuffer, u_pageColourSize); // First frame
+        s_sendFrame(0x10, 0, u_pageColourSize); // First frame
 
         b_sendIndexData(0x12, &COG_data[0x13], 3); // RAM_RW
 
@@ -745,7 +806,7 @@ void Screen_EPD_EXT3::COG_MediumCJ_sendImageData()
 
             default:
 
-                b_sendIndexData(0x11, redBuffer, u_pageColourSize); // Second frame
+                s_sendFrame(0x11, u_pageColourSize, u_pageColourSize); // Second frame
                 break;
         }
     }
@@ -760,33 +821,33 @@ void Screen_EPD_EXT3::COG_MediumCJ_update()
     {
         // Initial COG
         b_sendCommandData8(0x05, 0x7d);
-        delay(200);
+        hV_HAL_delayMilliseconds(200);
         b_sendCommandData8(0x05, 0x00);
-        delay(10);
+        hV_HAL_delayMilliseconds(10);
         b_sendCommandData8(0xd8, COG_data[0x1c]); // MS_SYNC
         b_sendCommandData8(0xd6, COG_data[0x1d]); // BVSS
 
         b_sendCommandData8(0xa7, 0x10);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandData8(0xa7, 0x00);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         b_sendCommandData8(0x44, 0x00);
         b_sendCommandData8(0x45, 0x80);
 
         b_sendCommandData8(0xa7, 0x10);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandData8(0xa7, 0x00);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         b_sendCommandData8(0x44, 0x06);
         uint8_t indexTemperature = u_temperature * 2 + 0x50;
         b_sendCommandData8(0x45, indexTemperature); // Temperature 0x82@25C
 
         b_sendCommandData8(0xa7, 0x10);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandData8(0xa7, 0x00);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         b_sendCommandData8(0x60, COG_data[0x0b]); // TCON
         b_sendCommandData8(0x61, COG_data[0x1b]); // STV_DIR
@@ -797,20 +858,20 @@ void Screen_EPD_EXT3::COG_MediumCJ_update()
     {
         // Initial COG
         b_sendCommandData8(0x05, 0x7d);
-        delay(200);
+        hV_HAL_delayMilliseconds(200);
         b_sendCommandData8(0x05, 0x00);
-        delay(10);
+        hV_HAL_delayMilliseconds(10);
 
         b_sendCommandData8(0xc2, 0x3f);
-        delay(1);
+        hV_HAL_delayMilliseconds(1);
 
         b_sendCommandData8(0xd8, COG_data[0x1d]); // MS_SYNC
         b_sendCommandData8(0xd6, COG_data[0x1e]); // BVSS
 
         b_sendCommandData8(0xa7, 0x10);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandData8(0xa7, 0x00);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         uint8_t data03[2] = {0x00, COG_data[0x12]}; // OSC
         b_sendIndexData(0x03, data03, 2); // OSC mtp_0x12
@@ -818,18 +879,18 @@ void Screen_EPD_EXT3::COG_MediumCJ_update()
         b_sendCommandData8(0x45, 0x80);
 
         b_sendCommandData8(0xa7, 0x10);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandData8(0xa7, 0x00);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         b_sendCommandData8(0x44, 0x06);
         uint8_t indexTemperature = u_temperature * 2 + 0x50;
         b_sendCommandData8(0x45, indexTemperature); // Temperature 0x82@25C
 
         b_sendCommandData8(0xa7, 0x10);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
         b_sendCommandData8(0xa7, 0x00);
-        delay(100);
+        hV_HAL_delayMilliseconds(100);
 
         b_sendCommandData8(0x60, COG_data[0x0b]); // TCON
         b_sendCommandData8(0x61, COG_data[0x1c]); // STV_DIR
@@ -888,11 +949,11 @@ void Screen_EPD_EXT3::COG_MediumCJ_update()
 
                 if (DELAY_SCALE > 0)
                 {
-                    delay(DELAY_VALUE); // ms
+                    hV_HAL_delayMilliseconds(DELAY_VALUE); // ms
                 }
                 else
                 {
-                    delayMicroseconds(10 * DELAY_VALUE); //10 us
+                    hV_HAL_delayMicroseconds(10 * DELAY_VALUE); //10 us
                 }
             }
         }
@@ -911,22 +972,22 @@ void Screen_EPD_EXT3::COG_MediumCJ_update()
 
                 if (DELAY_a_SCALE > 0)
                 {
-                    delay(DELAY_a_VALUE); // ms
+                    hV_HAL_delayMilliseconds(DELAY_a_VALUE); // ms
                 }
                 else
                 {
-                    delayMicroseconds(10 * DELAY_a_VALUE); // 10 us
+                    hV_HAL_delayMicroseconds(10 * DELAY_a_VALUE); // 10 us
                 }
 
                 b_sendCommandData8(0x09, BST_SW_b);
 
                 if (DELAY_b_SCALE > 0)
                 {
-                    delay(DELAY_b_VALUE); // ms
+                    hV_HAL_delayMilliseconds(DELAY_b_VALUE); // ms
                 }
                 else
                 {
-                    delayMicroseconds(10 * DELAY_b_VALUE); // 10 us
+                    hV_HAL_delayMicroseconds(10 * DELAY_b_VALUE); // 10 us
                 }
             }
         }
@@ -955,10 +1016,10 @@ void Screen_EPD_EXT3::COG_MediumCJ_powerOff()
         case eScreen_EPD_741_GS_08:
 
             b_sendCommandData8(0x09, 0x7f);
-            delay(20);
+            hV_HAL_delayMilliseconds(20);
             b_sendCommandData8(0x05, 0x7d);
             b_sendCommandData8(0x09, 0x00);
-            delay(200);
+            hV_HAL_delayMilliseconds(200);
             break;
 
         case eScreen_EPD_581_JS_0B:
@@ -968,7 +1029,7 @@ void Screen_EPD_EXT3::COG_MediumCJ_powerOff()
             b_sendCommandData8(0x09, 0x7f);
             b_sendCommandData8(0x05, 0x3d);
             b_sendCommandData8(0x09, 0x7e);
-            delay(15);
+            hV_HAL_delayMilliseconds(15);
             b_sendCommandData8(0x09, 0x00);
             break;
 
@@ -977,7 +1038,7 @@ void Screen_EPD_EXT3::COG_MediumCJ_powerOff()
             b_sendCommandData8(0x09, 0x7b);
             b_sendCommandData8(0x05, 0x3d);
             b_sendCommandData8(0x09, 0x7a);
-            delay(15);
+            hV_HAL_delayMilliseconds(15);
             b_sendCommandData8(0x09, 0x00);
             break;
 
@@ -986,6 +1047,53 @@ void Screen_EPD_EXT3::COG_MediumCJ_powerOff()
             break;
     }
 }
+
+uint32_t Screen_EPD_EXT3::COG_MediumCJ_estimate(bool flagReset)
+{
+    // Delays of COG_MediumCJ_initial(), COG_MediumCJ_update() and COG_MediumCJ_powerOff(), in us
+    // One more COG_MediumCJ_reset() if resume() resets the panel
+    uint32_t result = flagReset ? 2 * 475000 : 475000;
+
+    // Initial COG and 3 steps of 2 * 100 ms
+    if (u_codeDriver == DRIVER_B)
+    {
+        result += 210000 + 600000;
+    }
+    else if (u_codeDriver == DRIVER_8)
+    {
+        result += 211000 + 600000;
+    }
+
+    // DC/DC Soft-start
+    result += s_estimateSoftStart((u_codeDriver == DRIVER_B) ? 0x28 : 0x20, 0);
+
+    // DC-DC off
+    switch (u_eScreen_EPD)
+    {
+        case eScreen_EPD_565_JS_08:
+        case eScreen_EPD_581_FS_08:
+        case eScreen_EPD_741_CS_08:
+        case eScreen_EPD_741_FS_08:
+        case eScreen_EPD_741_GS_08:
+
+            result += 220000;
+            break;
+
+        case eScreen_EPD_581_JS_0B:
+        case eScreen_EPD_741_CS_0B:
+        case eScreen_EPD_741_JS_0B:
+        case eScreen_EPD_581_CS_0B:
+
+            result += 15000;
+            break;
+
+        default:
+
+            break;
+    }
+
+    return result;
+}
 //
 // --- End of Medium screens with C or J film
 //
@@ -1039,7 +1147,7 @@ void Screen_EPD_EXT3::COG_SmallCJ_initial()
     COG_SmallCJ_reset();
 
     b_sendCommandData8(0x00, 0x0e); // Soft-reset
-    delay(5);
+    hV_HAL_delayMilliseconds(5);
 
     // Temperature
     b_sendCommandData8(0xe5, u_temperature); // Input Temperature 0°C = 0x00, 22°C = 0x16, 25°C = 0x19
@@ -1051,22 +1159,21 @@ void Screen_EPD_EXT3::COG_SmallCJ_initial()
 void Screen_EPD_EXT3::COG_SmallCJ_sendImageData()
 {
     // Application note § 4. Input image to the EPD
-    FRAMEBUFFER_TYPE blackBuffer = s_newImage;
-    FRAMEBUFFER_TYPE redBuffer = s_newImage + u_pageColourSize;
+    // Frames from the frame-buffer, the reader or the stream, see s_sendFrame()
 
     // Send image data
     switch (u_codeFilm)
     {
         case FILM_C:
 
-            b_sendIndexData(0x10, blackBuffer, u_pageColourSize); // First frame
+            s_sendFrame(0x10, 0, u_pageColourSize); // First frame
             b_sendIndexFixed(0x13, 0x00, u_pageColourSize); // Second frame = dummy
             break;
 
         default:
 
-            b_sendIndexData(0x10, blackBuffer, u_pageColourSize); // First frame
-            b_sendIndexData(0x13, redBuffer, u_pageColourSize); // Second frame
+            s_sendFrame(0x10, 0, u_pageColourSize); // First frame
+            s_sendFrame(0x13, u_pageColourSize, u_pageColourSize); // Second frame
             break;
     }
 }
@@ -1082,7 +1189,7 @@ void Screen_EPD_EXT3::COG_SmallCJ_update()
     b_sendCommand8(0x04); // Power on
     b_waitBusy();
     b_sendCommand8(0x12); // Display Refresh
-    delay(5);
+    hV_HAL_delayMilliseconds(5);
     b_waitBusy();
 }
 
@@ -1094,6 +1201,18 @@ void Screen_EPD_EXT3::COG_SmallCJ_powerOff()
     b_sendCommand8(0x02); // Turn off DC/DC
     b_waitBusy();
 }
+
+uint32_t Screen_EPD_EXT3::COG_SmallCJ_estimate(bool flagReset)
+{
+    // Delays of COG_SmallCJ_initial(), COG_SmallCJ_update() and COG_SmallCJ_powerOff(), in us
+    // One more COG_SmallCJ_reset() if resume() resets the panel
+    uint32_t result = flagReset ? 2 * 30000 : 30000;
+
+    // Soft-reset and display refresh
+    result += 5000 + 5000;
+
+    return result;
+}
 //
 // --- End of Small screens with C or J film
 //
@@ -1111,6 +1230,44 @@ Screen_EPD_EXT3::Screen_EPD_EXT3(eScreen_EPD_t eScreen_EPD_EXT3, pins_t board)
     b_pin = board;
     s_newImage = 0; // nullptr
     COG_data[0] = 0;
+    u_bandStart = 0;
+    u_bandEnd = 0;
+    u_drawMode = DRAW_MODE_NORMAL;
+    u_frameReader = nullptr;
+    u_frameStream = nullptr;
+    u_frameDecoder = nullptr;
+    u_frameOffset = 0;
+    u_frameStore = nullptr;
+    u_frameSlot = 0;
+    u_frameFixed = false;
+    u_fixedBlack = 0x00;
+    u_fixedRed = 0x00;
+    u_frameResult = RESULT_SUCCESS;
+
+#if defined(BOARD_HAS_PSRAM) // ESP32 PSRAM specific case
+
+    u_frameStorage = FRAMEBUFFER_PSRAM;
+
+#else // default case
+
+    u_frameStorage = FRAMEBUFFER_INTERNAL;
+
+#endif // ESP32 BOARD_HAS_PSRAM
+
+    u_frameAllocated = FRAMEBUFFER_NONE;
+    u_frameBuffer = nullptr;
+    u_frameBufferSize = 0;
+    u_frameLayout = FRAMEBUFFER_LAYOUT_PLANAR;
+    u_planeStep = 1;
+    u_planeRed = 0;
+    u_tileNumber = 0;
+    u_tileCount = 0;
+    u_tileData = nullptr;
+    resetTileStatistics();
+    u_panelClock = 0;
+    resetFlushTime();
+    resetPowerStatistics();
+    u_powerIdleStart = 0;
 }
 
 void Screen_EPD_EXT3::begin()
@@ -1304,27 +1461,17 @@ void Screen_EPD_EXT3::begin()
     // Actually for 1 colour; BWR requires 2 pages.
     u_pageColourSize = (uint32_t)u_bufferSizeV * (uint32_t)u_bufferSizeH;
 
-#if defined(BOARD_HAS_PSRAM) // ESP32 PSRAM specific case
-
-    if (s_newImage == 0)
-    {
-        static uint8_t * _newFrameBuffer;
-        _newFrameBuffer = (uint8_t *) ps_malloc(u_pageColourSize * u_bufferDepth);
-        s_newImage = (uint8_t *) _newFrameBuffer;
-    }
-
-#else // default case
+    // Planar, black plane then red plane, or interleaved, black and red bytes
+    u_planeStep = (u_frameLayout == FRAMEBUFFER_LAYOUT_INTERLEAVED) ? 2 : 1;
+    u_planeRed = (u_frameLayout == FRAMEBUFFER_LAYOUT_INTERLEAVED) ? 1 : u_pageColourSize;
 
-    if (s_newImage == 0)
+    s_allocateFrameBuffer();
+    if (s_newImage != nullptr)
     {
-        static uint8_t * _newFrameBuffer;
-        _newFrameBuffer = new uint8_t[u_pageColourSize * u_bufferDepth];
-        s_newImage = (uint8_t *) _newFrameBuffer;
+        memset(s_newImage, 0x00, u_pageColourSize * u_bufferDepth);
     }
-
-#endif // ESP32 BOARD_HAS_PSRAM
-
-    memset(s_newImage, 0x00, u_pageColourSize * u_bufferDepth);
+    s_allocateTiles();
+    setBand();
 
     setTemperatureC(25); // 25 Celsius = 77 Fahrenheit
     b_fsmPowerScreen = FSM_OFF;
@@ -1361,170 +1508,339 @@ void Screen_EPD_EXT3::begin()
     //
 }
 
-STRING_TYPE Screen_EPD_EXT3::WhoAmI()
+void Screen_EPD_EXT3::beginShared(Screen_EPD_EXT3 & master)
 {
-    char work[64] = {0};
-    u_WhoAmI(work);
+    // Screen and frame-buffer from master, no GPIO and no bus
+    s_releaseFrameBuffer();
+    u_eScreen_EPD = master.u_eScreen_EPD;
+    u_codeSize = master.u_codeSize;
+    u_codeFilm = master.u_codeFilm;
+    u_codeDriver = master.u_codeDriver;
+    u_codeExtra = master.u_codeExtra;
+    v_screenColourBits = master.v_screenColourBits;
+    v_screenSizeV = master.v_screenSizeV;
+    v_screenSizeH = master.v_screenSizeH;
+    v_screenDiagonal = master.v_screenDiagonal;
+    u_bufferDepth = master.u_bufferDepth;
+    u_bufferSizeV = master.u_bufferSizeV;
+    u_bufferSizeH = master.u_bufferSizeH;
+    u_pageColourSize = master.u_pageColourSize;
+    u_frameLayout = master.u_frameLayout;
+    u_planeStep = master.u_planeStep;
+    u_planeRed = master.u_planeRed;
+    s_newImage = master.s_newImage;
+    u_invert = master.u_invert;
+    setBand();
 
-    return formatString("iTC %i.%02i\"%s", v_screenDiagonal / 100, v_screenDiagonal % 100, work);
-}
+    // Fonts
+    hV_Screen_Buffer::begin(); // Standard
 
-void Screen_EPD_EXT3::suspend(uint8_t suspendScope)
-{
-    if (((suspendScope & FSM_GPIO_MASK) == FSM_GPIO_MASK) and (b_pin.panelPower != NOT_CONNECTED))
+    if (f_fontMax() > 0)
     {
-        if ((b_fsmPowerScreen & FSM_GPIO_MASK) == FSM_GPIO_MASK)
-        {
-            b_suspend();
-        }
+        f_selectFont(0);
     }
+    f_fontSolid = false;
+
+    // Orientation
+    setOrientation(0);
+
+    v_penSolid = false;
 }
 
-void Screen_EPD_EXT3::resume()
+uint8_t Screen_EPD_EXT3::setFrameBuffer(uint8_t storage, uint8_t * buffer, uint32_t size)
 {
-    // Target   FSM_ON
-    // Source   FSM_OFF
-    //          FSM_SLEEP
-    if (b_fsmPowerScreen != FSM_ON)
+    if (s_newImage != nullptr)
     {
-        if ((b_fsmPowerScreen & FSM_GPIO_MASK) != FSM_GPIO_MASK)
-        {
-            b_resume(); // GPIO
-
-            s_reset(); // Reset
+        mySerial.println("hV * Frame-buffer already in use, call end() first");
+        return RESULT_ERROR;
+    }
 
-            b_fsmPowerScreen |= FSM_GPIO_MASK;
-        }
+    if (storage > FRAMEBUFFER_NONE)
+    {
+        mySerial.println(formatString("hV * Frame-buffer storage %i not supported", storage));
+        return RESULT_ERROR;
+    }
 
-        // Check type and get tables
-        if (u_flagOTP == false)
+    if (storage == FRAMEBUFFER_STATIC)
+    {
+        // Aligned for DMA and for word-wide fills
+        if ((buffer == nullptr) or (((uintptr_t)buffer & 0x03) != 0))
         {
-            s_getDataOTP(); // 3-wire SPI read OTP memory
-
-            s_reset(); // Reset
+            mySerial.println("hV * Frame-buffer not aligned on 4 bytes");
+            return RESULT_ERROR;
         }
-
-        // Start SPI, with unicity check
-        hV_HAL_SPI_begin(); // Standard 8 MHz
-        // hV_HAL_SPI_begin(16000000); // Fast 16 MHz, with unicity check
+        u_frameBuffer = buffer;
+        u_frameBufferSize = size;
     }
+
+    u_frameStorage = storage;
+    return RESULT_SUCCESS;
 }
 
-uint8_t Screen_EPD_EXT3::flushMode(uint8_t updateMode)
+uint8_t Screen_EPD_EXT3::setFrameLayout(uint8_t layout)
 {
-    updateMode = checkTemperatureMode(updateMode);
+    if (s_newImage != nullptr)
+    {
+        mySerial.println("hV * Frame-buffer already in use, call end() first");
+        return RESULT_ERROR;
+    }
 
-    switch (updateMode)
+    if (layout > FRAMEBUFFER_LAYOUT_INTERLEAVED)
     {
-        case UPDATE_FAST:
-        case UPDATE_GLOBAL:
+        mySerial.println(formatString("hV * Frame-buffer layout %i not supported", layout));
+        return RESULT_ERROR;
+    }
 
-            s_flush();
-            break;
+    u_frameLayout = layout;
+    return RESULT_SUCCESS;
+}
 
-        default:
+uint8_t Screen_EPD_EXT3::setTileCache(uint8_t tiles)
+{
+    if (s_newImage != nullptr)
+    {
+        mySerial.println("hV * Frame-buffer already in use, call end() first");
+        return RESULT_ERROR;
+    }
 
-            mySerial.println();
-            mySerial.println("hV * UPDATE_NONE invoked");
-            break;
+    if (tiles > TILE_CACHE_MAX)
+    {
+        mySerial.println(formatString("hV * Tile cache limited to %i tiles", TILE_CACHE_MAX));
+        return RESULT_ERROR;
     }
 
-    return updateMode;
+    u_tileNumber = tiles;
+    return RESULT_SUCCESS;
 }
 
-void Screen_EPD_EXT3::s_reset()
+tileStatistics_s Screen_EPD_EXT3::getTileStatistics()
 {
-    switch (b_family)
-    {
-        case FAMILY_LARGE:
+    return u_tileStatistics;
+}
 
-            COG_LargeCJ_reset();
-            break;
+void Screen_EPD_EXT3::resetTileStatistics()
+{
+    u_tileStatistics.hits = 0;
+    u_tileStatistics.misses = 0;
+    u_tileStatistics.writeBacks = 0;
+}
 
-        case FAMILY_MEDIUM:
+///
+/// @brief SPI clock profile
+///
+struct clockProfile_s
+{
+    uint8_t family; ///< FAMILY_SMALL, FAMILY_MEDIUM or FAMILY_LARGE
+    uint8_t driver; ///< DRIVER_*, 0 = any
+    uint32_t clock; ///< in Hz
+};
+
+///
+/// @brief SPI clock profiles, first match
+/// @note Raise a clock only after calibratePanelClock() on several panels and boards
+///
+static const clockProfile_s clockProfiles[] =
+{
+    {FAMILY_SMALL, 0, 8000000},
+    {FAMILY_MEDIUM, 0, 8000000},
+    {FAMILY_LARGE, 0, 8000000},
+};
 
-            COG_MediumCJ_reset();
-            break;
+///
+/// @brief Clocks tried by calibratePanelClock(), rising, in Hz
+///
+static const uint32_t clockSteps[] = {4000000, 8000000, 10000000, 12000000, 16000000, 20000000, 24000000};
 
-        case FAMILY_SMALL:
+void Screen_EPD_EXT3::setPanelClock(uint32_t clock)
+{
+    u_panelClock = clock;
 
-            COG_SmallCJ_reset();
-            break;
+    // Restarted by resume() with the new clock
+    hV_HAL_SPI_end();
+    b_fsmPowerScreen &= ~FSM_BUS_MASK;
+}
 
-        default:
+uint32_t Screen_EPD_EXT3::getPanelClock()
+{
+    if (u_panelClock > 0)
+    {
+        return u_panelClock;
+    }
 
-            break;
+    for (uint8_t index = 0; index < sizeof(clockProfiles) / sizeof(clockProfiles[0]); index += 1)
+    {
+        if ((clockProfiles[index].family == b_family) and ((clockProfiles[index].driver == 0) or (clockProfiles[index].driver == u_codeDriver)))
+        {
+            return clockProfiles[index].clock;
+        }
     }
+    return PANEL_CLOCK_DEFAULT;
 }
 
-void Screen_EPD_EXT3::s_getDataOTP()
+uint32_t Screen_EPD_EXT3::calibratePanelClock(clockCheck_t check)
 {
-    hV_HAL_SPI_end(); // With unicity check
+    if (s_newImage == nullptr)
+    {
+        mySerial.println("hV * No frame-buffer");
+        return 0;
+    }
 
-    hV_HAL_SPI3_begin(); // Define 3-wire SPI pins
+    // No clock passes without a check
+    if (check == nullptr)
+    {
+        mySerial.println("hV * No check for calibration");
+        return 0;
+    }
 
-    // Get data OTP
-    switch (b_family)
+    s_syncTiles();
+
+    uint32_t clockSaved = u_panelClock;
+    uint32_t clockStable = 0;
+    uint32_t size = u_pageColourSize * 2; // Both frames
+
+    for (uint8_t step = 0; step < sizeof(clockSteps) / sizeof(clockSteps[0]); step += 1)
     {
-        case FAMILY_LARGE:
+        // Clock also used by flush() in check()
+        // SPI restarted by resume(), which also powers the panel again if check() suspended it
+        setPanelClock(clockSteps[step]);
+        resume();
 
-            COG_LargeCJ_getDataOTP();
-            break;
+        uint32_t chrono = 0;
+        switch (b_family)
+        {
+            case FAMILY_LARGE:
 
-        case FAMILY_MEDIUM:
+                COG_LargeCJ_initial();
+                chrono = micros();
+                COG_LargeCJ_sendImageData();
+                break;
 
-            COG_MediumCJ_getDataOTP();
-            break;
+            case FAMILY_MEDIUM:
 
-        case FAMILY_SMALL:
+                COG_MediumCJ_initial();
+                chrono = micros();
+                COG_MediumCJ_sendImageData();
+                break;
 
-            COG_SmallCJ_getDataOTP();
-            break;
+            case FAMILY_SMALL:
 
-        default:
+                COG_SmallCJ_initial();
+                chrono = micros();
+                COG_SmallCJ_sendImageData();
+                break;
+
+            default:
+
+                chrono = micros();
+                break;
+        }
+        chrono = hV_HAL_max(micros() - chrono, (uint32_t)1);
 
+        bool flagPassed = check(u_panelClock);
+        mySerial.println(formatString("hV . Clock %8i Hz, %6i bytes in %7i us, %5i kB/s, %s", u_panelClock, size, chrono, (uint32_t)((uint64_t)size * 1000 / chrono), flagPassed ? "passed" : "failed"));
+
+        if (flagPassed == false)
+        {
             break;
+        }
+        clockStable = u_panelClock;
     }
-}
 
-void Screen_EPD_EXT3::s_flush(uint8_t updateMode)
-{
-    // Resume
-    if (b_fsmPowerScreen != FSM_ON)
+    // Clock of the panel restored, SPI restarted by the next resume() or flush()
+    setPanelClock(clockSaved);
+    if (u_suspendMode == POWER_MODE_AUTO)
     {
-        resume();
+        suspend(u_suspendScope);
     }
 
-    // Three groups:
-    // + small: up to 4.37 included
-    // + medium: 3.43, 5.65, 5.81 and 7.41
-    // + large: 9.69 and 11,98
-    // switch..case does not allow variable declarations
-    //
-    switch (b_family)
-    {
-        case FAMILY_LARGE:
+    mySerial.println(formatString("hV . Highest stable clock %i Hz", clockStable));
+    return clockStable;
+}
 
-            COG_LargeCJ_initial(); // Initialise
-            COG_LargeCJ_sendImageData(); // Send image data
-            COG_LargeCJ_update(); // Update
-            COG_LargeCJ_powerOff(); // Power off
-            break;
+///
+/// @brief Delay of the DC/DC soft-start, as in COG_*_update()
+/// @param value DELAY byte from OTP, bit 7 set for ms, otherwise 10 us
+/// @return delay in us
+///
+static uint32_t softStartDelay(uint8_t value)
+{
+    return ((value & 0x80) > 0) ? (value & 0x7f) * 1000 : (value & 0x7f) * 10;
+}
 
-        case FAMILY_MEDIUM:
+uint32_t Screen_EPD_EXT3::s_estimateSoftStart(uint8_t offsetFrame, uint32_t commandTime)
+{
+    uint32_t result = 0;
 
-            COG_MediumCJ_initial(); // Initialise
-            COG_MediumCJ_sendImageData(); // Send image data
-            COG_MediumCJ_update(); // Update
-            COG_MediumCJ_powerOff(); // Power off
+    for (uint8_t stage = 0; stage < 4; stage += 1)
+    {
+        uint8_t offset = offsetFrame + 0x08 * stage;
+        uint8_t FORMAT = COG_data[offset] & 0x80;
+        uint8_t REPEAT = COG_data[offset] & 0x7f;
+
+        if (FORMAT > 0) // Format 1, three commands and one delay
+        {
+            result += REPEAT * (3 * commandTime + softStartDelay(COG_data[offset + 7]));
+        }
+        else // Format 2, two commands and two delays
+        {
+            result += REPEAT * (2 * commandTime + softStartDelay(COG_data[offset + 3]) + softStartDelay(COG_data[offset + 4]));
+        }
+    }
+
+    return result;
+}
+
+uint8_t Screen_EPD_EXT3::s_getFlushBand()
+{
+    // 10 °C bands from -20 °C, extreme bands open
+    int16_t band = ((int16_t)u_temperature + 20) / 10;
+    if (u_temperature < -20)
+    {
+        band = 0;
+    }
+    return (uint8_t)hV_HAL_min(band, (int16_t)(FLUSH_TIME_BANDS - 1));
+}
+
+void Screen_EPD_EXT3::s_learnFlushTime(uint32_t duration)
+{
+    u_flushLast = duration;
+
+    // BUSY time, moving average over 4 updates, first update as is, 0 kept for none
+    uint8_t band = s_getFlushBand();
+    if (u_flushBusy[band] == 0)
+    {
+        u_flushBusy[band] = hV_HAL_max(b_busyTime, (uint32_t)1);
+    }
+    else
+    {
+        u_flushBusy[band] = hV_HAL_max((u_flushBusy[band] * 3 + b_busyTime) / 4, (uint32_t)1);
+    }
+
+    // Time per byte from the frame-buffer only,
+    // as constant frames are faster and the other sources possibly slower
+    bool flagSource = u_frameFixed or (u_frameReader != nullptr) or (u_frameStream != nullptr) or (u_frameDecoder != nullptr) or (u_frameStore != nullptr);
+    if (flagSource)
+    {
+        return;
+    }
+
+    // Time per byte on top of the SPI clock, from what is left after the delays and BUSY
+    uint32_t sequence = 0; // us
+    switch (b_family)
+    {
+        case FAMILY_LARGE:
+
+            sequence = COG_LargeCJ_estimate(false);
+            break;
+
+        case FAMILY_MEDIUM:
+
+            sequence = COG_MediumCJ_estimate(false);
             break;
 
         case FAMILY_SMALL:
 
-            COG_SmallCJ_initial(); // Initialise
-            COG_SmallCJ_sendImageData(); // Send image data
-            COG_SmallCJ_update(); // Update
-            COG_SmallCJ_powerOff(); // Power off
+            sequence = COG_SmallCJ_estimate(false);
             break;
 
         default:
@@ -1532,248 +1848,2435 @@ void Screen_EPD_EXT3::s_flush(uint8_t updateMode)
             break;
     }
 
-    // Turn SPI off and pull GPIOs low
-    suspend();
-}
+    uint32_t size = u_pageColourSize * 2; // Both frames
+    uint64_t rest = (uint64_t)duration * 1000;
+    rest = (rest > (uint64_t)b_busyTime * 1000 + sequence) ? rest - (uint64_t)b_busyTime * 1000 - sequence : 0;
+    uint32_t clockTime = (uint32_t)(8000000000ULL / getPanelClock()); // ns per byte
+    uint32_t byteTime = (uint32_t)(rest * 1000 / size);
+    byteTime = (byteTime > clockTime) ? byteTime - clockTime : 0;
 
-void Screen_EPD_EXT3::flush()
-{
-    flushMode(UPDATE_GLOBAL);
+    if (u_flushCount == 0)
+    {
+        u_flushByteTime = byteTime;
+    }
+    else
+    {
+        u_flushByteTime = (u_flushByteTime * 3 + byteTime) / 4;
+    }
+    u_flushCount += 1;
 }
 
-void Screen_EPD_EXT3::clear(uint16_t colour)
+uint32_t Screen_EPD_EXT3::estimateFlushTime(uint8_t updateMode)
 {
-    if (colour == myColours.red)
+    updateMode = checkTemperatureMode(updateMode);
+    if (updateMode == UPDATE_NONE)
     {
-        // physical red 0-1
-        memset(s_newImage, 0x00, u_pageColourSize);
-        memset(s_newImage + u_pageColourSize, 0xff, u_pageColourSize);
+        return 0;
     }
-    else if (colour == myColours.grey)
+
+    // Delays of the sequence, with reset by resume() if GPIOs are off
+    bool flagReset = ((b_fsmPowerScreen & FSM_GPIO_MASK) != FSM_GPIO_MASK);
+    uint64_t result = 0; // us
+    switch (b_family)
     {
-        for (uint16_t i = 0; i < u_bufferSizeV; i++)
-        {
-            uint8_t pattern = (i % 2) ? 0b10101010 : 0b01010101;
-            for (uint16_t j = 0; j < u_bufferSizeH; j++)
-            {
-                s_newImage[i * u_bufferSizeH + j] = pattern;
-            }
-        }
-        memset(s_newImage + u_pageColourSize, 0x00, u_pageColourSize);
+        case FAMILY_LARGE:
+
+            result = COG_LargeCJ_estimate(flagReset);
+            break;
+
+        case FAMILY_MEDIUM:
+
+            result = COG_MediumCJ_estimate(flagReset);
+            break;
+
+        case FAMILY_SMALL:
+
+            result = COG_SmallCJ_estimate(flagReset);
+            break;
+
+        default:
+
+            break;
     }
-    else if (colour == myColours.darkRed)
+
+    // Both frames, also sent to mono screens
+    uint32_t size = u_pageColourSize * 2;
+    uint32_t clockTime = (uint32_t)(8000000000ULL / getPanelClock()); // ns per byte
+    result += (uint64_t)size * (clockTime + u_flushByteTime) / 1000;
+
+    // BUSY time, from the band of the temperature or the nearest measured band, colder first
+    uint8_t band = s_getFlushBand();
+    uint32_t busy = 0;
+    for (uint8_t distance = 0; (busy == 0) and (distance < FLUSH_TIME_BANDS); distance += 1)
     {
-        // red = 0-1, black = 1-0, white 0-0
-        for (uint16_t i = 0; i < u_bufferSizeV; i++)
+        if ((band >= distance) and (u_flushBusy[band - distance] > 0))
         {
-            uint16_t pattern1 = (i % 2) ? 0b10101010 : 0b01010101; // black
-            uint16_t pattern2 = (i % 2) ? 0b01010101 : 0b10101010; // red
-            for (uint16_t j = 0; j < u_bufferSizeH; j++)
-            {
-                s_newImage[i * u_bufferSizeH + j] = pattern1;
-                s_newImage[i * u_bufferSizeH + j + u_pageColourSize] = pattern2;
-            }
+            busy = u_flushBusy[band - distance];
         }
-    }
-    else if (colour == myColours.lightRed)
-    {
-        // red = 0-1, black = 1-0, white 0-0
-        for (uint16_t i = 0; i < u_bufferSizeV; i++)
+        else if ((band + distance < FLUSH_TIME_BANDS) and (u_flushBusy[band + distance] > 0))
         {
-            uint16_t pattern1 = (i % 2) ? 0b00000000 : 0b00000000; // white
-            uint16_t pattern2 = (i % 2) ? 0b01010101 : 0b10101010; // red
-            for (uint16_t j = 0; j < u_bufferSizeH; j++)
-            {
-                s_newImage[i * u_bufferSizeH + j] = pattern1;
-                s_newImage[i * u_bufferSizeH + j + u_pageColourSize] = pattern2;
-            }
+            busy = u_flushBusy[band + distance];
         }
     }
-    else if ((colour == myColours.white) xor u_invert)
+
+    if (busy == 0)
     {
-        // physical black 0-0
-        memset(s_newImage, 0x00, u_pageColourSize);
-        memset(s_newImage + u_pageColourSize, 0x00, u_pageColourSize);
+        busy = ((u_codeFilm == FILM_C) or (u_codeFilm == FILM_H)) ? FLUSH_BUSY_MONO : FLUSH_BUSY_COLOUR;
     }
-    else
+    result += (uint64_t)busy * 1000;
+
+    return (uint32_t)((result + 500) / 1000);
+}
+
+uint32_t Screen_EPD_EXT3::getFlushTime()
+{
+    return u_flushLast;
+}
+
+void Screen_EPD_EXT3::resetFlushTime()
+{
+    for (uint8_t band = 0; band < FLUSH_TIME_BANDS; band += 1)
     {
-        // physical white 1-0
-        memset(s_newImage, 0xff, u_pageColourSize);
-        memset(s_newImage + u_pageColourSize, 0x00, u_pageColourSize);
+        u_flushBusy[band] = 0;
     }
+    u_flushByteTime = 0;
+    u_flushCount = 0;
+    u_flushLast = 0;
 }
 
-void Screen_EPD_EXT3::regenerate(uint8_t mode)
+void Screen_EPD_EXT3::s_allocateTiles()
 {
-    clear(myColours.black);
-    flush();
-    delay(100);
+    if ((u_tileCount > 0) or (u_tileNumber == 0) or (s_newImage == nullptr))
+    {
+        return;
+    }
 
-    clear(myColours.white);
-    flush();
-    delay(100);
+    // 8 native rows of both planes, internal RAM
+    u_tileRed = (uint32_t)u_bufferSizeH * 8;
+    u_tileSize = u_tileRed * u_bufferDepth;
+    u_tileData = new uint8_t[u_tileSize * u_tileNumber];
+    if (u_tileData == nullptr)
+    {
+        mySerial.println(formatString("hV * Tile cache %i bytes not allocated", u_tileSize * u_tileNumber));
+        return;
+    }
+
+    for (uint8_t tile = 0; tile < u_tileNumber; tile += 1)
+    {
+        u_tileFirst[tile] = 0xffff;
+        u_tileUses[tile] = 0;
+    }
+    u_tileDirty = 0;
+    u_tileLast = 0;
+    u_tileClock = 0;
+    u_tileCount = u_tileNumber;
+    resetTileStatistics();
 }
 
-void Screen_EPD_EXT3::s_setPoint(uint16_t x1, uint16_t y1, uint16_t colour)
+void Screen_EPD_EXT3::s_releaseTiles()
 {
-    // Orient and check coordinates are within screen
-    if (s_orientCoordinates(x1, y1) == RESULT_ERROR)
+    s_syncTiles();
+    if (u_tileData != nullptr)
     {
-        return;
+        delete[] u_tileData;
+        u_tileData = nullptr;
     }
+    u_tileCount = 0;
+}
 
-    // Convert combined colours into basic colours
-    bool flagOdd = ((x1 + y1) % 2 == 0);
+uint8_t Screen_EPD_EXT3::s_findTile(uint16_t row)
+{
+    uint16_t first = row & 0xfff8;
 
-    if (colour == myColours.darkRed)
+    // Last tile first, then the others
+    if (u_tileFirst[u_tileLast] == first)
     {
-        if (flagOdd)
-        {
-            colour = myColours.red; // red
-        }
-        else
-        {
-            colour = u_invert ? myColours.white : myColours.black; // white
-        }
+        return u_tileLast;
     }
-    else if (colour == myColours.lightRed)
+
+    uint8_t tile = 0;
+    while ((tile < u_tileCount) and (u_tileFirst[tile] != first))
     {
-        if (flagOdd)
-        {
-            colour = myColours.red; // red
-        }
-        else
-        {
-            colour = u_invert ? myColours.black : myColours.white; // black
-        }
+        tile += 1;
     }
-    else if (colour == myColours.grey)
+    return tile;
+}
+
+uint8_t * Screen_EPD_EXT3::s_getTile(uint16_t row, bool flagDirty)
+{
+    uint16_t first = row & 0xfff8;
+    uint8_t tile = u_tileLast;
+
+    // Last tile first, then the others
+    if (u_tileFirst[tile] != first)
     {
-        if (flagOdd)
+        tile = s_findTile(row);
+
+        if (tile == u_tileCount)
         {
-            colour = myColours.black; // black
+            // Free or least recently used tile, written back if dirty
+            tile = 0;
+            for (uint8_t index = 1; index < u_tileCount; index += 1)
+            {
+                if (u_tileUses[index] < u_tileUses[tile])
+                {
+                    tile = index;
+                }
+            }
+            s_writeTile(tile);
+
+            uint8_t * data = u_tileData + tile * u_tileSize;
+            uint16_t rows = hV_HAL_min((uint16_t)8, (uint16_t)(u_bufferSizeV - first));
+            for (uint16_t k = 0; k < rows; k += 1)
+            {
+                s_readRow(first + k, data + k * u_bufferSizeH, data + u_tileRed + k * u_bufferSizeH);
+            }
+            u_tileFirst[tile] = first;
+            u_tileStatistics.misses += 1;
         }
         else
         {
-            colour = myColours.white; // white
+            u_tileStatistics.hits += 1;
         }
+        u_tileLast = tile;
+    }
+    else
+    {
+        u_tileStatistics.hits += 1;
     }
 
-    // Coordinates
-    uint32_t z1 = s_getZ(x1, y1);
-    uint16_t b1 = s_getB(x1, y1);
-
-    // Basic colours
-    if (colour == myColours.red)
+    u_tileClock += 1;
+    u_tileUses[tile] = u_tileClock;
+    if (flagDirty)
     {
-        // physical red 0-1
-        bitClear(s_newImage[z1], b1);
-        bitSet(s_newImage[u_pageColourSize + z1], b1);
+        u_tileDirty |= ((uint32_t)1 << tile);
     }
-    else if ((colour == myColours.white) xor u_invert)
+    return u_tileData + tile * u_tileSize;
+}
+
+void Screen_EPD_EXT3::s_writeTile(uint8_t tile)
+{
+    if ((u_tileDirty & ((uint32_t)1 << tile)) == 0)
     {
-        // physical black 0-0
-        bitClear(s_newImage[z1], b1);
-        bitClear(s_newImage[u_pageColourSize + z1], b1);
+        return;
     }
-    else if ((colour == myColours.black) xor u_invert)
+
+    // Rows of the band only, as the band of another screen may share the tile
+    uint8_t * data = u_tileData + tile * u_tileSize;
+    uint16_t first = u_tileFirst[tile];
+    for (uint16_t k = 0; k < 8; k += 1)
     {
-        // physical white 1-0
-        bitSet(s_newImage[z1], b1);
-        bitClear(s_newImage[u_pageColourSize + z1], b1);
+        if ((first + k >= u_bandStart) and (first + k < u_bandEnd))
+        {
+            s_writeRow(first + k, data + k * u_bufferSizeH, data + u_tileRed + k * u_bufferSizeH);
+        }
     }
+    u_tileDirty &= ~((uint32_t)1 << tile);
+    u_tileStatistics.writeBacks += 1;
 }
 
-void Screen_EPD_EXT3::s_setOrientation(uint8_t orientation)
+void Screen_EPD_EXT3::s_syncTiles()
 {
-    v_orientation = orientation % 4;
+    for (uint8_t tile = 0; tile < u_tileCount; tile += 1)
+    {
+        s_writeTile(tile);
+        u_tileFirst[tile] = 0xffff;
+        u_tileUses[tile] = 0;
+    }
 }
 
-bool Screen_EPD_EXT3::s_orientCoordinates(uint16_t & x, uint16_t & y)
+void Screen_EPD_EXT3::s_allocateFrameBuffer()
 {
-    bool _flagResult = RESULT_ERROR;
-    switch (v_orientation)
+    // Already allocated, begin() called again
+    if (s_newImage != nullptr)
     {
-        case 3: // checked, previously 1
+        return;
+    }
 
-            if ((x < v_screenSizeV) and (y < v_screenSizeH))
-            {
-                x = v_screenSizeV - 1 - x;
-                _flagResult = RESULT_SUCCESS;
-            }
-            break;
+    uint32_t size = u_pageColourSize * u_bufferDepth;
 
-        case 2: // checked
+    switch (u_frameStorage)
+    {
+        case FRAMEBUFFER_NONE:
 
-            if ((x < v_screenSizeH) and (y < v_screenSizeV))
+            return;
+
+        case FRAMEBUFFER_STATIC:
+
+            if (u_frameBufferSize >= size)
             {
-                x = v_screenSizeH - 1 - x;
-                y = v_screenSizeV - 1 - y;
-                hV_HAL_swap(x, y);
-                _flagResult = RESULT_SUCCESS;
+                s_newImage = u_frameBuffer;
+                return;
             }
+            mySerial.println(formatString("hV * Frame-buffer %i bytes provided, %i required", u_frameBufferSize, size));
             break;
 
-        case 1: // checked, previously 3
+        case FRAMEBUFFER_PSRAM:
 
-            if ((x < v_screenSizeV) and (y < v_screenSizeH))
+#if defined(BOARD_HAS_PSRAM) // ESP32 PSRAM specific case
+
+            s_newImage = (uint8_t *) ps_malloc(size);
+            if (s_newImage != nullptr)
             {
-                y = v_screenSizeH - 1 - y;
-                _flagResult = RESULT_SUCCESS;
+                u_frameAllocated = FRAMEBUFFER_PSRAM;
+                return;
             }
+
+#endif // ESP32 BOARD_HAS_PSRAM
+
+            mySerial.println("hV * PSRAM not available");
             break;
 
-        default: // checked
+        default:
 
-            if ((x < v_screenSizeH) and (y < v_screenSizeV))
-            {
-                hV_HAL_swap(x, y);
-                _flagResult = RESULT_SUCCESS;
-            }
             break;
     }
 
-    return _flagResult;
+    // Internal RAM, default and fall-back
+    s_newImage = new uint8_t[size];
+    if (s_newImage == nullptr)
+    {
+        mySerial.println(formatString("hV * Frame-buffer %i bytes not allocated", size));
+        return;
+    }
+    u_frameAllocated = FRAMEBUFFER_INTERNAL;
 }
 
-uint32_t Screen_EPD_EXT3::s_getZ(uint16_t x1, uint16_t y1)
+void Screen_EPD_EXT3::s_releaseFrameBuffer()
 {
-    uint32_t z1 = 0;
-    // According to 11.98 inch Spectra Application Note
-    // at http://www.pervasivedisplays.com/LiteratureRetrieve.aspx?ID=245146
-    switch (u_codeSize)
-    {
-        case SIZE_969:
-        case SIZE_1198:
+    s_releaseTiles();
 
-            if (y1 >= (v_screenSizeH >> 1))
-            {
-                y1 -= (v_screenSizeH >> 1); // rebase y1
-                z1 += (u_pageColourSize >> 1); // buffer second half
-            }
-            z1 += (uint32_t)x1 * (u_bufferSizeH >> 1) + (y1 >> 3);
-            break;
+    if (u_frameAllocated == FRAMEBUFFER_INTERNAL)
+    {
+        delete[] s_newImage;
+    }
 
-        default:
+#if defined(BOARD_HAS_PSRAM) // ESP32 PSRAM specific case
 
-            z1 = (uint32_t)x1 * u_bufferSizeH + (y1 >> 3);
-            break;
+    else if (u_frameAllocated == FRAMEBUFFER_PSRAM)
+    {
+        free(s_newImage);
     }
-    return z1;
+
+#endif // ESP32 BOARD_HAS_PSRAM
+
+    u_frameAllocated = FRAMEBUFFER_NONE;
+    s_newImage = nullptr;
 }
 
-uint16_t Screen_EPD_EXT3::s_getB(uint16_t x1, uint16_t y1)
+void Screen_EPD_EXT3::end()
 {
-    uint16_t b1 = 0;
+    s_releaseFrameBuffer();
+    setBand();
+}
 
-    b1 = 7 - (y1 % 8);
+void Screen_EPD_EXT3::setBand(uint8_t index, uint8_t number)
+{
+    // Tiles written back within the previous band
+    s_syncTiles();
 
-    return b1;
+    // Empty band without frame-buffer, so nothing is drawn
+    if (s_newImage == nullptr)
+    {
+        u_bandStart = 0;
+        u_bandEnd = 0;
+        return;
+    }
+
+    if ((number == 0) or (index >= number))
+    {
+        index = 0;
+        number = 1;
+    }
+
+    u_bandStart = (uint32_t)u_bufferSizeV * index / number;
+    u_bandEnd = (uint32_t)u_bufferSizeV * (index + 1) / number;
+}
+
+STRING_TYPE Screen_EPD_EXT3::WhoAmI()
+{
+    char work[64] = {0};
+    u_WhoAmI(work);
+
+    return formatString("iTC %i.%02i\"%s", v_screenDiagonal / 100, v_screenDiagonal % 100, work);
+}
+
+void Screen_EPD_EXT3::suspend(uint8_t suspendScope)
+{
+    uint8_t fsmPowerScreen = b_fsmPowerScreen;
+
+    if (((suspendScope & FSM_GPIO_MASK) == FSM_GPIO_MASK) and (b_pin.panelPower != NOT_CONNECTED))
+    {
+        if ((b_fsmPowerScreen & FSM_GPIO_MASK) == FSM_GPIO_MASK)
+        {
+            s_countWarm();
+            b_suspend();
+        }
+    }
+
+    if ((suspendScope & FSM_BUS_MASK) == FSM_BUS_MASK)
+    {
+        if ((b_fsmPowerScreen & FSM_BUS_MASK) == FSM_BUS_MASK)
+        {
+            hV_HAL_SPI_end(); // With unicity check
+            b_fsmPowerScreen &= ~FSM_BUS_MASK;
+        }
+    }
+
+    if (b_fsmPowerScreen != fsmPowerScreen)
+    {
+        u_powerStatistics.suspends += 1;
+    }
+}
+
+void Screen_EPD_EXT3::resume()
+{
+    // Target   FSM_ON
+    // Source   FSM_OFF
+    //          FSM_SLEEP
+    if (b_fsmPowerScreen != FSM_ON)
+    {
+        uint32_t chrono = micros();
+
+        if ((b_fsmPowerScreen & FSM_GPIO_MASK) != FSM_GPIO_MASK)
+        {
+            b_resume(); // GPIO
+            u_powerWarmStart = millis();
+
+            s_reset(); // Reset
+
+            b_fsmPowerScreen |= FSM_GPIO_MASK;
+        }
+
+        // Check type and get tables
+        if (u_flagOTP == false)
+        {
+            s_getDataOTP(); // 3-wire SPI read OTP memory
+
+            s_reset(); // Reset
+        }
+
+        // Start SPI, with unicity check
+        hV_HAL_SPI_begin(getPanelClock()); // Profile or setPanelClock()
+        b_fsmPowerScreen |= FSM_BUS_MASK;
+
+        u_powerStatistics.latency = micros() - chrono;
+        u_powerStatistics.latencyTotal += u_powerStatistics.latency / 1000;
+        u_powerStatistics.resumes += 1;
+    }
+}
+
+bool Screen_EPD_EXT3::checkPowerIdle()
+{
+    if ((u_suspendMode != POWER_MODE_KEEP_WARM) or ((b_fsmPowerScreen & u_suspendScope) == 0))
+    {
+        return false;
+    }
+
+    if (millis() - u_powerIdleStart < u_suspendTimeout)
+    {
+        return false;
+    }
+
+    suspend(u_suspendScope);
+    return true;
+}
+
+void Screen_EPD_EXT3::s_countWarm()
+{
+    uint32_t chrono = millis();
+    u_powerStatistics.warmTime += chrono - u_powerWarmStart;
+    u_powerWarmStart = chrono;
+}
+
+powerStatistics_s Screen_EPD_EXT3::getPowerStatistics()
+{
+    if ((b_fsmPowerScreen & FSM_GPIO_MASK) == FSM_GPIO_MASK)
+    {
+        s_countWarm();
+    }
+
+    // uJ = ms * uA * mV / 1000000
+    u_powerStatistics.energy = (uint32_t)((uint64_t)u_powerStatistics.warmTime * POWER_WARM_CURRENT * POWER_VOLTAGE / 1000000);
+    return u_powerStatistics;
+}
+
+void Screen_EPD_EXT3::resetPowerStatistics()
+{
+    u_powerStatistics.resumes = 0;
+    u_powerStatistics.suspends = 0;
+    u_powerStatistics.latency = 0;
+    u_powerStatistics.latencyTotal = 0;
+    u_powerStatistics.warmTime = 0;
+    u_powerStatistics.energy = 0;
+    u_powerWarmStart = millis();
+}
+
+uint8_t Screen_EPD_EXT3::flushMode(uint8_t updateMode)
+{
+    // Without frame-buffer, only from the reader, the stream, the decoder, the store or constant frames
+    if ((s_newImage == nullptr) and (u_frameReader == nullptr) and (u_frameStream == nullptr) and (u_frameDecoder == nullptr) and (u_frameStore == nullptr) and (u_frameFixed == false))
+    {
+        mySerial.println("hV * No frame-buffer");
+        return UPDATE_NONE;
+    }
+
+    s_syncTiles();
+    updateMode = checkTemperatureMode(updateMode);
+
+    switch (updateMode)
+    {
+        case UPDATE_FAST:
+        case UPDATE_GLOBAL:
+
+            s_flush();
+            break;
+
+        default:
+
+            mySerial.println();
+            mySerial.println("hV * UPDATE_NONE invoked");
+            break;
+    }
+
+    return updateMode;
+}
+
+void Screen_EPD_EXT3::s_reset()
+{
+    switch (b_family)
+    {
+        case FAMILY_LARGE:
+
+            COG_LargeCJ_reset();
+            break;
+
+        case FAMILY_MEDIUM:
+
+            COG_MediumCJ_reset();
+            break;
+
+        case FAMILY_SMALL:
+
+            COG_SmallCJ_reset();
+            break;
+
+        default:
+
+            break;
+    }
+}
+
+void Screen_EPD_EXT3::s_getDataOTP()
+{
+    hV_HAL_SPI_end(); // With unicity check
+
+    hV_HAL_SPI3_begin(); // Define 3-wire SPI pins
+
+    // Get data OTP
+    switch (b_family)
+    {
+        case FAMILY_LARGE:
+
+            COG_LargeCJ_getDataOTP();
+            break;
+
+        case FAMILY_MEDIUM:
+
+            COG_MediumCJ_getDataOTP();
+            break;
+
+        case FAMILY_SMALL:
+
+            COG_SmallCJ_getDataOTP();
+            break;
+
+        default:
+
+            break;
+    }
+}
+
+void Screen_EPD_EXT3::s_flush(uint8_t updateMode)
+{
+    // Resume
+    if (b_fsmPowerScreen != FSM_ON)
+    {
+        resume();
+    }
+
+    // Measured for estimateFlushTime()
+    uint32_t chrono = millis();
+    b_busyTime = 0;
+
+    // Three groups:
+    // + small: up to 4.37 included
+    // + medium: 3.43, 5.65, 5.81 and 7.41
+    // + large: 9.69 and 11,98
+    // switch..case does not allow variable declarations
+    //
+    switch (b_family)
+    {
+        case FAMILY_LARGE:
+
+            COG_LargeCJ_initial(); // Initialise
+            COG_LargeCJ_sendImageData(); // Send image data
+            COG_LargeCJ_update(); // Update
+            COG_LargeCJ_powerOff(); // Power off
+            break;
+
+        case FAMILY_MEDIUM:
+
+            COG_MediumCJ_initial(); // Initialise
+            COG_MediumCJ_sendImageData(); // Send image data
+            COG_MediumCJ_update(); // Update
+            COG_MediumCJ_powerOff(); // Power off
+            break;
+
+        case FAMILY_SMALL:
+
+            COG_SmallCJ_initial(); // Initialise
+            COG_SmallCJ_sendImageData(); // Send image data
+            COG_SmallCJ_update(); // Update
+            COG_SmallCJ_powerOff(); // Power off
+            break;
+
+        default:
+
+            break;
+    }
+
+    s_learnFlushTime(millis() - chrono);
+
+    // Power profile
+    switch (u_suspendMode)
+    {
+        case POWER_MODE_AUTO:
+
+            // Turn SPI off and pull GPIOs low
+            suspend(u_suspendScope);
+            break;
+
+        case POWER_MODE_KEEP_WARM:
+
+            // Suspended by checkPowerIdle()
+            u_powerIdleStart = millis();
+            break;
+
+        default:
+
+            break;
+    }
+}
+
+void Screen_EPD_EXT3::s_sendFrame(uint8_t index, uint32_t offset, uint32_t size, uint8_t select)
+{
+    // Constant frames, first frame black plane, second frame red plane
+    if (u_frameFixed)
+    {
+        uint8_t data = (offset < u_pageColourSize) ? u_fixedBlack : u_fixedRed;
+        if (b_family == FAMILY_LARGE)
+        {
+            b_sendIndexFixedSelect(index, data, size, select);
+        }
+        else
+        {
+            b_sendIndexFixed(index, data, size);
+        }
+        return;
+    }
+
+    // From the planar frame-buffer
+    bool flagSource = (u_frameReader != nullptr) or (u_frameStream != nullptr) or (u_frameDecoder != nullptr) or (u_frameStore != nullptr);
+    if ((flagSource == false) and (u_planeStep == 1))
+    {
+        if (b_family == FAMILY_LARGE)
+        {
+            b_sendIndexDataSelect(index, s_newImage + offset, size, select);
+        }
+        else
+        {
+            b_sendIndexData(index, s_newImage + offset, size);
+        }
+        return;
+    }
+
+    // From the reader, the stream, the decoder, the store or the interleaved frame-buffer, in chunks
+    uint8_t chunk[STREAM_CHUNK_SIZE];
+
+    if (b_family == FAMILY_LARGE)
+    {
+        b_beginIndexDataSelect(index, select);
+    }
+    else
+    {
+        b_beginIndexData(index);
+    }
+
+    for (uint32_t done = 0; done < size; done += STREAM_CHUNK_SIZE)
+    {
+        uint32_t length = hV_HAL_min(size - done, (uint32_t)STREAM_CHUNK_SIZE);
+        s_readFrame(chunk, offset + done, length);
+        b_sendData(chunk, length);
+    }
+
+    if (b_family == FAMILY_LARGE)
+    {
+        b_endIndexDataSelect();
+    }
+    else
+    {
+        b_endIndexData();
+    }
+}
+
+void Screen_EPD_EXT3::s_readFrame(uint8_t * buffer, uint32_t offset, uint32_t size)
+{
+    uint32_t count = 0;
+
+    // No further waiting after a failed read
+    if (u_frameResult == RESULT_SUCCESS)
+    {
+        if (u_frameReader != nullptr)
+        {
+            count = u_frameReader(buffer, offset, size);
+        }
+        else if (u_frameDecoder != nullptr)
+        {
+            // 9.69 and 11.98 request the halves in panel order, so restart or skip as needed
+            if (offset < u_frameOffset)
+            {
+                frameDecodeBegin(*u_frameDecoder, u_frameDecoder->data, u_frameDecoder->size);
+                u_frameOffset = 0;
+            }
+
+            while (u_frameOffset < offset)
+            {
+                uint32_t length = hV_HAL_min(offset - u_frameOffset, size);
+                uint32_t skipped = frameDecode(*u_frameDecoder, buffer, length);
+                u_frameOffset += skipped;
+                if (skipped < length)
+                {
+                    break;
+                }
+            }
+
+            if (u_frameOffset == offset)
+            {
+                count = frameDecode(*u_frameDecoder, buffer, size);
+                u_frameOffset += count;
+            }
+        }
+        else if (u_frameStore != nullptr)
+        {
+            count = u_frameStore->read(u_frameSlot, offset, buffer, size);
+        }
+        else if (u_frameStream != nullptr)
+        {
+            count = u_frameStream->readBytes(buffer, size);
+        }
+        else
+        {
+            // Interleaved frame-buffer
+            s_readPlanes(buffer, offset, size);
+            count = size;
+        }
+    }
+
+    if (count < size)
+    {
+        memset(buffer + count, 0x00, size - count);
+        u_frameResult = RESULT_ERROR;
+    }
+}
+
+void Screen_EPD_EXT3::s_readPlanes(uint8_t * buffer, uint32_t offset, uint32_t size)
+{
+    if (u_planeStep == 1)
+    {
+        memcpy(buffer, s_newImage + offset, size);
+        return;
+    }
+
+    // Black bytes, then red bytes
+    while (size > 0)
+    {
+        uint8_t plane = (offset < u_pageColourSize) ? 0 : 1;
+        uint32_t z = offset - plane * u_pageColourSize;
+        uint32_t length = hV_HAL_min(size, u_pageColourSize - z);
+        const uint8_t * source = s_newImage + (z << 1) + plane;
+
+        for (uint32_t i = 0; i < length; i += 1)
+        {
+            buffer[i] = source[i << 1];
+        }
+
+        buffer += length;
+        offset += length;
+        size -= length;
+    }
+}
+
+uint8_t Screen_EPD_EXT3::s_flushFixed(uint8_t black, uint8_t red, uint8_t updateMode)
+{
+    u_frameFixed = true;
+    u_fixedBlack = black;
+    u_fixedRed = red;
+
+    updateMode = flushMode(updateMode);
+
+    u_frameFixed = false;
+    return updateMode;
+}
+
+uint8_t Screen_EPD_EXT3::flushFromReader(frameReader_t reader)
+{
+    u_frameReader = reader;
+    u_frameResult = RESULT_SUCCESS;
+
+    uint8_t updateMode = flushMode(UPDATE_GLOBAL);
+
+    u_frameReader = nullptr;
+    return (updateMode == UPDATE_NONE) ? RESULT_ERROR : u_frameResult;
+}
+
+uint8_t Screen_EPD_EXT3::flushFromStream(Stream & stream)
+{
+    u_frameStream = &stream;
+    u_frameResult = RESULT_SUCCESS;
+
+    uint8_t updateMode = flushMode(UPDATE_GLOBAL);
+
+    u_frameStream = nullptr;
+    return (updateMode == UPDATE_NONE) ? RESULT_ERROR : u_frameResult;
+}
+
+uint8_t Screen_EPD_EXT3::flushFromCompressed(const uint8_t * data, uint32_t size)
+{
+    frameDecoder_s decoder;
+
+    if (frameDecodeBegin(decoder, data, size) == false)
+    {
+        mySerial.println("hV * Compressed image, invalid header");
+        return RESULT_ERROR;
+    }
+
+    if (decoder.total != u_pageColourSize * u_bufferDepth)
+    {
+        mySerial.println(formatString("hV * Compressed image, %i bytes instead of %i", decoder.total, u_pageColourSize * u_bufferDepth));
+        return RESULT_ERROR;
+    }
+
+    u_frameDecoder = &decoder;
+    u_frameOffset = 0;
+    u_frameResult = RESULT_SUCCESS;
+
+    uint8_t updateMode = flushMode(UPDATE_GLOBAL);
+
+    u_frameDecoder = nullptr;
+    return (updateMode == UPDATE_NONE) ? RESULT_ERROR : u_frameResult;
+}
+
+uint32_t Screen_EPD_EXT3::compressFrame(uint8_t * buffer, uint32_t capacity)
+{
+    if (s_newImage == nullptr)
+    {
+        return 0;
+    }
+
+    // Contiguous planes only
+    if (u_planeStep > 1)
+    {
+        mySerial.println("hV * Compression requires the planar layout");
+        return 0;
+    }
+    s_syncTiles();
+    return frameEncode(s_newImage, u_pageColourSize * u_bufferDepth, buffer, capacity);
+}
+
+uint8_t Screen_EPD_EXT3::flushFromStore(hV_Store & store, uint16_t slot)
+{
+    if (slot >= store.slots())
+    {
+        mySerial.println(formatString("hV * Store slot %i not available", slot));
+        return RESULT_ERROR;
+    }
+
+    u_frameStore = &store;
+    u_frameSlot = slot;
+    u_frameResult = RESULT_SUCCESS;
+
+    uint8_t updateMode = flushMode(UPDATE_GLOBAL);
+
+    u_frameStore = nullptr;
+    return (updateMode == UPDATE_NONE) ? RESULT_ERROR : u_frameResult;
+}
+
+uint32_t Screen_EPD_EXT3::getFrameSize()
+{
+    return u_pageColourSize * u_bufferDepth;
+}
+
+uint8_t Screen_EPD_EXT3::storeFrame(hV_Store & store, uint16_t slot)
+{
+    uint32_t size = getFrameSize();
+    uint32_t count = 0;
+    s_syncTiles();
+
+    if ((s_newImage != nullptr) and (u_planeStep == 1))
+    {
+        count = store.write(slot, 0, s_newImage, size);
+    }
+    else if (s_newImage != nullptr)
+    {
+        // Interleaved frame-buffer, saved in the planar layout by chunks
+        uint8_t chunk[STREAM_CHUNK_SIZE];
+        uint32_t written = STREAM_CHUNK_SIZE;
+
+        while ((count < size) and (written > 0))
+        {
+            uint32_t length = hV_HAL_min(size - count, (uint32_t)STREAM_CHUNK_SIZE);
+            s_readPlanes(chunk, count, length);
+            written = store.write(slot, count, chunk, length);
+            count += written;
+        }
+    }
+
+    if (count != size)
+    {
+        mySerial.println(formatString("hV * Store slot %i not written", slot));
+        return RESULT_ERROR;
+    }
+    return RESULT_SUCCESS;
+}
+
+void Screen_EPD_EXT3::flush()
+{
+    flushMode(UPDATE_GLOBAL);
+}
+
+void Screen_EPD_EXT3::clear(uint16_t colour)
+{
+    if (v_flagRecord)
+    {
+        uint16_t values[] = {colour};
+        s_record(RECORD_CLEAR, values, 1);
+        return;
+    }
+
+    if (s_newImage == nullptr)
+    {
+        return;
+    }
+    s_syncTiles();
+
+    // Patterns for even and odd rows
+    // red = 0-1, black = 1-0, white 0-0
+    uint8_t patternBlack[2];
+    uint8_t patternRed[2];
+
+    if (colour == myColours.red)
+    {
+        // physical red 0-1
+        patternBlack[0] = 0x00;
+        patternBlack[1] = 0x00;
+        patternRed[0] = 0xff;
+        patternRed[1] = 0xff;
+    }
+    else if (colour == myColours.grey)
+    {
+        patternBlack[0] = 0b01010101;
+        patternBlack[1] = 0b10101010;
+        patternRed[0] = 0x00;
+        patternRed[1] = 0x00;
+    }
+    else if (colour == myColours.darkRed)
+    {
+        patternBlack[0] = 0b01010101; // black
+        patternBlack[1] = 0b10101010;
+        patternRed[0] = 0b10101010; // red
+        patternRed[1] = 0b01010101;
+    }
+    else if (colour == myColours.lightRed)
+    {
+        patternBlack[0] = 0b00000000; // white
+        patternBlack[1] = 0b00000000;
+        patternRed[0] = 0b10101010; // red
+        patternRed[1] = 0b01010101;
+    }
+    else if ((colour == myColours.white) xor u_invert)
+    {
+        // physical black 0-0
+        patternBlack[0] = 0x00;
+        patternBlack[1] = 0x00;
+        patternRed[0] = 0x00;
+        patternRed[1] = 0x00;
+    }
+    else
+    {
+        // physical white 1-0
+        patternBlack[0] = 0xff;
+        patternBlack[1] = 0xff;
+        patternRed[0] = 0x00;
+        patternRed[1] = 0x00;
+    }
+
+    // Rows of the band, large screens with two halves
+    uint16_t rowSize = u_bufferSizeH;
+    uint8_t halves = 1;
+    if ((u_codeSize == SIZE_969) or (u_codeSize == SIZE_1198))
+    {
+        rowSize = u_bufferSizeH >> 1;
+        halves = 2;
+    }
+
+    for (uint8_t half = 0; half < halves; half += 1)
+    {
+        uint32_t offset = half * (u_pageColourSize >> 1) + (uint32_t)u_bandStart * rowSize;
+
+        if (u_planeStep > 1)
+        {
+            // Interleaved, pairs of black and red bytes
+            if ((patternBlack[0] == patternBlack[1]) and (patternRed[0] == patternRed[1]))
+            {
+                uint32_t length = (uint32_t)(u_bandEnd - u_bandStart) * rowSize;
+                s_fillInterleaved(s_newImage + (offset << 1), length, patternBlack[0], patternRed[0], DRAW_MODE_NORMAL);
+            }
+            else
+            {
+                for (uint16_t i = u_bandStart; i < u_bandEnd; i += 1)
+                {
+                    s_fillInterleaved(s_newImage + (offset << 1), rowSize, patternBlack[i % 2], patternRed[i % 2], DRAW_MODE_NORMAL);
+                    offset += rowSize;
+                }
+            }
+        }
+        else if ((patternBlack[0] == patternBlack[1]) and (patternRed[0] == patternRed[1]))
+        {
+            // Same pattern for all rows, contiguous
+            uint32_t length = (uint32_t)(u_bandEnd - u_bandStart) * rowSize;
+            s_fillBytes(s_newImage + offset, length, patternBlack[0]);
+            s_fillBytes(s_newImage + u_pageColourSize + offset, length, patternRed[0]);
+        }
+        else
+        {
+            for (uint16_t i = u_bandStart; i < u_bandEnd; i += 1)
+            {
+                s_fillBytes(s_newImage + offset, rowSize, patternBlack[i % 2]);
+                s_fillBytes(s_newImage + u_pageColourSize + offset, rowSize, patternRed[i % 2]);
+                offset += rowSize;
+            }
+        }
+    }
+}
+
+void Screen_EPD_EXT3::regenerate(uint8_t mode, bool flagRestore)
+{
+    // Same frames as clear(myColours.black) then clear(myColours.white), frame-buffer untouched
+    s_flushFixed(u_invert ? 0x00 : 0xff, 0x00, mode);
+    delay(100);
+
+    s_flushFixed(u_invert ? 0xff : 0x00, 0x00, mode);
+    delay(100);
+
+    if (flagRestore and (s_newImage != nullptr))
+    {
+        flushMode(mode);
+    }
+}
+
+uint8_t Screen_EPD_EXT3::flushSolid(uint16_t colour, uint8_t mode)
+{
+    // Same planes as clear(colour), frame-buffer untouched
+    if (colour == myColours.red)
+    {
+        return s_flushFixed(0x00, 0xff, mode);
+    }
+    else if ((colour == myColours.grey) or (colour == myColours.darkRed) or (colour == myColours.lightRed))
+    {
+        mySerial.println(formatString("hV * Colour %04x not solid", colour));
+        return UPDATE_NONE;
+    }
+    else if ((colour == myColours.white) xor u_invert)
+    {
+        return s_flushFixed(0x00, 0x00, mode);
+    }
+    else
+    {
+        return s_flushFixed(0xff, 0x00, mode);
+    }
+}
+
+void Screen_EPD_EXT3::s_setPoint(uint16_t x1, uint16_t y1, uint16_t colour)
+{
+    // Orient and check coordinates are within screen
+    if (s_orientCoordinates(x1, y1) == RESULT_ERROR)
+    {
+        return;
+    }
+
+    // Check coordinates are within band
+    if ((x1 < u_bandStart) or (x1 >= u_bandEnd))
+    {
+        return;
+    }
+
+    // Convert combined colours into basic colours
+    bool flagOdd = ((x1 + y1) % 2 == 0);
+
+    if (colour == myColours.darkRed)
+    {
+        if (flagOdd)
+        {
+            colour = myColours.red; // red
+        }
+        else
+        {
+            colour = u_invert ? myColours.white : myColours.black; // white
+        }
+    }
+    else if (colour == myColours.lightRed)
+    {
+        if (flagOdd)
+        {
+            colour = myColours.red; // red
+        }
+        else
+        {
+            colour = u_invert ? myColours.black : myColours.white; // black
+        }
+    }
+    else if (colour == myColours.grey)
+    {
+        if (flagOdd)
+        {
+            colour = myColours.black; // black
+        }
+        else
+        {
+            colour = myColours.white; // white
+        }
+    }
+
+    // Coordinates, in the tile cache or in the frame-buffer
+    uint8_t * pointer;
+    uint32_t red1;
+    if (u_tileCount > 0)
+    {
+        pointer = s_getTile(x1, true) + (x1 & 0x07) * u_bufferSizeH + (y1 >> 3);
+        red1 = u_tileRed;
+    }
+    else
+    {
+        pointer = s_newImage + s_getZ(x1, y1);
+        red1 = u_planeRed;
+    }
+    uint16_t b1 = s_getB(x1, y1);
+
+    // Drawing modes
+    if (u_drawMode == DRAW_MODE_XOR)
+    {
+        uint8_t black, red;
+        if (s_getPlanes(colour, black, red) == RESULT_SUCCESS)
+        {
+            pointer[0] ^= black & (1 << b1);
+            pointer[red1] ^= red & (1 << b1);
+        }
+        return;
+    }
+    else if (u_drawMode == DRAW_MODE_INVERT)
+    {
+        // Red pixels unchanged
+        if (bitRead(pointer[red1], b1) == 0)
+        {
+            pointer[0] ^= (1 << b1);
+        }
+        return;
+    }
+
+    // Basic colours
+    if (colour == myColours.red)
+    {
+        // physical red 0-1
+        bitClear(pointer[0], b1);
+        bitSet(pointer[red1], b1);
+    }
+    else if ((colour == myColours.white) xor u_invert)
+    {
+        // physical black 0-0
+        bitClear(pointer[0], b1);
+        bitClear(pointer[red1], b1);
+    }
+    else if ((colour == myColours.black) xor u_invert)
+    {
+        // physical white 1-0
+        bitSet(pointer[0], b1);
+        bitClear(pointer[red1], b1);
+    }
+}
+
+bool Screen_EPD_EXT3::s_getNativeArea(uint16_t & x1, uint16_t & y1, uint16_t & x2, uint16_t & y2)
+{
+    // Empty band, for example without frame-buffer
+    if (u_bandStart >= u_bandEnd)
+    {
+        return RESULT_ERROR;
+    }
+
+    // Clip to screen, logical coordinates
+    uint16_t sizeX = screenSizeX();
+    uint16_t sizeY = screenSizeY();
+    if ((x1 >= sizeX) or (y1 >= sizeY))
+    {
+        return RESULT_ERROR;
+    }
+    x2 = hV_HAL_min(x2, sizeX - 1);
+    y2 = hV_HAL_min(y2, sizeY - 1);
+    if ((x1 > x2) or (y1 > y2))
+    {
+        return RESULT_ERROR;
+    }
+
+    // Native coordinates, rows along x and bits along y
+    s_orientCoordinates(x1, y1);
+    s_orientCoordinates(x2, y2);
+    if (x1 > x2)
+    {
+        hV_HAL_swap(x1, x2);
+    }
+    if (y1 > y2)
+    {
+        hV_HAL_swap(y1, y2);
+    }
+
+    // Clip to band
+    x1 = hV_HAL_max(x1, u_bandStart);
+    x2 = hV_HAL_min(x2, u_bandEnd - 1);
+    if (x1 > x2)
+    {
+        return RESULT_ERROR;
+    }
+
+    return RESULT_SUCCESS;
+}
+
+void Screen_EPD_EXT3::s_fillArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
+{
+    if (s_getNativeArea(x1, y1, x2, y2) == RESULT_ERROR)
+    {
+        return;
+    }
+
+    // Patterns for even and odd native rows
+    // s_setPoint() colours (x + y) even pixels with colourEven
+    uint16_t colourEven = colour;
+    uint16_t colourOdd = colour;
+
+    if (colour == myColours.darkRed)
+    {
+        colourEven = myColours.red;
+        colourOdd = u_invert ? myColours.white : myColours.black;
+    }
+    else if (colour == myColours.lightRed)
+    {
+        colourEven = myColours.red;
+        colourOdd = u_invert ? myColours.black : myColours.white;
+    }
+    else if (colour == myColours.grey)
+    {
+        colourEven = myColours.black;
+        colourOdd = myColours.white;
+    }
+
+    uint8_t blackEven, redEven, blackOdd, redOdd;
+    if ((s_getPlanes(colourEven, blackEven, redEven) == RESULT_ERROR) or (s_getPlanes(colourOdd, blackOdd, redOdd) == RESULT_ERROR))
+    {
+        return;
+    }
+
+    // Even rows, even pixels on bits 7, 5, 3, 1
+    uint8_t patternBlack[2];
+    uint8_t patternRed[2];
+    patternBlack[0] = (blackEven & 0b10101010) | (blackOdd & 0b01010101);
+    patternBlack[1] = (blackEven & 0b01010101) | (blackOdd & 0b10101010);
+    patternRed[0] = (redEven & 0b10101010) | (redOdd & 0b01010101);
+    patternRed[1] = (redEven & 0b01010101) | (redOdd & 0b10101010);
+
+    s_fillNativeHalves(x1, x2, y1, y2, patternBlack, patternRed, u_drawMode);
+}
+
+void Screen_EPD_EXT3::s_fillNativeHalves(uint16_t row1, uint16_t row2, uint16_t y1, uint16_t y2, const uint8_t * patternBlack, const uint8_t * patternRed, uint8_t mode)
+{
+    switch (u_codeSize)
+    {
+        case SIZE_969:
+        case SIZE_1198:
+        {
+            // Two halves, rebased
+            uint16_t half = v_screenSizeH >> 1;
+            if (y1 < half)
+            {
+                s_fillNative(0, u_bufferSizeH >> 1, row1, row2, y1, hV_HAL_min(y2, half - 1), patternBlack, patternRed, mode);
+            }
+            if (y2 >= half)
+            {
+                s_fillNative(u_pageColourSize >> 1, u_bufferSizeH >> 1, row1, row2, hV_HAL_max(y1, half) - half, y2 - half, patternBlack, patternRed, mode);
+            }
+            break;
+        }
+
+        default:
+
+            s_fillNative(0, u_bufferSizeH, row1, row2, y1, y2, patternBlack, patternRed, mode);
+            break;
+    }
+}
+
+void Screen_EPD_EXT3::s_fillNative(uint32_t offset, uint16_t rowSize, uint16_t row1, uint16_t row2, uint16_t y1, uint16_t y2, const uint8_t * patternBlack, const uint8_t * patternRed, uint8_t mode)
+{
+    uint16_t byte1 = y1 >> 3;
+    uint16_t byte2 = y2 >> 3;
+    uint8_t mask1 = 0xff >> (y1 % 8);
+    uint8_t mask2 = 0xff << (7 - (y2 % 8));
+
+    if (byte1 == byte2)
+    {
+        mask1 &= mask2;
+    }
+
+    uint32_t length = (byte2 > byte1) ? byte2 - byte1 - 1 : 0;
+
+    for (uint16_t row = row1; row <= row2; row += 1)
+    {
+        // Row in the tile cache if already there, otherwise in the frame-buffer
+        // Tile rows are planar, with the second half of large screens after the first half
+        uint8_t * black;
+        uint8_t step = u_planeStep;
+        uint32_t red1 = u_planeRed;
+        if ((u_tileCount > 0) and (s_findTile(row) < u_tileCount))
+        {
+            black = s_getTile(row, true) + (row & 0x07) * u_bufferSizeH + ((offset > 0) ? rowSize : 0);
+            step = 1;
+            red1 = u_tileRed;
+        }
+        else
+        {
+            black = s_newImage + (offset + (uint32_t)row * rowSize) * u_planeStep;
+        }
+        uint8_t * red = black + red1;
+        uint8_t parity = row % 2;
+
+        // Edge bytes, planar or interleaved
+        uint32_t k1 = (uint32_t)byte1 * step;
+        uint32_t k2 = (uint32_t)byte2 * step;
+
+        // Whole bytes between the edges
+        if ((length > 0) and (step > 1))
+        {
+            s_fillInterleaved(black + k1 + 2, length, patternBlack[parity], patternRed[parity], mode);
+        }
+        else if (length > 0)
+        {
+            switch (mode)
+            {
+                case DRAW_MODE_XOR:
+
+                    s_xorBytes(black + byte1 + 1, length, patternBlack[parity]);
+                    s_xorBytes(red + byte1 + 1, length, patternRed[parity]);
+                    break;
+
+                case DRAW_MODE_INVERT:
+
+                    s_invertBytes(black + byte1 + 1, red + byte1 + 1, length);
+                    break;
+
+                default:
+
+                    s_fillBytes(black + byte1 + 1, length, patternBlack[parity]);
+                    s_fillBytes(red + byte1 + 1, length, patternRed[parity]);
+                    break;
+            }
+        }
+
+        switch (mode)
+        {
+            case DRAW_MODE_XOR:
+
+                black[k1] ^= patternBlack[parity] & mask1;
+                red[k1] ^= patternRed[parity] & mask1;
+
+                if (byte2 > byte1)
+                {
+                    black[k2] ^= patternBlack[parity] & mask2;
+                    red[k2] ^= patternRed[parity] & mask2;
+                }
+                break;
+
+            case DRAW_MODE_INVERT:
+
+                // Red pixels unchanged
+                black[k1] ^= ~red[k1] & mask1;
+
+                if (byte2 > byte1)
+                {
+                    black[k2] ^= ~red[k2] & mask2;
+                }
+                break;
+
+            default:
+
+                black[k1] = (black[k1] & ~mask1) | (patternBlack[parity] & mask1);
+                red[k1] = (red[k1] & ~mask1) | (patternRed[parity] & mask1);
+
+                if (byte2 > byte1)
+                {
+                    black[k2] = (black[k2] & ~mask2) | (patternBlack[parity] & mask2);
+                    red[k2] = (red[k2] & ~mask2) | (patternRed[parity] & mask2);
+                }
+                break;
+        }
+    }
+}
+
+void Screen_EPD_EXT3::s_fillBytes(uint8_t * pointer, uint32_t length, uint8_t pattern)
+{
+    // Head, up to word alignment
+    while ((length > 0) and (((uintptr_t)pointer & 0x03) != 0))
+    {
+        *pointer = pattern;
+        pointer += 1;
+        length -= 1;
+    }
+
+    // Aligned words
+    uint32_t word = pattern * 0x01010101UL;
+    uint32_t * pointerWord = (uint32_t *)pointer;
+    for (uint32_t i = length >> 2; i > 0; i -= 1)
+    {
+        *pointerWord = word;
+        pointerWord += 1;
+    }
+
+    // Tail
+    pointer = (uint8_t *)pointerWord;
+    for (length &= 0x03; length > 0; length -= 1)
+    {
+        *pointer = pattern;
+        pointer += 1;
+    }
+}
+
+void Screen_EPD_EXT3::s_xorBytes(uint8_t * pointer, uint32_t length, uint8_t pattern)
+{
+    // Head, up to word alignment
+    while ((length > 0) and (((uintptr_t)pointer & 0x03) != 0))
+    {
+        *pointer ^= pattern;
+        pointer += 1;
+        length -= 1;
+    }
+
+    // Aligned words
+    uint32_t word = pattern * 0x01010101UL;
+    uint32_t * pointerWord = (uint32_t *)pointer;
+    for (uint32_t i = length >> 2; i > 0; i -= 1)
+    {
+        *pointerWord ^= word;
+        pointerWord += 1;
+    }
+
+    // Tail
+    pointer = (uint8_t *)pointerWord;
+    for (length &= 0x03; length > 0; length -= 1)
+    {
+        *pointer ^= pattern;
+        pointer += 1;
+    }
+}
+
+void Screen_EPD_EXT3::s_invertBytes(uint8_t * black, const uint8_t * red, uint32_t length)
+{
+    // Words only if both planes share the same alignment
+    if (((uintptr_t)black & 0x03) == ((uintptr_t)red & 0x03))
+    {
+        while ((length > 0) and (((uintptr_t)black & 0x03) != 0))
+        {
+            *black ^= ~*red;
+            black += 1;
+            red += 1;
+            length -= 1;
+        }
+
+        uint32_t * blackWord = (uint32_t *)black;
+        const uint32_t * redWord = (const uint32_t *)red;
+        for (uint32_t i = length >> 2; i > 0; i -= 1)
+        {
+            *blackWord ^= ~*redWord;
+            blackWord += 1;
+            redWord += 1;
+        }
+
+        black = (uint8_t *)blackWord;
+        red = (const uint8_t *)redWord;
+        length &= 0x03;
+    }
+
+    for (; length > 0; length -= 1)
+    {
+        *black ^= ~*red;
+        black += 1;
+        red += 1;
+    }
+}
+
+void Screen_EPD_EXT3::s_fillInterleaved(uint8_t * pointer, uint32_t length, uint8_t patternBlack, uint8_t patternRed, uint8_t mode)
+{
+    switch (mode)
+    {
+        case DRAW_MODE_XOR:
+
+            for (uint32_t i = 0; i < length; i += 1)
+            {
+                pointer[0] ^= patternBlack;
+                pointer[1] ^= patternRed;
+                pointer += 2;
+            }
+            break;
+
+        case DRAW_MODE_INVERT:
+
+            // Red pixels unchanged
+            for (uint32_t i = 0; i < length; i += 1)
+            {
+                pointer[0] ^= ~pointer[1];
+                pointer += 2;
+            }
+            break;
+
+        default:
+        {
+            // Head, up to word alignment
+            while ((length > 0) and (((uintptr_t)pointer & 0x03) != 0))
+            {
+                pointer[0] = patternBlack;
+                pointer[1] = patternRed;
+                pointer += 2;
+                length -= 1;
+            }
+
+            // Aligned words, two pairs each, same bytes order on any endianness
+            uint8_t pairs[4] = {patternBlack, patternRed, patternBlack, patternRed};
+            uint32_t word;
+            memcpy(&word, pairs, 4);
+            uint32_t * pointerWord = (uint32_t *)pointer;
+            for (uint32_t i = length >> 1; i > 0; i -= 1)
+            {
+                *pointerWord = word;
+                pointerWord += 1;
+            }
+
+            // Tail
+            if ((length & 0x01) != 0)
+            {
+                pointer = (uint8_t *)pointerWord;
+                pointer[0] = patternBlack;
+                pointer[1] = patternRed;
+            }
+            break;
+        }
+    }
+}
+
+bool Screen_EPD_EXT3::s_getPlanes(uint16_t colour, uint8_t & black, uint8_t & red)
+{
+    // Same order as s_setPoint()
+    if (colour == myColours.red)
+    {
+        // physical red 0-1
+        black = 0x00;
+        red = 0xff;
+    }
+    else if ((colour == myColours.white) xor u_invert)
+    {
+        // physical black 0-0
+        black = 0x00;
+        red = 0x00;
+    }
+    else if ((colour == myColours.black) xor u_invert)
+    {
+        // physical white 1-0
+        black = 0xff;
+        red = 0x00;
+    }
+    else
+    {
+        return RESULT_ERROR;
+    }
+
+    return RESULT_SUCCESS;
+}
+
+void Screen_EPD_EXT3::s_setOrientation(uint8_t orientation)
+{
+    v_orientation = orientation % 4;
+}
+
+bool Screen_EPD_EXT3::s_orientCoordinates(uint16_t & x, uint16_t & y)
+{
+    bool _flagResult = RESULT_ERROR;
+    switch (v_orientation)
+    {
+        case 3: // checked, previously 1
+
+            if ((x < v_screenSizeV) and (y < v_screenSizeH))
+            {
+                x = v_screenSizeV - 1 - x;
+                _flagResult = RESULT_SUCCESS;
+            }
+            break;
+
+        case 2: // checked
+
+            if ((x < v_screenSizeH) and (y < v_screenSizeV))
+            {
+                x = v_screenSizeH - 1 - x;
+                y = v_screenSizeV - 1 - y;
+                hV_HAL_swap(x, y);
+                _flagResult = RESULT_SUCCESS;
+            }
+            break;
+
+        case 1: // checked, previously 3
+
+            if ((x < v_screenSizeV) and (y < v_screenSizeH))
+            {
+                y = v_screenSizeH - 1 - y;
+                _flagResult = RESULT_SUCCESS;
+            }
+            break;
+
+        default: // checked
+
+            if ((x < v_screenSizeH) and (y < v_screenSizeV))
+            {
+                hV_HAL_swap(x, y);
+                _flagResult = RESULT_SUCCESS;
+            }
+            break;
+    }
+
+    return _flagResult;
+}
+
+uint32_t Screen_EPD_EXT3::s_getZ(uint16_t x1, uint16_t y1)
+{
+    uint32_t z1 = 0;
+    // According to 11.98 inch Spectra Application Note
+    // at http://www.pervasivedisplays.com/LiteratureRetrieve.aspx?ID=245146
+    switch (u_codeSize)
+    {
+        case SIZE_969:
+        case SIZE_1198:
+
+            if (y1 >= (v_screenSizeH >> 1))
+            {
+                y1 -= (v_screenSizeH >> 1); // rebase y1
+                z1 += (u_pageColourSize >> 1); // buffer second half
+            }
+            z1 += (uint32_t)x1 * (u_bufferSizeH >> 1) + (y1 >> 3);
+            break;
+
+        default:
+
+            z1 = (uint32_t)x1 * u_bufferSizeH + (y1 >> 3);
+            break;
+    }
+    return z1 * u_planeStep;
+}
+
+uint16_t Screen_EPD_EXT3::s_getB(uint16_t x1, uint16_t y1)
+{
+    uint16_t b1 = 0;
+
+    b1 = 7 - (y1 % 8);
+
+    return b1;
 }
 
 uint16_t Screen_EPD_EXT3::s_getPoint(uint16_t x1, uint16_t y1)
 {
-    return 0x0000;
+    // Orient and check coordinates are within screen
+    if ((s_newImage == nullptr) or (s_orientCoordinates(x1, y1) == RESULT_ERROR))
+    {
+        return 0x0000;
+    }
+
+    // In the tile cache or in the frame-buffer, as rows outside the band may be drawn by another screen
+    uint8_t * pointer;
+    uint32_t red1;
+    if ((u_tileCount > 0) and (x1 >= u_bandStart) and (x1 < u_bandEnd))
+    {
+        pointer = s_getTile(x1, false) + (x1 & 0x07) * u_bufferSizeH + (y1 >> 3);
+        red1 = u_tileRed;
+    }
+    else
+    {
+        pointer = s_newImage + s_getZ(x1, y1);
+        red1 = u_planeRed;
+    }
+    uint16_t b1 = s_getB(x1, y1);
+
+    if (bitRead(pointer[red1], b1))
+    {
+        // physical red 0-1
+        return myColours.red;
+    }
+    else if (bitRead(pointer[0], b1) xor u_invert)
+    {
+        // physical white 1-0
+        return myColours.black;
+    }
+    else
+    {
+        // physical black 0-0
+        return myColours.white;
+    }
+}
+
+uint16_t Screen_EPD_EXT3::readPixel(uint16_t x1, uint16_t y1)
+{
+    return s_getPoint(x1, y1);
+}
+
+uint32_t Screen_EPD_EXT3::exportImage(Print & output, uint8_t format, uint16_t firstRow, uint16_t numberRows)
+{
+    if (s_newImage == nullptr)
+    {
+        mySerial.println("hV * No frame-buffer");
+        return 0;
+    }
+
+    if (format > EXPORT_PPM)
+    {
+        mySerial.println(formatString("hV * Export format %i not supported", format));
+        return 0;
+    }
+    s_syncTiles();
+
+    uint16_t sizeX = screenSizeX();
+    uint16_t sizeY = screenSizeY();
+    uint32_t count = 0;
+
+    // Header with the first row
+    if (firstRow == 0)
+    {
+        count += output.print(formatString("P%c\n%i %i\n%s", (format == EXPORT_PPM) ? '6' : '4', sizeX, sizeY, (format == EXPORT_PPM) ? "255\n" : ""));
+    }
+
+    uint16_t lastRow = (uint16_t)hV_HAL_min((uint32_t)sizeY, (uint32_t)firstRow + numberRows);
+    uint8_t chunk[STREAM_CHUNK_SIZE];
+    uint16_t length = 0;
+
+    for (uint16_t y = firstRow; y < lastRow; y += 1)
+    {
+        for (uint16_t x = 0; x < sizeX; x += 1)
+        {
+            // Native coordinates, halves of large screens included
+            uint16_t x1 = x;
+            uint16_t y1 = y;
+            s_orientCoordinates(x1, y1);
+            uint32_t z1 = s_getZ(x1, y1);
+            uint16_t b1 = s_getB(x1, y1);
+
+            if (format == EXPORT_PPM)
+            {
+                // Room for one pixel
+                if (length + 3 > STREAM_CHUNK_SIZE)
+                {
+                    count += output.write(chunk, length);
+                    length = 0;
+                }
+
+                // Same colours as s_getPoint()
+                uint8_t valueR = 0xff; // white
+                uint8_t valueGB = 0xff;
+                if (bitRead(s_newImage[u_planeRed + z1], b1))
+                {
+                    valueGB = 0x00; // red
+                }
+                else if (bitRead(s_newImage[z1], b1) xor u_invert)
+                {
+                    valueR = 0x00; // black
+                    valueGB = 0x00;
+                }
+                chunk[length] = valueR;
+                chunk[length + 1] = valueGB;
+                chunk[length + 2] = valueGB;
+                length += 3;
+            }
+            else
+            {
+                // Rows padded to whole bytes, most significant bit on the left
+                if (x % 8 == 0)
+                {
+                    if (length == STREAM_CHUNK_SIZE)
+                    {
+                        count += output.write(chunk, length);
+                        length = 0;
+                    }
+                    chunk[length] = 0x00;
+                    length += 1;
+                }
+
+                uint32_t offset = (format == EXPORT_PBM_RED) ? u_planeRed : 0;
+                if (bitRead(s_newImage[offset + z1], b1))
+                {
+                    bitSet(chunk[length - 1], 7 - (x % 8));
+                }
+            }
+        }
+    }
+
+    if (length > 0)
+    {
+        count += output.write(chunk, length);
+    }
+
+    return count;
+}
+
+uint32_t Screen_EPD_EXT3::exportTrace(Print & output)
+{
+    output.println(formatString("hV screen %i %i family %i film %c dc %i cs %i css %i busy %i reset %i", v_screenSizeH, v_screenSizeV, b_family, u_codeFilm, b_pin.panelDC, b_pin.panelCS, b_pin.panelCSS, b_pin.panelBusy, b_pin.panelReset));
+    return hV_HAL_trace_export(output);
+}
+
+void Screen_EPD_EXT3::beginRecord(uint8_t * buffer, size_t size)
+{
+    hV_Screen_Buffer::beginRecord(buffer, size);
+
+    // Drawing mode at start
+    uint16_t values[] = {u_drawMode};
+    s_record(RECORD_DRAW_MODE, values, 1);
+}
+
+void Screen_EPD_EXT3::s_replay(uint8_t command, const uint16_t * values, const uint8_t * data, uint16_t length)
+{
+    switch (command)
+    {
+        case RECORD_DRAW_MODE:
+
+            setDrawMode(values[0]);
+            break;
+
+        case RECORD_INVERT_AREA:
+
+            invertArea(values[0], values[1], values[2], values[3]);
+            break;
+
+        case RECORD_BITMAP:
+        {
+            // Pointer copied for alignment
+            const uint8_t * bitmap = nullptr;
+            if (length == sizeof(bitmap))
+            {
+                memcpy(&bitmap, data, sizeof(bitmap));
+                drawBitmap(values[0], values[1], values[2], values[3], bitmap, values[4], values[5], values[6]);
+            }
+            break;
+        }
+
+        default:
+
+            break;
+    }
+}
+
+void Screen_EPD_EXT3::setDrawMode(uint8_t mode)
+{
+    u_drawMode = (mode <= DRAW_MODE_INVERT) ? mode : DRAW_MODE_NORMAL;
+    v_flagToggle = (u_drawMode != DRAW_MODE_NORMAL);
+
+    if (v_flagRecord)
+    {
+        uint16_t values[] = {u_drawMode};
+        s_record(RECORD_DRAW_MODE, values, 1);
+    }
+}
+
+uint8_t Screen_EPD_EXT3::getDrawMode()
+{
+    return u_drawMode;
+}
+
+void Screen_EPD_EXT3::invertArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+    if (v_flagRecord)
+    {
+        uint16_t values[] = {x1, y1, x2, y2};
+        s_record(RECORD_INVERT_AREA, values, 4);
+        return;
+    }
+
+    if (x1 > x2)
+    {
+        hV_HAL_swap(x1, x2);
+    }
+    if (y1 > y2)
+    {
+        hV_HAL_swap(y1, y2);
+    }
+
+    if (s_getNativeArea(x1, y1, x2, y2) == RESULT_ERROR)
+    {
+        return;
+    }
+
+    uint8_t patterns[2] = {0x00, 0x00}; // unused
+    s_fillNativeHalves(x1, x2, y1, y2, patterns, patterns, DRAW_MODE_INVERT);
+}
+
+void Screen_EPD_EXT3::copyArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x0, uint16_t y0)
+{
+    // Source possibly outside the band of the replay
+    if (v_flagRecord)
+    {
+        mySerial.println(formatString("hV * %s not recorded", "copyArea()"));
+        v_recordOverflow = true;
+        return;
+    }
+
+    if (x1 > x2)
+    {
+        hV_HAL_swap(x1, x2);
+    }
+    if (y1 > y2)
+    {
+        hV_HAL_swap(y1, y2);
+    }
+
+    // Clip source and target to screen, logical coordinates
+    uint16_t sizeX = screenSizeX();
+    uint16_t sizeY = screenSizeY();
+    if ((x1 >= sizeX) or (y1 >= sizeY) or (x0 >= sizeX) or (y0 >= sizeY))
+    {
+        return;
+    }
+    uint16_t dx = hV_HAL_min(hV_HAL_min(x2, sizeX - 1) - x1, sizeX - 1 - x0);
+    uint16_t dy = hV_HAL_min(hV_HAL_min(y2, sizeY - 1) - y1, sizeY - 1 - y0);
+
+    // Native coordinates, orientation keeps translations
+    uint16_t sourceRow1 = x1;
+    uint16_t sourceBit1 = y1;
+    uint16_t sourceRow2 = x1 + dx;
+    uint16_t sourceBit2 = y1 + dy;
+    uint16_t targetRow1 = x0;
+    uint16_t targetBit1 = y0;
+    uint16_t targetRow2 = x0 + dx;
+    uint16_t targetBit2 = y0 + dy;
+    s_orientCoordinates(sourceRow1, sourceBit1);
+    s_orientCoordinates(sourceRow2, sourceBit2);
+    s_orientCoordinates(targetRow1, targetBit1);
+    s_orientCoordinates(targetRow2, targetBit2);
+
+    s_copyNative(hV_HAL_min(sourceRow1, sourceRow2), hV_HAL_max(sourceRow1, sourceRow2),
+                 hV_HAL_min(sourceBit1, sourceBit2), hV_HAL_max(sourceBit1, sourceBit2),
+                 hV_HAL_min(targetRow1, targetRow2), hV_HAL_min(targetBit1, targetBit2));
+}
+
+void Screen_EPD_EXT3::scrollArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, int16_t dx, int16_t dy, uint16_t colour)
+{
+    // Source possibly outside the band of the replay
+    if (v_flagRecord)
+    {
+        mySerial.println(formatString("hV * %s not recorded", "scrollArea()"));
+        v_recordOverflow = true;
+        return;
+    }
+
+    if (x1 > x2)
+    {
+        hV_HAL_swap(x1, x2);
+    }
+    if (y1 > y2)
+    {
+        hV_HAL_swap(y1, y2);
+    }
+
+    int32_t width = x2 - x1 + 1;
+    int32_t height = y2 - y1 + 1;
+
+    // Uncovered area filled in normal mode
+    uint8_t oldDrawMode = u_drawMode;
+    u_drawMode = DRAW_MODE_NORMAL;
+
+    // Content moved away
+    if ((abs(dx) >= width) or (abs(dy) >= height))
+    {
+        s_fillArea(x1, y1, x2, y2, colour);
+        u_drawMode = oldDrawMode;
+        return;
+    }
+
+    // Move the part that stays inside the region
+    uint16_t sourceX = (dx < 0) ? x1 - dx : x1;
+    uint16_t sourceY = (dy < 0) ? y1 - dy : y1;
+    uint16_t targetX = (dx > 0) ? x1 + dx : x1;
+    uint16_t targetY = (dy > 0) ? y1 + dy : y1;
+    copyArea(sourceX, sourceY, sourceX + width - abs(dx) - 1, sourceY + height - abs(dy) - 1, targetX, targetY);
+
+    // Fill the uncovered strips
+    if (dx > 0)
+    {
+        s_fillArea(x1, y1, x1 + dx - 1, y2, colour);
+    }
+    else if (dx < 0)
+    {
+        s_fillArea(x2 + dx + 1, y1, x2, y2, colour);
+    }
+
+    if (dy > 0)
+    {
+        s_fillArea(x1, y1, x2, y1 + dy - 1, colour);
+    }
+    else if (dy < 0)
+    {
+        s_fillArea(x1, y2 + dy + 1, x2, y2, colour);
+    }
+
+    u_drawMode = oldDrawMode;
+}
+
+void Screen_EPD_EXT3::drawBitmap(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy, const uint8_t * data, uint8_t format, uint16_t colour, uint16_t backColour)
+{
+    if (v_flagRecord)
+    {
+        // Pointer recorded, not the data
+        uint16_t values[] = {x0, y0, dx, dy, format, colour, backColour};
+        s_record(RECORD_BITMAP, values, 7, &data, sizeof(data));
+        return;
+    }
+
+    if ((x0 >= screenSizeX()) or (y0 >= screenSizeY()))
+    {
+        return;
+    }
+    s_syncTiles();
+
+    uint16_t width = hV_HAL_min(dx, (uint16_t)(screenSizeX() - x0));
+    uint16_t height = hV_HAL_min(dy, (uint16_t)(screenSizeY() - y0));
+    uint16_t rowSize = (dx + 7) >> 3;
+    uint16_t count = (width + 7) >> 3;
+    bool flagBWR = ((format & 0x0f) == BITMAP_BWR);
+    bool flagTransparent = ((format & BITMAP_TRANSPARENT) == BITMAP_TRANSPARENT);
+    bool flagFlash = ((format & BITMAP_FLASH) == BITMAP_FLASH);
+
+    // Planes for colour, back colour and red, basic colours only
+    uint8_t planes[6];
+    bool flagFast = (u_drawMode == DRAW_MODE_NORMAL);
+    flagFast = flagFast and ((colour == myColours.black) or (colour == myColours.white) or (colour == myColours.red));
+    flagFast = flagFast and ((backColour == myColours.black) or (backColour == myColours.white) or (backColour == myColours.red));
+    flagFast = flagFast and (s_getPlanes(colour, planes[0], planes[1]) == RESULT_SUCCESS);
+    flagFast = flagFast and (s_getPlanes(backColour, planes[2], planes[3]) == RESULT_SUCCESS);
+    s_getPlanes(myColours.red, planes[4], planes[5]);
+
+    // Visible part of a row, with leading and trailing bytes for shifts
+    uint8_t lineBlack[2 + 128];
+    uint8_t lineRed[2 + 128];
+    lineBlack[0] = 0x00;
+    lineRed[0] = 0x00;
+
+    for (uint16_t j = 0; j < height; j += 1)
+    {
+        uint16_t y = y0 + j;
+        const uint8_t * sourceBlack = data + (uint32_t)j * rowSize;
+        const uint8_t * sourceRed = sourceBlack + (uint32_t)dy * rowSize;
+
+        for (uint16_t k = 0; k < count; k += 1)
+        {
+#if defined(F)
+            if (flagFlash)
+            {
+                lineBlack[1 + k] = pgm_read_byte(sourceBlack + k);
+                lineRed[1 + k] = flagBWR ? pgm_read_byte(sourceRed + k) : 0x00;
+                continue;
+            }
+#endif // F
+
+            lineBlack[1 + k] = sourceBlack[k];
+            lineRed[1 + k] = flagBWR ? sourceRed[k] : 0x00;
+        }
+        lineBlack[1 + count] = 0x00;
+        lineRed[1 + count] = 0x00;
+
+        // Pixel by pixel
+        if (not flagFast)
+        {
+            for (uint16_t i = 0; i < width; i += 1)
+            {
+                uint8_t mask = 0x80 >> (i & 7);
+                if (lineRed[1 + (i >> 3)] & mask)
+                {
+                    s_setPoint(x0 + i, y, myColours.red);
+                }
+                else if (lineBlack[1 + (i >> 3)] & mask)
+                {
+                    s_setPoint(x0 + i, y, colour);
+                }
+                else if (not flagTransparent)
+                {
+                    s_setPoint(x0 + i, y, backColour);
+                }
+            }
+            continue;
+        }
+
+        switch (v_orientation)
+        {
+            case 0:
+
+                // Logical row along native row
+                s_mergeRow(y, x0, width, lineBlack, lineRed, 0, planes, format);
+                break;
+
+            case 2:
+
+                // Logical row along native row, reversed
+                s_reverseBits(lineBlack + 1, count);
+                s_reverseBits(lineRed + 1, count);
+                s_mergeRow(v_screenSizeV - 1 - y, v_screenSizeH - x0 - width, width, lineBlack, lineRed, (count << 3) - width, planes, format);
+                break;
+
+            default:
+            {
+                // Logical row across native rows, same bit
+                bool flagLarge = ((u_codeSize == SIZE_969) or (u_codeSize == SIZE_1198));
+                uint32_t rowStep = (flagLarge ? (u_bufferSizeH >> 1) : u_bufferSizeH) * u_planeStep;
+                uint16_t y1 = (v_orientation == 1) ? v_screenSizeH - 1 - y : y;
+                uint32_t z0 = s_getZ(0, y1);
+                uint8_t b1 = 1 << s_getB(0, y1);
+
+                for (uint16_t i = 0; i < width; i += 1)
+                {
+                    uint16_t x1 = (v_orientation == 1) ? x0 + i : v_screenSizeV - 1 - x0 - i;
+                    if ((x1 < u_bandStart) or (x1 >= u_bandEnd))
+                    {
+                        continue;
+                    }
+
+                    // 0 = colour, 2 = back colour, 4 = red
+                    uint8_t mask = 0x80 >> (i & 7);
+                    uint8_t index = 2;
+                    if (lineRed[1 + (i >> 3)] & mask)
+                    {
+                        index = 4;
+                    }
+                    else if (lineBlack[1 + (i >> 3)] & mask)
+                    {
+                        index = 0;
+                    }
+                    else if (flagTransparent)
+                    {
+                        continue;
+                    }
+
+                    uint32_t z1 = z0 + (uint32_t)x1 * rowStep;
+                    s_newImage[z1] = (s_newImage[z1] & ~b1) | (planes[index] & b1);
+                    s_newImage[u_planeRed + z1] = (s_newImage[u_planeRed + z1] & ~b1) | (planes[index + 1] & b1);
+                }
+                break;
+            }
+        }
+    }
+}
+
+void Screen_EPD_EXT3::s_copyNative(uint16_t row1, uint16_t row2, uint16_t bit1, uint16_t bit2, uint16_t targetRow1, uint16_t targetBit1)
+{
+    s_syncTiles();
+
+    uint16_t rows = row2 - row1 + 1;
+    uint16_t bits = bit2 - bit1 + 1;
+    bool flagLarge = ((u_codeSize == SIZE_969) or (u_codeSize == SIZE_1198));
+    uint16_t rowSize = flagLarge ? (u_bufferSizeH >> 1) : u_bufferSizeH;
+
+    // Target rows within band
+    uint16_t first = (targetRow1 < u_bandStart) ? u_bandStart - targetRow1 : 0;
+    uint16_t last = rows;
+    if (targetRow1 + rows > u_bandEnd)
+    {
+        last = (u_bandEnd > targetRow1) ? u_bandEnd - targetRow1 : 0;
+    }
+    if (first >= last)
+    {
+        return;
+    }
+
+    // Whole rows: contiguous blocks per half and plane, or per half if interleaved
+    if ((bit1 == 0) and (targetBit1 == 0) and (bits == v_screenSizeH))
+    {
+        uint32_t length = (uint32_t)(last - first) * rowSize;
+        for (uint8_t half = 0; half < (flagLarge ? 2 : 1); half += 1)
+        {
+            uint32_t offset = half * (u_pageColourSize >> 1);
+            uint8_t * source = s_newImage + (offset + (uint32_t)(row1 + first) * rowSize) * u_planeStep;
+            uint8_t * target = s_newImage + (offset + (uint32_t)(targetRow1 + first) * rowSize) * u_planeStep;
+            if (u_planeStep > 1)
+            {
+                memmove(target, source, length * u_planeStep);
+            }
+            else
+            {
+                memmove(target, source, length);
+                memmove(target + u_pageColourSize, source + u_pageColourSize, length);
+            }
+        }
+        return;
+    }
+
+    // Row by row, in the order safe for overlap
+    // Rows with 1 leading byte, 960 / 8 = 120 bytes maximum
+    uint8_t source[2][128];
+    uint8_t target[2][128];
+    memset(source, 0x00, sizeof(source));
+
+    for (uint16_t k = first; k < last; k += 1)
+    {
+        uint16_t i = (targetRow1 > row1) ? (last - 1 - (k - first)) : k;
+
+        s_readRow(row1 + i, source[0] + 1, source[1] + 1);
+        s_readRow(targetRow1 + i, target[0], target[1]);
+
+        for (uint8_t plane = 0; plane < 2; plane += 1)
+        {
+            // 8 source bits for each target byte, leading byte as margin
+            uint16_t byte1 = targetBit1 >> 3;
+            uint16_t byte2 = (targetBit1 + bits - 1) >> 3;
+            for (uint16_t j = byte1; j <= byte2; j += 1)
+            {
+                uint16_t position = bit1 + 8 + j * 8 - targetBit1;
+                uint16_t index = position >> 3;
+                uint8_t shift = position % 8;
+                uint8_t value = source[plane][index] << shift;
+                if (shift > 0)
+                {
+                    value |= source[plane][index + 1] >> (8 - shift);
+                }
+
+                uint8_t mask = 0xff;
+                if (j == byte1)
+                {
+                    mask &= 0xff >> (targetBit1 % 8);
+                }
+                if (j == byte2)
+                {
+                    mask &= 0xff << (7 - ((targetBit1 + bits - 1) % 8));
+                }
+                target[plane][j] = (target[plane][j] & ~mask) | (value & mask);
+            }
+        }
+
+        s_writeRow(targetRow1 + i, target[0], target[1]);
+    }
+}
+
+void Screen_EPD_EXT3::s_readRow(uint16_t row, uint8_t * black, uint8_t * red)
+{
+    if ((u_codeSize == SIZE_969) or (u_codeSize == SIZE_1198))
+    {
+        uint16_t rowSize = u_bufferSizeH >> 1;
+        uint32_t z = (uint32_t)row * rowSize;
+        s_getBytes(z, black, red, rowSize);
+        s_getBytes((u_pageColourSize >> 1) + z, black + rowSize, red + rowSize, rowSize);
+    }
+    else
+    {
+        uint32_t z = (uint32_t)row * u_bufferSizeH;
+        s_getBytes(z, black, red, u_bufferSizeH);
+    }
+}
+
+void Screen_EPD_EXT3::s_writeRow(uint16_t row, const uint8_t * black, const uint8_t * red)
+{
+    if ((u_codeSize == SIZE_969) or (u_codeSize == SIZE_1198))
+    {
+        uint16_t rowSize = u_bufferSizeH >> 1;
+        uint32_t z = (uint32_t)row * rowSize;
+        s_setBytes(z, black, red, rowSize);
+        s_setBytes((u_pageColourSize >> 1) + z, black + rowSize, red + rowSize, rowSize);
+    }
+    else
+    {
+        uint32_t z = (uint32_t)row * u_bufferSizeH;
+        s_setBytes(z, black, red, u_bufferSizeH);
+    }
+}
+
+void Screen_EPD_EXT3::s_getBytes(uint32_t z, uint8_t * black, uint8_t * red, uint16_t length)
+{
+    if (u_planeStep > 1)
+    {
+        const uint8_t * source = s_newImage + (z << 1);
+        for (uint16_t i = 0; i < length; i += 1)
+        {
+            black[i] = source[0];
+            red[i] = source[1];
+            source += 2;
+        }
+    }
+    else
+    {
+        memcpy(black, s_newImage + z, length);
+        memcpy(red, s_newImage + u_pageColourSize + z, length);
+    }
+}
+
+void Screen_EPD_EXT3::s_setBytes(uint32_t z, const uint8_t * black, const uint8_t * red, uint16_t length)
+{
+    if (u_planeStep > 1)
+    {
+        uint8_t * target = s_newImage + (z << 1);
+        for (uint16_t i = 0; i < length; i += 1)
+        {
+            target[0] = black[i];
+            target[1] = red[i];
+            target += 2;
+        }
+    }
+    else
+    {
+        memcpy(s_newImage + z, black, length);
+        memcpy(s_newImage + u_pageColourSize + z, red, length);
+    }
+}
+
+void Screen_EPD_EXT3::s_mergeRow(uint16_t row, uint16_t t0, uint16_t number, const uint8_t * black, const uint8_t * red, uint16_t s0, const uint8_t * planes, uint8_t format)
+{
+    // Clipped to the band
+    if ((row < u_bandStart) or (row >= u_bandEnd))
+    {
+        return;
+    }
+
+    if ((u_codeSize == SIZE_969) or (u_codeSize == SIZE_1198))
+    {
+        uint16_t rowSize = u_bufferSizeH >> 1;
+        uint16_t half = v_screenSizeH >> 1;
+        uint32_t z = (uint32_t)row * rowSize;
+
+        // First half
+        if (t0 < half)
+        {
+            uint16_t bits = hV_HAL_min(number, (uint16_t)(half - t0));
+            s_mergeBits(s_newImage + z * u_planeStep, s_newImage + u_planeRed + z * u_planeStep, t0, bits, black, red, s0, planes, format);
+            s0 += bits;
+            number -= bits;
+            t0 = half;
+        }
+
+        // Second half
+        if (number > 0)
+        {
+            z += (u_pageColourSize >> 1);
+            s_mergeBits(s_newImage + z * u_planeStep, s_newImage + u_planeRed + z * u_planeStep, t0 - half, number, black, red, s0, planes, format);
+        }
+    }
+    else
+    {
+        uint32_t z = (uint32_t)row * u_bufferSizeH;
+        s_mergeBits(s_newImage + z * u_planeStep, s_newImage + u_planeRed + z * u_planeStep, t0, number, black, red, s0, planes, format);
+    }
+}
+
+void Screen_EPD_EXT3::s_mergeBits(uint8_t * targetBlack, uint8_t * targetRed, uint16_t t0, uint16_t number, const uint8_t * black, const uint8_t * red, uint16_t s0, const uint8_t * planes, uint8_t format)
+{
+    bool flagBWR = ((format & 0x0f) == BITMAP_BWR);
+    bool flagTransparent = ((format & BITMAP_TRANSPARENT) == BITMAP_TRANSPARENT);
+
+    uint16_t t1 = t0 + number - 1;
+    uint16_t k1 = t0 >> 3;
+    uint16_t k2 = t1 >> 3;
+
+    // Source bit for the first bit of the first target byte, leading byte included
+    uint16_t s = s0 + 8 - (t0 & 7);
+    uint16_t index = s >> 3;
+    uint8_t shift = s & 7;
+
+    // Same alignment, opaque black on white, planar layout
+    bool flagCopy = (shift == 0) and (not flagBWR) and (not flagTransparent) and (u_planeStep == 1);
+    flagCopy = flagCopy and (planes[0] == 0xff) and (planes[1] == 0x00) and (planes[2] == 0x00) and (planes[3] == 0x00);
+
+    uint16_t k = k1;
+    while (k <= k2)
+    {
+        uint8_t mask = 0xff;
+        if (k == k1)
+        {
+            mask &= 0xff >> (t0 & 7);
+        }
+        if (k == k2)
+        {
+            mask &= 0xff << (7 - (t1 & 7));
+        }
+
+        // Whole bytes
+        if (flagCopy and (mask == 0xff))
+        {
+            uint16_t length = ((t1 & 7) == 7) ? k2 - k + 1 : k2 - k;
+            memcpy(targetBlack + k, black + index, length);
+            s_fillBytes(targetRed + k, length, 0x00);
+            k += length;
+            index += length;
+            continue;
+        }
+
+        uint8_t valueBlack = (shift == 0) ? black[index] : (black[index] << shift) | (black[index + 1] >> (8 - shift));
+        uint8_t planeBlack;
+        uint8_t planeRed;
+
+        if (flagBWR)
+        {
+            uint8_t valueRed = (shift == 0) ? red[index] : (red[index] << shift) | (red[index + 1] >> (8 - shift));
+            uint8_t setBlack = valueBlack & ~valueRed;
+            uint8_t setWhite = ~(valueBlack | valueRed);
+
+            if (flagTransparent)
+            {
+                mask &= (valueBlack | valueRed);
+            }
+            planeBlack = (setBlack & planes[0]) | (setWhite & planes[2]) | (valueRed & planes[4]);
+            planeRed = (setBlack & planes[1]) | (setWhite & planes[3]) | (valueRed & planes[5]);
+        }
+        else
+        {
+            if (flagTransparent)
+            {
+                mask &= valueBlack;
+            }
+            planeBlack = (valueBlack & planes[0]) | (~valueBlack & planes[2]);
+            planeRed = (valueBlack & planes[1]) | (~valueBlack & planes[3]);
+        }
+
+        uint32_t z = (uint32_t)k * u_planeStep;
+        targetBlack[z] = (targetBlack[z] & ~mask) | (planeBlack & mask);
+        targetRed[z] = (targetRed[z] & ~mask) | (planeRed & mask);
+        k += 1;
+        index += 1;
+    }
+}
+
+void Screen_EPD_EXT3::s_reverseBits(uint8_t * pointer, uint16_t length)
+{
+    static const uint8_t nibbles[16] = {0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf};
+
+    for (uint16_t i = 0; i < length / 2; i += 1)
+    {
+        hV_HAL_swap(pointer[i], pointer[length - 1 - i]);
+    }
+
+    for (uint16_t i = 0; i < length; i += 1)
+    {
+        pointer[i] = (nibbles[pointer[i] & 0x0f] << 4) | nibbles[pointer[i] >> 4];
+    }
 }
 //
 // === End of Class section
@@ -13,7 +13,7 @@
 ///
 /// @author Rei Vilo
 /// @date 21 Feb 2025
-/// @version 820
+/// @version 821
 ///
 /// @copyright (c) Rei Vilo, 2010-2025
 /// @copyright All rights reserved
@@ -54,6 +54,12 @@
 // PDLS utilities
 #include "hV_Utilities_PDLS.h"
 
+// Compressed frame
+#include "hV_Frame_Codec.h"
+
+// Backing store
+#include "hV_Store.h"
+
 // Checks
 #if (hV_HAL_PERIPHERALS_RELEASE < 812)
 #error Required hV_HAL_PERIPHERALS_RELEASE 812
@@ -75,7 +81,7 @@
 ///
 /// @brief Library release number
 ///
-#define SCREEN_EPD_EXT3_RELEASE 820
+#define SCREEN_EPD_EXT3_RELEASE 821
 
 ///
 /// @brief Library variant
@@ -99,6 +105,108 @@
 #define eScreen_EPD_B98_GS_08 SCREEN(SIZE_1198, FILM_G, DRIVER_8) ///< reference xE2B98GS08x
 /// @}
 
+#ifndef STREAM_CHUNK_SIZE
+///
+/// @brief Chunk size for flushFromReader() and flushFromStream(), in bytes
+/// @note Allocated on the stack during the update
+///
+#define STREAM_CHUNK_SIZE 256
+#endif // STREAM_CHUNK_SIZE
+
+#ifndef TILE_CACHE_MAX
+///
+/// @brief Maximum number of tiles for setTileCache()
+/// @note Up to 32, one bit per tile for the dirty tiles
+///
+#define TILE_CACHE_MAX 8
+#endif // TILE_CACHE_MAX
+
+#if (TILE_CACHE_MAX > 32)
+#error Required TILE_CACHE_MAX up to 32
+#endif // TILE_CACHE_MAX
+
+#ifndef PANEL_CLOCK_DEFAULT
+///
+/// @brief SPI clock for the panel if no profile matches the screen, in Hz
+///
+#define PANEL_CLOCK_DEFAULT 8000000
+#endif // PANEL_CLOCK_DEFAULT
+
+#ifndef FLUSH_TIME_BANDS
+///
+/// @brief Number of temperature bands for estimateFlushTime(), 10 °C each from -20 °C
+///
+#define FLUSH_TIME_BANDS 8
+#endif // FLUSH_TIME_BANDS
+
+#ifndef FLUSH_BUSY_MONO
+///
+/// @brief BUSY time of a monochrome screen before the first measured update, in ms
+///
+#define FLUSH_BUSY_MONO 4000
+#endif // FLUSH_BUSY_MONO
+
+#ifndef FLUSH_BUSY_COLOUR
+///
+/// @brief BUSY time of a colour screen before the first measured update, in ms
+///
+#define FLUSH_BUSY_COLOUR 16000
+#endif // FLUSH_BUSY_COLOUR
+
+#ifndef POWER_WARM_CURRENT
+///
+/// @brief Current of the panel powered and idle, for getPowerStatistics(), in uA
+/// @note Rough default, to be replaced by a measurement on the actual board
+///
+#define POWER_WARM_CURRENT 200
+#endif // POWER_WARM_CURRENT
+
+#ifndef POWER_VOLTAGE
+///
+/// @brief Supply voltage of the panel, for getPowerStatistics(), in mV
+///
+#define POWER_VOLTAGE 3300
+#endif // POWER_VOLTAGE
+
+///
+/// @brief Check for calibratePanelClock()
+/// @param clock SPI clock under test, in Hz
+/// @return true if the panel behaved as expected
+///
+typedef bool (*clockCheck_t)(uint32_t clock);
+
+///
+/// @brief Statistics of the tile cache
+///
+struct tileStatistics_s
+{
+    uint32_t hits; ///< pixels drawn or read in a tile already cached
+    uint32_t misses; ///< tiles loaded from the frame-buffer
+    uint32_t writeBacks; ///< dirty tiles written back to the frame-buffer
+};
+
+///
+/// @brief Statistics of the power profile
+///
+struct powerStatistics_s
+{
+    uint32_t resumes; ///< resumes with GPIO or bus restarted
+    uint32_t suspends; ///< suspends with GPIO or bus stopped
+    uint32_t latency; ///< duration of the last resume, us
+    uint32_t latencyTotal; ///< duration of all the resumes, ms
+    uint32_t warmTime; ///< time with the panel powered and the GPIOs configured, ms
+    uint32_t energy; ///< estimated energy of the panel powered, uJ, from POWER_WARM_CURRENT and POWER_VOLTAGE
+};
+
+///
+/// @brief Reader for flushFromReader()
+/// @param buffer buffer to fill
+/// @param offset first byte to read, in the frame-buffer layout
+/// @param size number of bytes to read
+/// @return number of bytes read
+///
+typedef uint32_t (*frameReader_t)(uint8_t * buffer, uint32_t offset, uint32_t size);
+
 // Objects
 //
 ///
@@ -125,25 +233,195 @@ class Screen_EPD_EXT3 final : public hV_Screen_Buffer, public hV_Utilities_PDLS
 
     ///
     /// @brief Initialisation
-    /// @note Frame-buffer generated internally, not suitable for FRAM
+    /// @note Frame-buffer allocated in internal RAM, or as selected by setFrameBuffer()
     /// @warning begin() initialises SPI and I2C
+    /// @see setFrameBuffer() to select the frame-buffer storage and setFrameLayout() to select its layout
     ///
     void begin();
 
+    ///
+    /// @brief Select the frame-buffer storage
+    /// @param storage FRAMEBUFFER_INTERNAL, FRAMEBUFFER_STATIC, FRAMEBUFFER_PSRAM or FRAMEBUFFER_NONE
+    /// @param buffer buffer for FRAMEBUFFER_STATIC, aligned on 4 bytes, otherwise ignored
+    /// @param size size of the buffer, bytes
+    /// @return RESULT_SUCCESS or RESULT_ERROR
+    /// @note To be called before begin(), or after end().
+    /// @note The frame-buffer requires screenSizeX() * screenSizeY() / 4 bytes,
+    /// for example 152 * 296 / 4 = 11248 bytes for the 2.66".
+    /// @note If the storage is not available, begin() reports it and uses internal RAM instead.
+    /// @note With FRAMEBUFFER_NONE, the graphics and text functions draw nothing
+    /// and the display is updated with flushFromReader(), flushFromStream(),
+    /// flushFromCompressed() or flushFromStore().
+    /// @note On a computer, a memory-mapped file can be used as static buffer.
+    ///
+    uint8_t setFrameBuffer(uint8_t storage, uint8_t * buffer = nullptr, uint32_t size = 0);
+
+    ///
+    /// @brief Select the frame-buffer layout
+    /// @param layout FRAMEBUFFER_LAYOUT_PLANAR or FRAMEBUFFER_LAYOUT_INTERLEAVED
+    /// @return RESULT_SUCCESS or RESULT_ERROR
+    /// @note To be called before begin(), or after end().
+    /// @note With FRAMEBUFFER_LAYOUT_INTERLEAVED, the black and red bytes of the same 8 pixels
+    /// are next to each other, so drawing a pixel touches one cache line instead of two.
+    /// Recommended for the ESP32 PSRAM.
+    /// @note The interleaved frame-buffer is converted into the planar layout by chunks
+    /// when sent to the panel or saved with storeFrame(), and compressFrame() is not available.
+    ///
+    uint8_t setFrameLayout(uint8_t layout);
+
+    ///
+    /// @brief Set the tile cache in front of the frame-buffer
+    /// @param tiles number of tiles, 0 = no cache, up to TILE_CACHE_MAX
+    /// @return RESULT_SUCCESS or RESULT_ERROR
+    /// @note To be called before begin(), or after end().
+    /// @details A tile holds 8 native rows of both planes, in fast internal RAM.
+    /// Pixels are drawn into the tiles, and dirty tiles are written back to the frame-buffer
+    /// when evicted, before the block operations and before the update.
+    /// Areas and spans are filled into the cached tiles, and directly into the frame-buffer for the other rows.
+    /// @note Recommended when the frame-buffer is in PSRAM, for lines, circles and text.
+    /// @note Each tile takes screenSizeX() * screenSizeY() / 4 / (number of native rows / 8) bytes,
+    /// for example 304 bytes for the 2.66".
+    /// @note Not used by a screen initialised with beginShared().
+    ///
+    uint8_t setTileCache(uint8_t tiles);
+
+    ///
+    /// @brief Get the statistics of the tile cache
+    /// @return hits, misses and write-backs since begin() or resetTileStatistics()
+    ///
+    tileStatistics_s getTileStatistics();
+
+    ///
+    /// @brief Reset the statistics of the tile cache
+    ///
+    void resetTileStatistics();
+
+    ///
+    /// @brief Set the SPI clock of the panel
+    /// @param clock in Hz, 0 = profile of the screen, default
+    /// @details The profile depends on the screen family and driver.
+    /// @note For a board with long wires or a slower SPI, set a lower clock.
+    /// @note SPI is stopped, then restarted with the new clock by the next resume() or flush()
+    ///
+    void setPanelClock(uint32_t clock = 0);
+
+    ///
+    /// @brief Get the SPI clock of the panel
+    /// @return clock in Hz, set by setPanelClock() or from the profile
+    ///
+    uint32_t getPanelClock();
+
+    ///
+    /// @brief Calibrate the SPI clock of the panel
+    /// @param check function called after each clock, required
+    /// @return highest clock with the check passed, in Hz, 0 if none or without check
+    /// @details For each clock, rising, the panel is resumed if needed,
+    /// the frame-buffer is sent to the panel without update,
+    /// the throughput is reported, then check() is called with the clock still selected.
+    /// The calibration stops at the first clock failing the check.
+    /// @note Draw a pattern into the frame-buffer before.
+    /// check() can for example call flush() and return the result of a visual check.
+    /// @note The clock of the panel is not changed, call setPanelClock() with the result.
+    /// SPI is stopped, and the panel suspended with POWER_MODE_AUTO.
+    ///
+    uint32_t calibratePanelClock(clockCheck_t check);
+
+    ///
+    /// @brief Estimate the duration of an update
+    /// @param updateMode UPDATE_GLOBAL default, or UPDATE_FAST
+    /// @return duration in ms, 0 if no update is performed at the current temperature
+    /// @details Sum of
+    /// * the delays of the sequence of the screen family, including the DC/DC soft-start read from OTP,
+    /// * the transfer of both frames at the clock of getPanelClock(),
+    /// * the BUSY time for the band of the current temperature, learned from the previous updates.
+    /// @note Each update refines the model with a moving average.
+    /// Until an update is measured in the band of the temperature, the nearest measured band is used,
+    /// otherwise FLUSH_BUSY_MONO or FLUSH_BUSY_COLOUR.
+    /// @note The fast update is performed as a global update by this library, with the same duration.
+    /// @note The transfer time is learned only from the updates sent from the frame-buffer,
+    /// so updates without frame-buffer reading a slow source take longer than estimated.
+    ///
+    uint32_t estimateFlushTime(uint8_t updateMode = UPDATE_GLOBAL);
+
+    ///
+    /// @brief Get the measured duration of the last update
+    /// @return duration in ms, 0 if none
+    ///
+    uint32_t getFlushTime();
+
+    ///
+    /// @brief Forget the durations learned by estimateFlushTime()
+    ///
+    void resetFlushTime();
+
+    ///
+    /// @brief Release the frame-buffer
+    /// @details Memory allocated by begin() is freed.
+    /// A static buffer or the frame-buffer of a master screen is only released.
+    /// @note Call begin() again to restart.
+    ///
+    void end();
+
+    ///
+    /// @brief Initialisation with the frame-buffer of another screen
+    /// @param master screen already initialised with begin()
+    /// @details The screen renders into the frame-buffer of master,
+    /// usually with replay() and clipped to its band with setBand().
+    /// @note No GPIO, SPI or I2C initialisation
+    /// @warning Only master calls flush() and the power functions
+    /// @see @ref Concurrency
+    ///
+    void beginShared(Screen_EPD_EXT3 & master);
+
+    ///
+    /// @brief Restrict drawing to a band of the frame-buffer
+    /// @param index band, 0..number - 1, default = 0
+    /// @param number number of bands, default = 1 = whole frame-buffer
+    /// @details Bands split the native rows of the frame-buffer,
+    /// so two bands never share a byte and can be drawn at the same time by two cores.
+    /// @note Bands are independent from the orientation
+    ///
+    void setBand(uint8_t index = 0, uint8_t number = 1);
+
     ///
     /// @brief Suspend
-    /// @param suspendScope default = POWER_SCOPE_GPIO_ONLY, otherwise POWER_SCOPE_NONE
-    /// @details Power off and set all GPIOs low
-    /// @note If panelPower is NOT_CONNECTED, POWER_SCOPE_GPIO_ONLY defaults to POWER_SCOPE_NONE
+    /// @param suspendScope default = POWER_SCOPE_GPIO_ONLY, otherwise POWER_SCOPE_NONE or POWER_SCOPE_BUS_GPIO
+    /// @details Power off and set all GPIOs low, and with POWER_SCOPE_BUS_GPIO, turn SPI off
+    /// @note If panelPower is NOT_CONNECTED, the GPIOs are kept,
+    /// so POWER_SCOPE_GPIO_ONLY defaults to POWER_SCOPE_NONE and POWER_SCOPE_BUS_GPIO to the bus only
+    /// @warning With POWER_SCOPE_BUS_GPIO, other devices on the same SPI bus need to restart it
     ///
     void suspend(uint8_t suspendScope = POWER_SCOPE_GPIO_ONLY);
 
     ///
     /// @brief Resume after suspend()
     /// @details Turn SPI on and set all GPIOs levels
+    /// @note The duration is reported by getPowerStatistics()
     ///
     void resume();
 
+    ///
+    /// @brief Suspend after the idle timeout, for POWER_MODE_KEEP_WARM
+    /// @return true if suspended by this call
+    /// @details Once the timeout set by setPowerProfile() has elapsed since the last update,
+    /// the scope of the power profile is suspended.
+    /// @note To be called regularly, for example in loop().
+    /// An update before the timeout uses the interface as is, without resume.
+    ///
+    bool checkPowerIdle();
+
+    ///
+    /// @brief Get the statistics of the power profile
+    /// @return resumes, suspends, latency, time powered and estimated energy
+    /// since begin() or resetPowerStatistics()
+    ///
+    powerStatistics_s getPowerStatistics();
+
+    ///
+    /// @brief Reset the statistics of the power profile
+    ///
+    void resetPowerStatistics();
+
     ///
     /// @brief Who Am I
     /// @return Who Am I string
@@ -162,6 +440,8 @@ class Screen_EPD_EXT3 final : public hV_Screen_Buffer, public hV_Utilities_PDLS
     /// @note
     /// 1. Send the frame-buffer to the screen
     /// 2. Refresh the screen
+    /// @note The frame-buffer is read-only during flush()
+    /// @see @ref Concurrency
     ///
     void flush();
 
@@ -169,8 +449,123 @@ class Screen_EPD_EXT3 final : public hV_Screen_Buffer, public hV_Utilities_PDLS
     /// @brief Regenerate the panel
     /// @details White-to-black-to-white cycle to reduce ghosting
     /// @param mode default = UPDATE_GLOBAL = global mode
+    /// @param flagRestore true to update the panel with the frame-buffer after the cycle, default = false
+    /// @note The black and white frames are sent as constant bytes,
+    /// so the frame-buffer is neither read nor modified, and is not required.
+    /// @note Without flagRestore, the panel is left white while the frame-buffer keeps its content.
+    ///
+    void regenerate(uint8_t mode = UPDATE_GLOBAL, bool flagRestore = false);
+
+    ///
+    /// @brief Update the panel with one solid colour
+    /// @param colour white, black or red, default = white
+    /// @param mode default = UPDATE_GLOBAL = global mode
+    /// @return update mode performed, UPDATE_NONE if the colour is not solid
+    /// @note Same frames as clear(colour) then flushMode(mode), sent as constant bytes,
+    /// so the frame-buffer is neither read nor modified, and is not required.
+    /// @note Patterned colours, as grey, dark red and light red, are not solid.
+    ///
+    uint8_t flushSolid(uint16_t colour = myColours.white, uint8_t mode = UPDATE_GLOBAL);
+
+    ///
+    /// @brief Start recording the drawing commands
+    /// @param buffer caller-provided buffer
+    /// @param size size of the buffer, in bytes
+    /// @note The drawing mode is recorded with the other settings.
+    ///
+    void beginRecord(uint8_t * buffer, size_t size);
+
+    ///
+    /// @name Region raster operations
+    /// @details Performed on both colour planes in the native layout
+    /// @note setDrawMode() and invertArea() are recorded by beginRecord().
+    /// copyArea() and scrollArea() read the frame-buffer, so they are not recorded:
+    /// while recording, they are ignored and endRecord() returns RESULT_ERROR.
+    /// @{
+
+    ///
+    /// @brief Read a pixel
+    /// @param x1 point coordinate, x-axis
+    /// @param y1 point coordinate, y-axis
+    /// @return basic colour, white, black or red
+    /// @note Dithered colours are read as their basic colours
+    ///
+    uint16_t readPixel(uint16_t x1, uint16_t y1);
+
     ///
-    void regenerate(uint8_t mode = UPDATE_GLOBAL);
+    /// @brief Set the drawing mode
+    /// @param mode DRAW_MODE_NORMAL, DRAW_MODE_XOR or DRAW_MODE_INVERT, default = DRAW_MODE_NORMAL
+    /// @note With DRAW_MODE_XOR, drawing black twice restores the content,
+    /// and white leaves the content unchanged.
+    /// @note With DRAW_MODE_XOR and DRAW_MODE_INVERT, the corners of rectangles and the vertices of outlines are drawn once.
+    /// Solid polygons and triangles are filled without their outline,
+    /// so the bottom and right edges may be one pixel inside those of DRAW_MODE_NORMAL.
+    /// As for two lines, pixels where two edges cross or meet at an acute angle are drawn twice.
+    /// @note clear() always replaces the content.
+    ///
+    void setDrawMode(uint8_t mode = DRAW_MODE_NORMAL);
+
+    ///
+    /// @brief Get the drawing mode
+    /// @return DRAW_MODE_NORMAL, DRAW_MODE_XOR or DRAW_MODE_INVERT
+    ///
+    uint8_t getDrawMode();
+
+    ///
+    /// @brief Invert black and white in a region
+    /// @param x1 top left coordinate, x-axis
+    /// @param y1 top left coordinate, y-axis
+    /// @param x2 bottom right coordinate, x-axis
+    /// @param y2 bottom right coordinate, y-axis
+    /// @note Red pixels are unchanged
+    ///
+    void invertArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+
+    ///
+    /// @brief Copy a region
+    /// @param x1 source top left coordinate, x-axis
+    /// @param y1 source top left coordinate, y-axis
+    /// @param x2 source bottom right coordinate, x-axis
+    /// @param y2 source bottom right coordinate, y-axis
+    /// @param x0 target top left coordinate, x-axis
+    /// @param y0 target top left coordinate, y-axis
+    /// @note Source and target may overlap
+    ///
+    void copyArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x0, uint16_t y0);
+
+    ///
+    /// @brief Scroll a region
+    /// @param x1 top left coordinate, x-axis
+    /// @param y1 top left coordinate, y-axis
+    /// @param x2 bottom right coordinate, x-axis
+    /// @param y2 bottom right coordinate, y-axis
+    /// @param dx pixels to move along x-axis, positive = right
+    /// @param dy pixels to move along y-axis, positive = down
+    /// @param colour colour for the uncovered area, default = white
+    /// @note Rows moved with memmove() when the region spans the native rows
+    ///
+    void scrollArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, int16_t dx, int16_t dy, uint16_t colour = myColours.white);
+    /// @}
+
+    ///
+    /// @brief Draw a bitmap
+    /// @param x0 top left coordinate, x-axis
+    /// @param y0 top left coordinate, y-axis
+    /// @param dx width of the bitmap, pixels
+    /// @param dy height of the bitmap, pixels
+    /// @param data bitmap, in RAM or with BITMAP_FLASH in Flash
+    /// @param format BITMAP_MONO or BITMAP_BWR, combined with BITMAP_TRANSPARENT and BITMAP_FLASH, default = BITMAP_MONO
+    /// @param colour colour for set bits, default = black
+    /// @param backColour colour for clear bits, default = white
+    /// @note Clipped to the screen and to the band
+    /// @note Whole bytes copied when the bitmap and the frame-buffer share the same bit alignment,
+    /// shifted and merged otherwise.
+    /// Orientations 0 and 2 are row by row, orientations 1 and 3 column by column.
+    /// @note Pixel by pixel with dithered colours or with DRAW_MODE_XOR and DRAW_MODE_INVERT
+    /// @note Recorded by beginRecord() with a pointer to the data,
+    /// so the data must remain available until replay()
+    ///
+    void drawBitmap(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy, const uint8_t * data, uint8_t format = BITMAP_MONO, uint16_t colour = myColours.black, uint16_t backColour = myColours.white);
 
     ///
     /// @brief Update the display
@@ -181,6 +576,116 @@ class Screen_EPD_EXT3 final : public hV_Screen_Buffer, public hV_Utilities_PDLS
     ///
     uint8_t flushMode(uint8_t updateMode = UPDATE_GLOBAL);
 
+    ///
+    /// @name Update without frame-buffer
+    /// @details The image goes from the source to the panel in chunks of STREAM_CHUNK_SIZE bytes.
+    /// @n The image has the same layout as the frame-buffer:
+    /// black plane then red plane, screenSizeX() * screenSizeY() / 8 bytes each.
+    /// The red plane is not read for monochrome screens.
+    /// @note The frame-buffer is neither read nor modified.
+    /// @note Bytes are requested in increasing order, from the first byte of the black plane,
+    /// except for the 9.69" and 11.98" screens: the panel receives the first half of both planes,
+    /// then the second half of both planes.
+    /// @{
+
+    ///
+    /// @brief Update the display from a reader
+    /// @param reader function providing the bytes
+    /// @return RESULT_SUCCESS or RESULT_ERROR if bytes are missing or if no update is performed
+    /// @note Missing bytes are sent as 0x00
+    ///
+    uint8_t flushFromReader(frameReader_t reader);
+
+    ///
+    /// @brief Update the display from a stream
+    /// @param stream stream providing the bytes, for example serial port or file
+    /// @return RESULT_SUCCESS or RESULT_ERROR if bytes are missing or if no update is performed
+    /// @note Read with readBytes() and the timeout of the stream.
+    /// Once the stream has timed out, remaining bytes are sent as 0x00 without waiting.
+    /// @note The stream is read once, so for the 9.69" and 11.98" screens,
+    /// it provides the bytes in the panel order: first half of the black plane,
+    /// first half of the red plane, second half of the black plane, second half of the red plane.
+    ///
+    uint8_t flushFromStream(Stream & stream);
+
+    ///
+    /// @brief Update the display from a compressed image
+    /// @param data compressed image, see frameEncode()
+    /// @param size size of the compressed image, bytes
+    /// @return RESULT_SUCCESS or RESULT_ERROR if the image is invalid or truncated or if no update is performed
+    /// @note The image is decompressed in chunks while it is sent, without buffer.
+    /// @note The data is read directly, so it shall be in addressable memory,
+    /// for example a constant array on ESP32 or RP2040.
+    /// @note No update if the header is invalid or if the decompressed size differs from the frame-buffer size.
+    ///
+    uint8_t flushFromCompressed(const uint8_t * data, uint32_t size);
+
+    ///
+    /// @brief Compress the frame-buffer
+    /// @param buffer buffer for the compressed image
+    /// @param capacity size of the buffer, bytes
+    /// @return size of the compressed image, or 0 if the buffer is too small
+    /// @note The compressed image includes the black and red planes, as for the frame-buffer.
+    /// A buffer of frameEncodeBound(screenSizeX() * screenSizeY() / 4) bytes is always large enough.
+    /// @note The result is suitable for flushFromCompressed().
+    ///
+    uint32_t compressFrame(uint8_t * buffer, uint32_t capacity);
+
+    ///
+    /// @brief Update the display from a slot of a store
+    /// @param store backing store, initialised with a slot size of getFrameSize() bytes
+    /// @param slot slot with the frame, saved by storeFrame()
+    /// @return RESULT_SUCCESS or RESULT_ERROR if bytes are missing or if no update is performed
+    ///
+    uint8_t flushFromStore(hV_Store & store, uint16_t slot);
+
+    ///
+    /// @brief Save the frame-buffer into a slot of a store
+    /// @param store backing store, initialised with a slot size of getFrameSize() bytes
+    /// @param slot slot for the frame
+    /// @return RESULT_SUCCESS or RESULT_ERROR
+    /// @note The planar frame-buffer is copied in one block, without any other buffer,
+    /// and the interleaved frame-buffer by chunks of STREAM_CHUNK_SIZE bytes.
+    ///
+    uint8_t storeFrame(hV_Store & store, uint16_t slot);
+
+    ///
+    /// @brief Get the size of the frame
+    /// @return size of the black and red planes, bytes
+    /// @note Slot size for storeFrame() and flushFromStore().
+    ///
+    uint32_t getFrameSize();
+    /// @}
+
+    ///
+    /// @brief Export the frame-buffer as an image
+    /// @param output destination, for example serial port or file
+    /// @param format EXPORT_PBM_BLACK, EXPORT_PBM_RED or EXPORT_PPM, default = EXPORT_PPM
+    /// @param firstRow first row to export, default = 0
+    /// @param numberRows number of rows to export, default = all
+    /// @return number of bytes written, 0 if error
+    /// @note The image has screenSizeX() x screenSizeY() pixels in the current orientation,
+    /// whatever the native layout of the panel.
+    /// @note The header is written with the first row only, so the image can be exported in slices
+    /// by successive calls with increasing firstRow.
+    /// @note Pixels are written in chunks of STREAM_CHUNK_SIZE bytes, without allocation.
+    /// @note The frame-buffer is not modified.
+    ///
+    uint32_t exportImage(Print & output, uint8_t format = EXPORT_PPM, uint16_t firstRow = 0, uint16_t numberRows = 0xffff);
+
+    ///
+    /// @brief Export the events of the trace recorder
+    /// @param output destination, for example serial port or file
+    /// @return number of events exported
+    /// @details One line with the screen and the panel pins, then the events, see hV_HAL_trace_export()
+    /// @code
+    /// hV screen 152 296 family 1 film C dc 12 cs 17 css 14 busy 13 reset 11
+    /// @endcode
+    /// @note Start the recorder with hV_HAL_trace_begin() before flush().
+    /// @note The computer tool in extras/Trace_Replay rebuilds the timeline and the image.
+    ///
+    uint32_t exportTrace(Print & output);
+
   protected:
     /// @cond
 
@@ -208,6 +713,191 @@ class Screen_EPD_EXT3 final : public hV_Screen_Buffer, public hV_Utilities_PDLS
     ///
     void s_setPoint(uint16_t x1, uint16_t y1, uint16_t colour);
 
+    ///
+    /// @brief Fill an area, clipped to the band
+    /// @param x1 top left coordinate, x-axis
+    /// @param y1 top left coordinate, y-axis
+    /// @param x2 bottom right coordinate, x-axis, x2 >= x1
+    /// @param y2 bottom right coordinate, y-axis, y2 >= y1
+    /// @param colour 16-bit colour, including dithered colours
+    /// @note Patterns computed once per row parity, written with s_fillBytes()
+    ///
+    void s_fillArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour);
+
+    ///
+    /// @brief Replay a command of the screen
+    /// @param command RECORD_DRAW_MODE, RECORD_INVERT_AREA or RECORD_BITMAP
+    /// @param values parameters
+    /// @param data variable part
+    /// @param length number of bytes of the variable part
+    ///
+    void s_replay(uint8_t command, const uint16_t * values, const uint8_t * data, uint16_t length);
+
+    ///
+    /// @brief Convert an area into native coordinates
+    /// @param[in,out] x1 top left coordinate, x-axis, then first row
+    /// @param[in,out] y1 top left coordinate, y-axis, then first bit
+    /// @param[in,out] x2 bottom right coordinate, x-axis, then last row
+    /// @param[in,out] y2 bottom right coordinate, y-axis, then last bit
+    /// @return RESULT_ERROR if the area is outside the screen or the band, or without frame-buffer
+    ///
+    bool s_getNativeArea(uint16_t & x1, uint16_t & y1, uint16_t & x2, uint16_t & y2);
+
+    ///
+    /// @brief Fill an area, native coordinates, both halves for large screens
+    /// @param row1 first row
+    /// @param row2 last row, included
+    /// @param y1 first bit
+    /// @param y2 last bit, included
+    /// @param patternBlack black plane patterns for even and odd rows
+    /// @param patternRed red plane patterns for even and odd rows
+    /// @param mode DRAW_MODE_NORMAL, DRAW_MODE_XOR or DRAW_MODE_INVERT
+    ///
+    void s_fillNativeHalves(uint16_t row1, uint16_t row2, uint16_t y1, uint16_t y2, const uint8_t * patternBlack, const uint8_t * patternRed, uint8_t mode);
+
+    ///
+    /// @brief Fill an area, native coordinates
+    /// @param offset first byte of the half, for large screens
+    /// @param rowSize number of bytes per row
+    /// @param row1 first row
+    /// @param row2 last row, included
+    /// @param y1 first bit, within the half
+    /// @param y2 last bit, within the half, included
+    /// @param patternBlack black plane patterns for even and odd rows
+    /// @param patternRed red plane patterns for even and odd rows
+    /// @param mode DRAW_MODE_NORMAL, DRAW_MODE_XOR or DRAW_MODE_INVERT
+    /// @note Rows already in the tile cache are filled there, the other rows in the frame-buffer
+    ///
+    void s_fillNative(uint32_t offset, uint16_t rowSize, uint16_t row1, uint16_t row2, uint16_t y1, uint16_t y2, const uint8_t * patternBlack, const uint8_t * patternRed, uint8_t mode);
+
+    ///
+    /// @brief Fill bytes with a pattern
+    /// @param pointer first byte
+    /// @param length number of bytes
+    /// @param pattern byte to repeat
+    /// @note Aligned 32-bit words, bytes for head and tail
+    ///
+    void s_fillBytes(uint8_t * pointer, uint32_t length, uint8_t pattern);
+
+    ///
+    /// @brief Exclusive-or bytes with a pattern
+    /// @param pointer first byte
+    /// @param length number of bytes
+    /// @param pattern byte to exclusive-or
+    /// @note Aligned 32-bit words, bytes for head and tail
+    ///
+    void s_xorBytes(uint8_t * pointer, uint32_t length, uint8_t pattern);
+
+    ///
+    /// @brief Invert black and white bytes, red unchanged
+    /// @param black first byte, black plane
+    /// @param red first byte, red plane
+    /// @param length number of bytes
+    /// @note 32-bit words if both planes share the same alignment
+    ///
+    void s_invertBytes(uint8_t * black, const uint8_t * red, uint32_t length);
+
+    ///
+    /// @brief Fill pairs of black and red bytes, interleaved layout
+    /// @param pointer first black byte
+    /// @param length number of pairs
+    /// @param patternBlack black plane byte
+    /// @param patternRed red plane byte
+    /// @param mode DRAW_MODE_NORMAL, DRAW_MODE_XOR or DRAW_MODE_INVERT
+    /// @note Aligned 32-bit words for DRAW_MODE_NORMAL
+    ///
+    void s_fillInterleaved(uint8_t * pointer, uint32_t length, uint8_t patternBlack, uint8_t patternRed, uint8_t mode);
+
+    ///
+    /// @brief Copy an area, native coordinates
+    /// @param row1 first source row
+    /// @param row2 last source row, included
+    /// @param bit1 first source bit
+    /// @param bit2 last source bit, included
+    /// @param targetRow1 first target row
+    /// @param targetBit1 first target bit
+    ///
+    void s_copyNative(uint16_t row1, uint16_t row2, uint16_t bit1, uint16_t bit2, uint16_t targetRow1, uint16_t targetBit1);
+
+    ///
+    /// @brief Read a native row, both halves for large screens
+    /// @param row row
+    /// @param[out] black black plane bytes
+    /// @param[out] red red plane bytes
+    ///
+    void s_readRow(uint16_t row, uint8_t * black, uint8_t * red);
+
+    ///
+    /// @brief Write a native row, both halves for large screens
+    /// @param row row
+    /// @param black black plane bytes
+    /// @param red red plane bytes
+    ///
+    void s_writeRow(uint16_t row, const uint8_t * black, const uint8_t * red);
+
+    ///
+    /// @brief Read consecutive bytes of both planes, any layout
+    /// @param z index of the first byte, planar layout
+    /// @param[out] black black plane bytes
+    /// @param[out] red red plane bytes
+    /// @param length number of bytes
+    ///
+    void s_getBytes(uint32_t z, uint8_t * black, uint8_t * red, uint16_t length);
+
+    ///
+    /// @brief Write consecutive bytes of both planes, any layout
+    /// @param z index of the first byte, planar layout
+    /// @param black black plane bytes
+    /// @param red red plane bytes
+    /// @param length number of bytes
+    ///
+    void s_setBytes(uint32_t z, const uint8_t * black, const uint8_t * red, uint16_t length);
+
+    ///
+    /// @brief Merge a bitmap row into a native row, both halves for large screens
+    /// @param row native row
+    /// @param t0 first native bit
+    /// @param number number of bits
+    /// @param black black plane bits, with a leading and a trailing byte
+    /// @param red red plane bits, with a leading and a trailing byte, BITMAP_BWR only
+    /// @param s0 first source bit, after the leading byte
+    /// @param planes black and red plane bytes for colour, back colour and red
+    /// @param format bitmap format
+    ///
+    void s_mergeRow(uint16_t row, uint16_t t0, uint16_t number, const uint8_t * black, const uint8_t * red, uint16_t s0, const uint8_t * planes, uint8_t format);
+
+    ///
+    /// @brief Merge bits into native bytes
+    /// @param targetBlack first byte of the native row, black plane, bytes u_planeStep apart
+    /// @param targetRed first byte of the native row, red plane, bytes u_planeStep apart
+    /// @param t0 first native bit
+    /// @param number number of bits
+    /// @param black black plane bits, with a leading and a trailing byte
+    /// @param red red plane bits, with a leading and a trailing byte, BITMAP_BWR only
+    /// @param s0 first source bit, after the leading byte
+    /// @param planes black and red plane bytes for colour, back colour and red
+    /// @param format bitmap format
+    /// @note Whole bytes copied when aligned with opaque black on white
+    ///
+    void s_mergeBits(uint8_t * targetBlack, uint8_t * targetRed, uint16_t t0, uint16_t number, const uint8_t * black, const uint8_t * red, uint16_t s0, const uint8_t * planes, uint8_t format);
+
+    ///
+    /// @brief Reverse the order of bits
+    /// @param pointer first byte
+    /// @param length number of bytes
+    /// @note Last bit of the last byte becomes first bit of the first byte
+    ///
+    void s_reverseBits(uint8_t * pointer, uint16_t length);
+
+    ///
+    /// @brief Planes for a basic colour
+    /// @param colour 16-bit colour, basic
+    /// @param[out] black black plane byte, 0x00 or 0xff
+    /// @param[out] red red plane byte, 0x00 or 0xff
+    /// @return RESULT_SUCCESS or RESULT_ERROR if the colour is not supported
+    ///
+    bool s_getPlanes(uint16_t colour, uint8_t & black, uint8_t & red);
+
     /// @brief Get point
     /// @param x1 x coordinate
     /// @param y1 y coordinate
@@ -232,12 +922,50 @@ class Screen_EPD_EXT3 final : public hV_Screen_Buffer, public hV_Utilities_PDLS
     ///
     void s_flush(uint8_t updateMode = UPDATE_GLOBAL);
 
+    ///
+    /// @brief Send one frame of the image
+    /// @param index register
+    /// @param offset first byte, in the frame-buffer layout
+    /// @param size number of bytes
+    /// @param select PANEL_CS_BOTH, PANEL_CS_MASTER or PANEL_CS_SLAVE, large screens only
+    /// @note From the planar frame-buffer, otherwise from the reader, the stream, the decoder,
+    /// the store or the interleaved frame-buffer in chunks, or constant bytes
+    ///
+    void s_sendFrame(uint8_t index, uint32_t offset, uint32_t size, uint8_t select = PANEL_CS_BOTH);
+
+    ///
+    /// @brief Update the screen with constant frames, without frame-buffer
+    /// @param black byte for the first frame, black plane
+    /// @param red byte for the second frame, red plane
+    /// @param updateMode update mode
+    /// @return update mode performed, UPDATE_NONE if none
+    /// @note Frames sent with b_sendIndexFixed() or b_sendIndexFixedSelect()
+    ///
+    uint8_t s_flushFixed(uint8_t black, uint8_t red, uint8_t updateMode);
+
+    ///
+    /// @brief Read bytes from the reader, the stream, the decoder, the store or the interleaved frame-buffer
+    /// @param buffer buffer to fill
+    /// @param offset first byte, in the frame-buffer layout
+    /// @param size number of bytes
+    /// @note Missing bytes set to 0x00 and u_frameResult set to RESULT_ERROR
+    ///
+    void s_readFrame(uint8_t * buffer, uint32_t offset, uint32_t size);
+
+    ///
+    /// @brief Read bytes from the frame-buffer, in the planar layout
+    /// @param buffer buffer to fill
+    /// @param offset first byte, in the planar layout
+    /// @param size number of bytes
+    ///
+    void s_readPlanes(uint8_t * buffer, uint32_t offset, uint32_t size);
+
     // Position
     ///
     /// @brief Convert
     /// @param x1 x-axis coordinate
     /// @param y1 y-axis coordinate
-    /// @return index for s_newImage[]
+    /// @return index for s_newImage[] of the black byte, red byte at index + u_planeRed
     ///
     uint32_t s_getZ(uint16_t x1, uint16_t y1);
 
@@ -260,12 +988,114 @@ class Screen_EPD_EXT3 final : public hV_Screen_Buffer, public hV_Utilities_PDLS
     // * Other functions specific to the screen
     uint8_t COG_data[128]; // OTP
 
+    uint16_t u_bandStart, u_bandEnd; // native rows, u_bandEnd excluded
+    uint8_t u_drawMode; // DRAW_MODE_NORMAL, DRAW_MODE_XOR or DRAW_MODE_INVERT
+
+    frameReader_t u_frameReader; // flushFromReader()
+    Stream * u_frameStream; // flushFromStream()
+    frameDecoder_s * u_frameDecoder; // flushFromCompressed()
+    uint32_t u_frameOffset; // next decompressed byte, flushFromCompressed()
+    hV_Store * u_frameStore; // flushFromStore()
+    uint16_t u_frameSlot;
+    bool u_frameFixed; // constant frames, see s_flushFixed()
+    uint8_t u_fixedBlack, u_fixedRed;
+    uint8_t u_frameResult; // RESULT_SUCCESS or RESULT_ERROR
+
+    // Frame-buffer storage
+    void s_allocateFrameBuffer();
+    void s_releaseFrameBuffer();
+    uint8_t u_frameStorage; // selected with setFrameBuffer()
+    uint8_t u_frameAllocated; // allocated by begin(), otherwise FRAMEBUFFER_NONE
+    uint8_t * u_frameBuffer; // FRAMEBUFFER_STATIC
+    uint32_t u_frameBufferSize;
+
+    // Frame-buffer layout
+    uint8_t u_frameLayout; // selected with setFrameLayout()
+    uint8_t u_planeStep; // distance between two bytes of the same plane, 1 planar or 2 interleaved
+    uint32_t u_planeRed; // distance between the black and the red bytes, u_pageColourSize planar or 1 interleaved
+
+    // Tile cache
+    ///
+    /// @brief Find the cached tile with a native row
+    /// @param row native row
+    /// @return tile, u_tileCount if the row is not cached
+    ///
+    uint8_t s_findTile(uint16_t row);
+
+    ///
+    /// @brief Get the cached tile with a native row, loaded if needed
+    /// @param row native row
+    /// @param flagDirty true if the tile is going to be modified
+    /// @return first byte of the tile, black plane, red plane at + u_tileRed
+    /// @note Rows of u_bufferSizeH bytes, both halves for large screens
+    ///
+    uint8_t * s_getTile(uint16_t row, bool flagDirty);
+
+    ///
+    /// @brief Write a dirty tile back to the frame-buffer, rows of the band only
+    /// @param tile tile
+    ///
+    void s_writeTile(uint8_t tile);
+
+    ///
+    /// @brief Write all the dirty tiles back to the frame-buffer and empty the cache
+    /// @note Called before any direct access to the frame-buffer
+    ///
+    void s_syncTiles();
+
+    void s_allocateTiles();
+    void s_releaseTiles();
+    uint8_t u_tileNumber; // selected with setTileCache()
+    uint8_t u_tileCount; // allocated by begin()
+    uint8_t * u_tileData;
+    uint32_t u_tileSize; // both planes
+    uint32_t u_tileRed; // distance between the black and the red bytes
+    uint16_t u_tileFirst[TILE_CACHE_MAX]; // first native row, 0xffff if free
+    uint32_t u_tileUses[TILE_CACHE_MAX]; // last use, for least recently used
+    uint32_t u_tileDirty; // one bit per tile
+    uint8_t u_tileLast; // last tile used
+    uint32_t u_tileClock;
+    tileStatistics_s u_tileStatistics;
+
+    // SPI clock
+    uint32_t u_panelClock; // set by setPanelClock(), 0 = profile
+
+    // Update duration
+    ///
+    /// @brief Estimate the delays of the DC/DC soft-start, from OTP
+    /// @param offsetFrame first stage in COG_data
+    /// @param commandTime delays of one command, in us
+    /// @return duration in us
+    ///
+    uint32_t s_estimateSoftStart(uint8_t offsetFrame, uint32_t commandTime);
+
+    ///
+    /// @brief Update the model of estimateFlushTime() with a measured update
+    /// @param duration duration of the update, without resume(), in ms
+    /// @note BUSY time taken from b_busyTime
+    /// @note Time per byte learned only when the frames are sent from the frame-buffer
+    ///
+    void s_learnFlushTime(uint32_t duration);
+
+    uint8_t s_getFlushBand(); // temperature band
+    uint32_t u_flushBusy[FLUSH_TIME_BANDS]; // learned BUSY time per temperature band, ms, 0 = none
+    uint32_t u_flushByteTime; // learned time per byte on top of the SPI clock, ns
+    uint32_t u_flushCount; // updates measured from the frame-buffer
+    uint32_t u_flushLast; // ms
+
+    // Power profile
+    powerStatistics_s u_powerStatistics;
+    uint32_t u_powerWarmStart; // ms, GPIOs on since
+    uint32_t u_powerIdleStart; // ms, last update
+    void s_countWarm(); // add the time powered since u_powerWarmStart
+
     void COG_LargeCJ_reset();
     void COG_LargeCJ_getDataOTP();
     void COG_LargeCJ_initial();
     void COG_LargeCJ_sendImageData();
     void COG_LargeCJ_update();
     void COG_LargeCJ_powerOff();
+    uint32_t COG_LargeCJ_estimate(bool flagReset);
 
     void COG_MediumCJ_reset();
     void COG_MediumCJ_getDataOTP();
@@ -273,6 +1103,7 @@ class Screen_EPD_EXT3 final : public hV_Screen_Buffer, public hV_Utilities_PDLS
     void COG_MediumCJ_sendImageData();
     void COG_MediumCJ_update();
     void COG_MediumCJ_powerOff();
+    uint32_t COG_MediumCJ_estimate(bool flagReset);
 
     void COG_SmallCJ_reset();
     void COG_SmallCJ_getDataOTP();
@@ -280,6 +1111,7 @@ class Screen_EPD_EXT3 final : public hV_Screen_Buffer, public hV_Utilities_PDLS
     void COG_SmallCJ_sendImageData();
     void COG_SmallCJ_update();
     void COG_SmallCJ_powerOff();
+    uint32_t COG_SmallCJ_estimate(bool flagReset);
 
     //
     // === Touch section
@@ -15,6 +15,10 @@
 // Release 801: Improved double-panel screen management
 // Release 804: Improved power management
 // Release 810: Added support for EXT4
+// Release 821: Added begin, data and end steps for streamed transfers
+// Release 821: Added fast GPIO handles for panelDC, panelCS and panelCSS
+// Release 821: Panel pins and delays recorded by the trace recorder
+// Release 821: Added time spent waiting for BUSY
 //
 
 // Library header
@@ -23,6 +27,11 @@
 hV_Board::hV_Board()
 {
     b_fsmPowerScreen = FSM_OFF;
+
+    // Resolved by b_resume()
+    hV_HAL_GPIO_define(b_fastDC, NOT_CONNECTED);
+    hV_HAL_GPIO_define(b_fastCS, NOT_CONNECTED);
+    hV_HAL_GPIO_define(b_fastCSS, NOT_CONNECTED);
 }
 
 void hV_Board::b_begin(pins_t board, uint8_t family, uint16_t delayCS)
@@ -40,24 +49,36 @@ void hV_Board::setPanelPowerPin(uint8_t panelPowerPin)
 
 void hV_Board::b_reset(uint32_t ms1, uint32_t ms2, uint32_t ms3, uint32_t ms4, uint32_t ms5)
 {
-    delay(ms1); // Wait for power stabilisation
-    digitalWrite(b_pin.panelReset, HIGH); // RESET = HIGH
-    delay(ms2);
-    digitalWrite(b_pin.panelReset, LOW); // RESET = LOW
-    delay(ms3);
-    digitalWrite(b_pin.panelReset, HIGH); // RESET = HIGH
-    delay(ms4);
-    digitalWrite(b_pin.panelCS, HIGH); // CS = HIGH, unselect
-    delay(ms5);
+    hV_HAL_delayMilliseconds(ms1); // Wait for power stabilisation
+    hV_HAL_GPIO_write(b_pin.panelReset, HIGH); // RESET = HIGH
+    hV_HAL_delayMilliseconds(ms2);
+    hV_HAL_GPIO_write(b_pin.panelReset, LOW); // RESET = LOW
+    hV_HAL_delayMilliseconds(ms3);
+    hV_HAL_GPIO_write(b_pin.panelReset, HIGH); // RESET = HIGH
+    hV_HAL_delayMilliseconds(ms4);
+    hV_HAL_GPIO_write(b_pin.panelCS, HIGH); // CS = HIGH, unselect
+    hV_HAL_delayMilliseconds(ms5);
 }
 
 void hV_Board::b_waitBusy(bool state)
 {
     // LOW = busy, HIGH = ready
+    if (hV_HAL_traceFlag)
+    {
+        hV_HAL_trace_record(TRACE_WAIT, b_pin.panelBusy, state);
+    }
+
+    uint32_t chrono = millis();
     while (digitalRead(b_pin.panelBusy) != state)
     {
         delay(32); // non-blocking
     }
+    b_busyTime += millis() - chrono;
+
+    if (hV_HAL_traceFlag)
+    {
+        hV_HAL_trace_record(TRACE_READY, b_pin.panelBusy, state);
+    }
 }
 
 void hV_Board::b_suspend()
@@ -67,7 +88,7 @@ void hV_Board::b_suspend()
         // Optional power circuit
         if (b_pin.panelPower != NOT_CONNECTED) // generic
         {
-            digitalWrite(b_pin.panelPower, LOW);
+            hV_HAL_GPIO_write(b_pin.panelPower, LOW);
         }
         b_fsmPowerScreen &= ~FSM_GPIO_MASK;
     }
@@ -85,27 +106,32 @@ void hV_Board::b_resume()
         if (b_pin.panelPower != NOT_CONNECTED) // generic
         {
             pinMode(b_pin.panelPower, OUTPUT);
-            digitalWrite(b_pin.panelPower, HIGH);
+            hV_HAL_GPIO_write(b_pin.panelPower, HIGH);
         }
 
         // Configure GPIOs
         pinMode(b_pin.panelBusy, INPUT);
 
         pinMode(b_pin.panelDC, OUTPUT);
-        digitalWrite(b_pin.panelDC, HIGH);
+        hV_HAL_GPIO_write(b_pin.panelDC, HIGH);
 
         pinMode(b_pin.panelReset, OUTPUT);
-        digitalWrite(b_pin.panelReset, HIGH);
+        hV_HAL_GPIO_write(b_pin.panelReset, HIGH);
 
         pinMode(b_pin.panelCS, OUTPUT);
-        digitalWrite(b_pin.panelCS, HIGH); // CS# = 1
+        hV_HAL_GPIO_write(b_pin.panelCS, HIGH); // CS# = 1
 
         if (b_pin.panelCSS != NOT_CONNECTED) // generic
         {
             pinMode(b_pin.panelCSS, OUTPUT);
-            digitalWrite(b_pin.panelCSS, HIGH);
+            hV_HAL_GPIO_write(b_pin.panelCSS, HIGH);
         }
 
+        // Fast handles for the send functions
+        hV_HAL_GPIO_define(b_fastDC, b_pin.panelDC);
+        hV_HAL_GPIO_define(b_fastCS, b_pin.panelCS);
+        hV_HAL_GPIO_define(b_fastCSS, b_pin.panelCSS);
+
         // External SPI memory
         if (b_pin.flashCS != NOT_CONNECTED) // generic
         {
@@ -169,125 +195,147 @@ void hV_Board::b_resume()
 
 void hV_Board::b_sendIndexFixed(uint8_t index, uint8_t data, uint32_t size)
 {
-    digitalWrite(b_pin.panelDC, LOW); // DC Low = Command
-    digitalWrite(b_pin.panelCS, LOW); // CS High = Select Master
+    hV_HAL_GPIO_clear(b_fastDC); // DC Low = Command
+    hV_HAL_GPIO_clear(b_fastCS); // CS High = Select Master
 
-    delayMicroseconds(b_delayCS);
+    hV_HAL_delayMicroseconds(b_delayCS);
     hV_HAL_SPI_transfer(index);
-    delayMicroseconds(b_delayCS);
+    hV_HAL_delayMicroseconds(b_delayCS);
 
-    digitalWrite(b_pin.panelDC, HIGH); // DC High = Data
+    hV_HAL_GPIO_set(b_fastDC); // DC High = Data
 
-    delayMicroseconds(b_delayCS);
+    hV_HAL_delayMicroseconds(b_delayCS);
     for (uint32_t i = 0; i < size; i++)
     {
         hV_HAL_SPI_transfer(data); // b_sendIndexFixed
     }
-    delayMicroseconds(b_delayCS);
+    hV_HAL_delayMicroseconds(b_delayCS);
 
-    digitalWrite(b_pin.panelCS, HIGH); // CS High = Unselect
+    hV_HAL_GPIO_set(b_fastCS); // CS High = Unselect
 }
 
 void hV_Board::b_sendIndexFixedSelect(uint8_t index, uint8_t data, uint32_t size, uint8_t select)
 {
-    digitalWrite(b_pin.panelDC, LOW); // DC Low = Command
+    hV_HAL_GPIO_clear(b_fastDC); // DC Low = Command
     b_select(select); // Select half of large screen
 
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    hV_HAL_delayMicroseconds(b_delayCS); // Longer delay for large screens
     hV_HAL_SPI_transfer(index);
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    hV_HAL_delayMicroseconds(b_delayCS); // Longer delay for large screens
 
-    digitalWrite(b_pin.panelDC, HIGH); // DC High = Data
+    hV_HAL_GPIO_set(b_fastDC); // DC High = Data
 
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    hV_HAL_delayMicroseconds(b_delayCS); // Longer delay for large screens
     for (uint32_t i = 0; i < size; i++)
     {
         hV_HAL_SPI_transfer(data); // b_sendIndexFixed
     }
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    hV_HAL_delayMicroseconds(b_delayCS); // Longer delay for large screens
 
-    digitalWrite(b_pin.panelCS, HIGH); // CS High = Unselect Master
+    hV_HAL_GPIO_set(b_fastCS); // CS High = Unselect Master
     if (b_pin.panelCSS != NOT_CONNECTED)
     {
-        digitalWrite(b_pin.panelCSS, HIGH); // CSS High = Unselect Slave
+        hV_HAL_GPIO_set(b_fastCSS); // CSS High = Unselect Slave
     }
 }
 
 void hV_Board::b_sendIndexData(uint8_t index, const uint8_t * data, uint32_t size)
 {
-    digitalWrite(b_pin.panelDC, LOW); // DC Low
-    digitalWrite(b_pin.panelCS, LOW); // CS Low
+    b_beginIndexData(index);
+    b_sendData(data, size);
+    b_endIndexData();
+}
+
+void hV_Board::b_beginIndexData(uint8_t index)
+{
+    hV_HAL_GPIO_clear(b_fastDC); // DC Low
+    hV_HAL_GPIO_clear(b_fastCS); // CS Low
     if (b_family == FAMILY_LARGE)
     {
         if (b_pin.panelCSS != NOT_CONNECTED)
         {
-            digitalWrite(b_pin.panelCSS, LOW);
+            hV_HAL_GPIO_clear(b_fastCSS);
         }
-        delayMicroseconds(450); // 450 + 50 = 500
+        hV_HAL_delayMicroseconds(450); // 450 + 50 = 500
     }
-    delayMicroseconds(b_delayCS);
+    hV_HAL_delayMicroseconds(b_delayCS);
     hV_HAL_SPI_transfer(index);
-    delayMicroseconds(b_delayCS);
+    hV_HAL_delayMicroseconds(b_delayCS);
     if (b_family == FAMILY_LARGE)
     {
         if (b_pin.panelCSS != NOT_CONNECTED)
         {
-            delayMicroseconds(450); // 450 + 50 = 500
-            digitalWrite(b_pin.panelCSS, HIGH);
+            hV_HAL_delayMicroseconds(450); // 450 + 50 = 500
+            hV_HAL_GPIO_set(b_fastCSS);
         }
     }
-    digitalWrite(b_pin.panelCS, HIGH); // CS High
-    digitalWrite(b_pin.panelDC, HIGH); // DC High
-    digitalWrite(b_pin.panelCS, LOW); // CS Low
+    hV_HAL_GPIO_set(b_fastCS); // CS High
+    hV_HAL_GPIO_set(b_fastDC); // DC High
+    hV_HAL_GPIO_clear(b_fastCS); // CS Low
     if (b_family == FAMILY_LARGE)
     {
         if (b_pin.panelCSS != NOT_CONNECTED)
         {
-            digitalWrite(b_pin.panelCSS, LOW); // CSS Low
-            delayMicroseconds(450); // 450 + 50 = 500
+            hV_HAL_GPIO_clear(b_fastCSS); // CSS Low
+            hV_HAL_delayMicroseconds(450); // 450 + 50 = 500
         }
     }
-    delayMicroseconds(b_delayCS);
+    hV_HAL_delayMicroseconds(b_delayCS);
+}
+
+void hV_Board::b_sendData(const uint8_t * data, uint32_t size)
+{
     for (uint32_t i = 0; i < size; i++)
     {
         hV_HAL_SPI_transfer(data[i]);
     }
-    delayMicroseconds(b_delayCS);
-    digitalWrite(b_pin.panelCS, HIGH); // CS High
+}
+
+void hV_Board::b_endIndexData()
+{
+    hV_HAL_delayMicroseconds(b_delayCS);
+    hV_HAL_GPIO_set(b_fastCS); // CS High
     if (b_family == FAMILY_LARGE)
     {
         if (b_pin.panelCSS != NOT_CONNECTED)
         {
-            delayMicroseconds(450); // 450 + 50 = 500
-            digitalWrite(b_pin.panelCSS, HIGH);
+            hV_HAL_delayMicroseconds(450); // 450 + 50 = 500
+            hV_HAL_GPIO_set(b_fastCSS);
         }
     }
-    delayMicroseconds(b_delayCS);
+    hV_HAL_delayMicroseconds(b_delayCS);
 }
 
 // Software SPI Master protocol setup
 void hV_Board::b_sendIndexDataSelect(uint8_t index, const uint8_t * data, uint32_t size, uint8_t select)
 {
-    digitalWrite(b_pin.panelDC, LOW); // DC Low = Command
+    b_beginIndexDataSelect(index, select);
+    b_sendData(data, size);
+    b_endIndexDataSelect();
+}
+
+void hV_Board::b_beginIndexDataSelect(uint8_t index, uint8_t select)
+{
+    hV_HAL_GPIO_clear(b_fastDC); // DC Low = Command
     b_select(select); // Select half of large screen
 
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    hV_HAL_delayMicroseconds(b_delayCS); // Longer delay for large screens
     hV_HAL_SPI_transfer(index);
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    hV_HAL_delayMicroseconds(b_delayCS); // Longer delay for large screens
 
-    digitalWrite(b_pin.panelDC, HIGH); // DC High = Data
+    hV_HAL_GPIO_set(b_fastDC); // DC High = Data
 
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
-    for (uint32_t i = 0; i < size; i++)
-    {
-        hV_HAL_SPI_transfer(data[i]);
-    }
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    hV_HAL_delayMicroseconds(b_delayCS); // Longer delay for large screens
+}
+
+void hV_Board::b_endIndexDataSelect()
+{
+    hV_HAL_delayMicroseconds(b_delayCS); // Longer delay for large screens
 
-    digitalWrite(b_pin.panelCS, HIGH); // CS high = Unselect Master
+    hV_HAL_GPIO_set(b_fastCS); // CS high = Unselect Master
     if (b_pin.panelCSS != NOT_CONNECTED)
     {
-        digitalWrite(b_pin.panelCSS, HIGH); // CSS High = Unselect Slave
+        hV_HAL_GPIO_set(b_fastCSS); // CSS High = Unselect Slave
     }
 }
 
@@ -297,77 +345,77 @@ void hV_Board::b_select(uint8_t select)
     {
         case PANEL_CS_MASTER:
 
-            digitalWrite(b_pin.panelCS, LOW); // CS Low = Select Master
+            hV_HAL_GPIO_clear(b_fastCS); // CS Low = Select Master
             if (b_pin.panelCSS != NOT_CONNECTED)
             {
-                digitalWrite(b_pin.panelCSS, HIGH); // CSS High = Unselect Slave
+                hV_HAL_GPIO_set(b_fastCSS); // CSS High = Unselect Slave
             }
             break;
 
         case PANEL_CS_SLAVE:
 
-            digitalWrite(b_pin.panelCS, HIGH); // CS high = Unselect Master
+            hV_HAL_GPIO_set(b_fastCS); // CS high = Unselect Master
             if (b_pin.panelCSS != NOT_CONNECTED)
             {
-                digitalWrite(b_pin.panelCSS, LOW); // CSS Low = Select Slave
+                hV_HAL_GPIO_clear(b_fastCSS); // CSS Low = Select Slave
             }
             break;
 
         default:
 
-            digitalWrite(b_pin.panelCS, LOW); // CS Low = Select Master
+            hV_HAL_GPIO_clear(b_fastCS); // CS Low = Select Master
             if (b_pin.panelCSS != NOT_CONNECTED)
             {
-                digitalWrite(b_pin.panelCSS, LOW); // CSS Low = Select Slave
+                hV_HAL_GPIO_clear(b_fastCSS); // CSS Low = Select Slave
             }
             break;
     }
 
     if (b_pin.panelCSS != NOT_CONNECTED)
     {
-        delayMicroseconds(450); // 450 + 50 = 500
+        hV_HAL_delayMicroseconds(450); // 450 + 50 = 500
     }
-    delayMicroseconds(b_delayCS); // Longer delay for large screens
+    hV_HAL_delayMicroseconds(b_delayCS); // Longer delay for large screens
 }
 
 void hV_Board::b_sendCommandDataSelect8(uint8_t command, uint8_t data, uint8_t select)
 {
-    digitalWrite(b_pin.panelDC, LOW); // LOW = command
+    hV_HAL_GPIO_clear(b_fastDC); // LOW = command
     b_select(select); // Select half of large screen
 
     hV_HAL_SPI_transfer(command);
 
-    digitalWrite(b_pin.panelDC, HIGH); // HIGH = data
+    hV_HAL_GPIO_set(b_fastDC); // HIGH = data
     hV_HAL_SPI_transfer(data);
 
-    digitalWrite(b_pin.panelCS, HIGH);
+    hV_HAL_GPIO_set(b_fastCS);
     if (b_pin.panelCSS != NOT_CONNECTED)
     {
-        digitalWrite(b_pin.panelCSS, HIGH);
+        hV_HAL_GPIO_set(b_fastCSS);
     }
 }
 
 void hV_Board::b_sendCommand8(uint8_t command)
 {
-    digitalWrite(b_pin.panelDC, LOW);
-    digitalWrite(b_pin.panelCS, LOW);
+    hV_HAL_GPIO_clear(b_fastDC);
+    hV_HAL_GPIO_clear(b_fastCS);
 
     hV_HAL_SPI_transfer(command);
 
-    digitalWrite(b_pin.panelCS, HIGH);
+    hV_HAL_GPIO_set(b_fastCS);
 }
 
 void hV_Board::b_sendCommandData8(uint8_t command, uint8_t data)
 {
-    digitalWrite(b_pin.panelDC, LOW); // LOW = command
-    digitalWrite(b_pin.panelCS, LOW);
+    hV_HAL_GPIO_clear(b_fastDC); // LOW = command
+    hV_HAL_GPIO_clear(b_fastCS);
 
     hV_HAL_SPI_transfer(command);
 
-    digitalWrite(b_pin.panelDC, HIGH); // HIGH = data
+    hV_HAL_GPIO_set(b_fastDC); // HIGH = data
     hV_HAL_SPI_transfer(data);
 
-    digitalWrite(b_pin.panelCS, HIGH);
+    hV_HAL_GPIO_set(b_fastCS);
 }
 
 //
@@ -140,11 +140,47 @@ class hV_Board
     ///
     void b_sendIndexDataSelect(uint8_t index, const uint8_t * data, uint32_t size, uint8_t select = PANEL_CS_BOTH);
 
+    ///
+    /// @brief Start sending data through SPI
+    /// @param index register
+    /// @note Followed by b_sendData() and b_endIndexData()
+    /// @note Same sequence as b_sendIndexData()
+    ///
+    void b_beginIndexData(uint8_t index);
+
+    ///
+    /// @brief Start sending data through SPI to selected half of large screen
+    /// @param index register
+    /// @param select default = PANEL_CS_BOTH, otherwise PANEL_CS_MASTER or PANEL_CS_SLAVE
+    /// @note Followed by b_sendData() and b_endIndexDataSelect()
+    /// @note Same sequence as b_sendIndexDataSelect()
+    ///
+    void b_beginIndexDataSelect(uint8_t index, uint8_t select = PANEL_CS_BOTH);
+
+    ///
+    /// @brief Send a chunk of data through SPI
+    /// @param data data
+    /// @param size number of bytes
+    /// @note Between b_beginIndexData() and b_endIndexData(), or their Select variants
+    ///
+    void b_sendData(const uint8_t * data, uint32_t size);
+
+    ///
+    /// @brief End sending data started with b_beginIndexData()
+    ///
+    void b_endIndexData();
+
+    ///
+    /// @brief End sending data started with b_beginIndexDataSelect()
+    ///
+    void b_endIndexDataSelect();
+
     ///
     /// @brief Wait for ready
     /// @details Wait for panelBusy signal to reach state
     /// @note Signal is busy until reaching state
     /// @param state to reach HIGH = default, LOW
+    /// @note Time spent added to b_busyTime
     ///
     void b_waitBusy(bool state = HIGH);
 
@@ -180,7 +216,8 @@ class hV_Board
 
     ///
     /// @brief Resume GPIOs
-    /// @details Turn on and configure all GPIOs
+    /// @details Turn on and configure all GPIOs,
+    /// and resolve the fast handles for panelDC, panelCS and panelCSS
     ///
     void b_resume();
 
@@ -188,6 +225,12 @@ class hV_Board
     uint16_t b_delayCS = 50; // ms
     uint8_t b_family;
     uint8_t b_fsmPowerScreen = FSM_OFF;
+    uint32_t b_busyTime = 0; // ms, added by b_waitBusy(), reset by the caller
+
+    // Fast handles, resolved by b_resume()
+    hV_HAL_GPIO_s b_fastDC;
+    hV_HAL_GPIO_s b_fastCS;
+    hV_HAL_GPIO_s b_fastCSS;
 
   private:
     /// @brief Select one half of large screens
@@ -61,7 +61,7 @@
 ///
 /// @author Rei Vilo
 /// @date 21 Feb 2025
-/// @version 820
+/// @version 821
 ///
 /// @copyright &copy; Rei Vilo, 2010-2025
 /// @copyright All rights reserved
@@ -95,6 +95,9 @@
 /// Examples are under the examples folders.
 ///
 /// * Common
+///     * Common_Benchmark.ino
+///     * Common_Cache.ino
+///     * Common_Console.ino
 ///     * Common_Colours.ino
 /// @image html T2_PALET.jpg
 /// @image latex T2_PALET.jpg width=8cm
@@ -132,4 +135,47 @@
 /// @image html BWRY_Contrasts.jpg
 /// @image latex BWRY_Contrasts.jpg width=8cm
 ///
+/// Tools for the computer are under the extras folder.
+///
+/// * Frame_Encoder.cpp compresses a raw image for flushFromCompressed()
+/// * Frame_Compare.cpp compares images from exportImage(), for example against golden images
+/// * Host_Stubs is a minimal Arduino core to build the library on the computer, for the tools below, with hooks to simulate the GPIOs and SPI
+/// * Render_Stress.cpp renders and flushes on two threads, to be built with ThreadSanitizer
+/// * Band_Scaling.cpp replays recorded commands on two bands and two threads, and reports the speed-up
+/// * Alloc_Count.cpp counts the heap allocations per frame of the text functions, with String, char array, F() and gTextf()
+/// * Stream_Identity.cpp checks flushFromReader(), flushFromStream() and flushFromCompressed() send the same bytes as flush()
+/// * SPI3_Emulator.cpp checks the 3-wire SPI, fast and conservative, against an emulated controller
+/// * Flush_Estimate.cpp compares estimateFlushTime() with the duration of flush() on a simulated panel, monochrome and colour
+///
 
+/// @page Concurrency Multi-core rendering
+///
+/// On dual-core MCUs such as ESP32 and RP2040, one core can render the next frame while the other core flushes the previous one to the panel. The library uses no lock: the application follows the ownership rules below.
+///
+/// @b Frame-buffer
+///
+/// * The frame-buffer belongs to the rendering core between two calls to flush(). Only this core calls the graphics and text functions.
+/// * When flush() starts, the frame-buffer belongs to the flushing core, which only reads it. The rendering core does not draw until flush() returns.
+/// * The hand-over is signalled by the application, with a release store on one side and an acquire load on the other side, for example a `std::atomic<bool>`, a FreeRTOS task notification or the RP2040 inter-core FIFO.
+/// * To render during a flush, the application renders into a second screen object or a second frame-buffer, and exchanges them at hand-over.
+/// * Render_Stress.cpp under the extras folder checks these rules on the computer.
+///
+/// @b Bands
+///
+/// * beginRecord() and endRecord() store the drawing commands into a caller-provided buffer, and replay() performs them.
+/// * A second screen started with beginShared() draws into the frame-buffer of the first one, without GPIO or bus.
+/// * setBand() restricts each screen to disjoint native rows, so both cores can replay the same commands at the same time.
+/// * The core calling flush() waits for the other core to complete, for example with the RP2040 inter-core FIFO, as in Common_Benchmark.ino.
+/// * Band_Scaling.cpp under the extras folder checks the bands on the computer, with two threads.
+///
+/// @b Bus
+///
+/// * The SPI, 3-wire SPI and Wire state lives in file-scope variables of hV_HAL_Peripherals.cpp, without lock.
+/// * Only the flushing core calls begin(), flush(), regenerate() and the power functions.
+///
+/// @b Utilities
+///
+/// * formatString() and utf2iso() use no global buffer and are reentrant.
+/// * formatBuffer() and utf2iso() with a char array write into a caller-provided buffer, with no allocation.
+/// * gTextf() and gTextUTF8() use the stack only.
+///
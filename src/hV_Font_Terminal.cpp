@@ -20,6 +20,7 @@
 // All rights reserved
 //
 // Release 803: Added types for string and frame-buffer
+// Release 821: Added char array with length for string functions
 //
 
 // Configuration
@@ -147,25 +148,20 @@ uint16_t hV_Font_Terminal::f_characterSizeY()
     return f_font.height;
 }
 
-uint16_t hV_Font_Terminal::f_stringSizeX(STRING_CONST_TYPE text)
+uint16_t hV_Font_Terminal::f_stringSizeX(const char * /* text */, size_t length)
 {
     uint16_t textWidth = 0;
-    uint8_t textLength = 0;
-
-    textLength = text.length();
+    uint16_t textLength = length;
 
     textWidth = (f_font.maxWidth + f_fontSpaceX) * textLength;
 
     return textWidth;
 }
 
-uint8_t hV_Font_Terminal::f_stringLengthToFitX(STRING_CONST_TYPE text, uint16_t pixels)
+uint8_t hV_Font_Terminal::f_stringLengthToFitX(const char * /* text */, size_t length, uint16_t pixels)
 {
     uint8_t index = 0;
-    uint16_t textWidth = 0;
-    uint8_t textLength = 0;
-
-    textLength = text.length();
+    uint8_t textLength = hV_HAL_min(length, (size_t)UINT8_MAX);
 
     // Monospaced font
     index = pixels / f_font.maxWidth - 1;
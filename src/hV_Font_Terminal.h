@@ -169,19 +169,21 @@ class hV_Font_Terminal
     ///
     /// @brief String size, x-axis
     /// @param text string to evaluate
+    /// @param length number of characters
     /// @return horizontal size of the string for current font, in pixels
     /// @n @b More: @ref Fonts
     ///
-    uint16_t f_stringSizeX(STRING_CONST_TYPE text);
+    uint16_t f_stringSizeX(const char * text, size_t length);
 
     ///
     /// @brief Number of characters to fit a size, x-axis
     /// @param text string to evaluate
+    /// @param length number of characters
     /// @param pixels number of pixels to fit in
     /// @return number of characters to be displayed inside the pixels
     /// @n @b More: @ref Fonts
     ///
-    uint8_t f_stringLengthToFitX(STRING_CONST_TYPE text, uint16_t pixels);
+    uint8_t f_stringLengthToFitX(const char * text, size_t length, uint16_t pixels);
 
     ///
     /// @brief Number of fonts
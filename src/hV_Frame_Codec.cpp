@@ -0,0 +1,222 @@
+//
+// hV_Frame_Codec.cpp
+// Library C++ code
+// ----------------------------------
+//
+// Project Pervasive Displays Library Suite
+// Based on highView technology
+//
+// Created by Rei Vilo, 21 Feb 2025
+//
+// Copyright (c) Rei Vilo, 2010-2025
+// Licence Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+// For exclusive use with Pervasive Displays screens
+//
+// See hV_Frame_Codec.h for references
+//
+// Release 821: Added compressed frame format
+//
+
+// Library header
+#include "hV_Frame_Codec.h"
+
+uint32_t frameEncodeBound(uint32_t size)
+{
+    // Worst case, only literals
+    return FRAME_CODEC_HEADER + size + (size + FRAME_CODEC_LITERAL_MAX - 1) / FRAME_CODEC_LITERAL_MAX;
+}
+
+uint32_t frameEncode(const uint8_t * source, uint32_t size, uint8_t * destination, uint32_t capacity)
+{
+    if (capacity < FRAME_CODEC_HEADER)
+    {
+        return 0;
+    }
+
+    // Header
+    destination[0] = 'h';
+    destination[1] = 'V';
+    destination[2] = 'Z';
+    destination[3] = FRAME_CODEC_VERSION;
+    destination[4] = (uint8_t)size;
+    destination[5] = (uint8_t)(size >> 8);
+    destination[6] = (uint8_t)(size >> 16);
+    destination[7] = (uint8_t)(size >> 24);
+
+    uint32_t out = FRAME_CODEC_HEADER;
+    uint32_t index = 0;
+    uint32_t literal = 0; // First byte of the pending literal
+
+    while (index <= size)
+    {
+        // Length of the run starting at index
+        uint32_t run = 0;
+        if (index < size)
+        {
+            uint32_t runMax = size - index;
+            if (runMax > FRAME_CODEC_LONG_MAX)
+            {
+                runMax = FRAME_CODEC_LONG_MAX;
+            }
+            run = 1;
+            while ((run < runMax) and (source[index + run] == source[index]))
+            {
+                run += 1;
+            }
+        }
+
+        // Pending literal closed by a run, by the end of data or when full
+        uint32_t length = index - literal;
+        if ((length > 0) and ((run >= FRAME_CODEC_RUN_MIN) or (index == size) or (length == FRAME_CODEC_LITERAL_MAX)))
+        {
+            if (out + 1 + length > capacity)
+            {
+                return 0;
+            }
+            destination[out] = (uint8_t)(length - 1);
+            memcpy(destination + out + 1, source + literal, length);
+            out += 1 + length;
+            literal = index;
+        }
+
+        if (index == size)
+        {
+            break;
+        }
+
+        if (run >= FRAME_CODEC_RUN_MIN)
+        {
+            if (run <= FRAME_CODEC_SHORT_MAX)
+            {
+                if (out + 2 > capacity)
+                {
+                    return 0;
+                }
+                destination[out] = (uint8_t)(0x80 + run - FRAME_CODEC_RUN_MIN);
+                destination[out + 1] = source[index];
+                out += 2;
+            }
+            else
+            {
+                if (out + 3 > capacity)
+                {
+                    return 0;
+                }
+                uint16_t extra = run - FRAME_CODEC_SHORT_MAX - 1;
+                destination[out] = (uint8_t)(0xc0 + (extra >> 8));
+                destination[out + 1] = (uint8_t)extra;
+                destination[out + 2] = source[index];
+                out += 3;
+            }
+            index += run;
+            literal = index;
+        }
+        else
+        {
+            index += 1;
+        }
+    }
+
+    return out;
+}
+
+bool frameDecodeBegin(frameDecoder_s & decoder, const uint8_t * data, uint32_t size)
+{
+    decoder.data = data;
+    decoder.size = size;
+    decoder.index = size;
+    decoder.total = 0;
+    decoder.count = 0;
+    decoder.value = 0x00;
+    decoder.flagRun = false;
+
+    if ((size < FRAME_CODEC_HEADER) or (data[0] != 'h') or (data[1] != 'V') or (data[2] != 'Z') or (data[3] != FRAME_CODEC_VERSION))
+    {
+        return false;
+    }
+
+    decoder.total = (uint32_t)data[4] | ((uint32_t)data[5] << 8) | ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24);
+    decoder.index = FRAME_CODEC_HEADER;
+    return true;
+}
+
+uint32_t frameDecode(frameDecoder_s & decoder, uint8_t * buffer, uint32_t size)
+{
+    const uint8_t * data = decoder.data;
+    uint32_t done = 0;
+
+    while (done < size)
+    {
+        // Next packet
+        if (decoder.count == 0)
+        {
+            if (decoder.index >= decoder.size)
+            {
+                break;
+            }
+
+            uint8_t control = data[decoder.index];
+            if (control < 0x80) // Literal
+            {
+                decoder.count = control + 1;
+                decoder.flagRun = false;
+                decoder.index += 1;
+            }
+            else if (control < 0xc0) // Short run
+            {
+                if (decoder.index + 2 > decoder.size)
+                {
+                    decoder.index = decoder.size;
+                    break;
+                }
+                decoder.count = control - 0x80 + FRAME_CODEC_RUN_MIN;
+                decoder.value = data[decoder.index + 1];
+                decoder.flagRun = true;
+                decoder.index += 2;
+            }
+            else // Long run
+            {
+                if (decoder.index + 3 > decoder.size)
+                {
+                    decoder.index = decoder.size;
+                    break;
+                }
+                decoder.count = ((uint16_t)(control - 0xc0) << 8) + data[decoder.index + 1] + FRAME_CODEC_SHORT_MAX + 1;
+                decoder.value = data[decoder.index + 2];
+                decoder.flagRun = true;
+                decoder.index += 3;
+            }
+        }
+
+        uint32_t length = size - done;
+        if (length > decoder.count)
+        {
+            length = decoder.count;
+        }
+
+        if (decoder.flagRun)
+        {
+            memset(buffer + done, decoder.value, length);
+        }
+        else
+        {
+            // Truncated literal
+            if (length > decoder.size - decoder.index)
+            {
+                length = decoder.size - decoder.index;
+                if (length == 0)
+                {
+                    decoder.count = 0;
+                    break;
+                }
+            }
+            memcpy(buffer + done, data + decoder.index, length);
+            decoder.index += length;
+        }
+
+        decoder.count -= length;
+        done += length;
+    }
+
+    return done;
+}
@@ -0,0 +1,111 @@
+///
+/// @file hV_Frame_Codec.h
+/// @brief Compressed frame format for highView Library Suite
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright All rights reserved
+/// @copyright For exclusive use with Pervasive Displays screens
+///
+/// * Basic edition: for hobbyists and for basic usage
+/// @n Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @see https://creativecommons.org/licenses/by-sa/4.0/
+///
+/// @n Consider the Evaluation or Commercial editions for professionals or organisations and for commercial usage
+///
+/// * Evaluation edition: for professionals or organisations, evaluation only, no commercial usage
+/// @n All rights reserved
+///
+/// * Commercial edition: for professionals or organisations, commercial usage
+/// @n All rights reserved
+///
+/// * Viewer edition: for professionals or organisations
+/// @n All rights reserved
+///
+/// * Documentation
+/// @n All rights reserved
+///
+
+// SDK
+#include "stdint.h"
+#include "string.h"
+
+// Constants
+#include "hV_List_Constants.h"
+
+#ifndef hV_FRAME_CODEC_RELEASE
+///
+/// @brief Library release number
+///
+#define hV_FRAME_CODEC_RELEASE 821
+
+///
+/// @name Compressed frame
+/// @details Run-length encoding tuned for 1-bit frames, with long runs of 0x00 and 0xff.
+/// @n A white page of 2 x 96 kB is compressed into less than 100 bytes.
+/// @note The code does not depend on the SDK, so it can be built for a computer,
+/// see extras/Frame_Encoder.
+///
+/// @{
+
+///
+/// @brief Decoder state
+/// @note Initialised by frameDecodeBegin()
+///
+struct frameDecoder_s
+{
+    const uint8_t * data; ///< compressed data
+    uint32_t size; ///< size of the compressed data, bytes
+    uint32_t index; ///< next compressed byte
+    uint32_t total; ///< size of the decompressed data, bytes, from the header
+    uint16_t count; ///< remaining bytes of the current packet
+    uint8_t value; ///< byte of the current run
+    bool flagRun; ///< current packet is a run
+};
+
+///
+/// @brief Maximum size of compressed data
+/// @param size size of the decompressed data, bytes
+/// @return maximum size of the compressed data, header included, bytes
+///
+uint32_t frameEncodeBound(uint32_t size);
+
+///
+/// @brief Compress a frame
+/// @param source decompressed data
+/// @param size size of the decompressed data, bytes
+/// @param destination buffer for the compressed data
+/// @param capacity size of the buffer, bytes
+/// @return size of the compressed data, header included, or 0 if the buffer is too small
+/// @note A buffer of frameEncodeBound(size) bytes is always large enough.
+///
+uint32_t frameEncode(const uint8_t * source, uint32_t size, uint8_t * destination, uint32_t capacity);
+
+///
+/// @brief Start decompressing a frame
+/// @param decoder decoder state
+/// @param data compressed data, header included
+/// @param size size of the compressed data, bytes
+/// @return true if the header is valid, false otherwise
+/// @note The compressed data shall remain available until the end of decoding.
+///
+bool frameDecodeBegin(frameDecoder_s & decoder, const uint8_t * data, uint32_t size);
+
+///
+/// @brief Decompress the next bytes
+/// @param decoder decoder state
+/// @param buffer buffer for the decompressed bytes
+/// @param size number of bytes to decompress
+/// @return number of bytes decompressed, less than size if the compressed data ends
+///
+uint32_t frameDecode(frameDecoder_s & decoder, uint8_t * buffer, uint32_t size);
+
+/// @}
+
+#endif // hV_FRAME_CODEC_RELEASE
@@ -25,11 +25,25 @@
 // Release 804: Improved power management
 // Release 805: Improved stability
 // Release 810: Added patches for some platforms
+// Release 821: Bus state restricted to file scope
+// Release 821: Added fast GPIO handles
+// Release 821: Added fast and calibrated 3-wire SPI with block read
+// Release 821: Added trace recorder
 //
 
 // Library header
 #include "hV_HAL_Peripherals.h"
 
+#if defined(ARDUINO_ARCH_ESP32)
+
+#include "soc/gpio_reg.h"
+
+#elif defined(ARDUINO_ARCH_RP2040)
+
+#include "hardware/structs/sio.h"
+
+#endif // ARDUINO_ARCH
+
 //
 // === General section
 //
@@ -48,25 +62,34 @@ struct _SPISettings_s
 ///
 /// @brief SPI settings for screen
 ///
-_SPISettings_s _settingScreen;
+static _SPISettings_s _settingScreen;
 #else
 ///
 /// @brief SPI settings for screen
 ///
-SPISettings _settingScreen;
+static SPISettings _settingScreen;
 #endif // ENERGIA
 
 #ifndef SPI_CLOCK_MAX
 #define SPI_CLOCK_MAX 16000000
 #endif
 
+static const uint8_t h_directionNone = 0xff; // Direction unknown, set on next transfer
+
 struct h_pinSPI3_t
 {
     uint8_t pinClock;
     uint8_t pinData;
+    uint8_t mode; // SPI3_MODE_FAST or SPI3_MODE_CONSERVATIVE
+    uint8_t direction; // INPUT, OUTPUT or h_directionNone
+    hV_HAL_GPIO_s fastClock;
+    hV_HAL_GPIO_s fastData;
+    uint16_t loopsWrite; // half period for write, calibrated
+    uint16_t loopsRead; // half period for read, calibrated
+    uint32_t nanosLoop; // ns per loop, 0 = not calibrated
 };
 
-h_pinSPI3_t h_pinSPI3;
+static h_pinSPI3_t h_pinSPI3 = {0, 0, SPI3_MODE_FAST, h_directionNone, {0, 0, nullptr, nullptr, nullptr}, {0, 0, nullptr, nullptr, nullptr}, 0, 0, 0}; // Pins set by hV_HAL_SPI3_begin()
 
 void hV_HAL_begin()
 {
@@ -86,6 +109,52 @@ void waitFor(uint8_t pin, uint8_t state)
         delay(32); // non-blocking
     }
 }
+
+void hV_HAL_GPIO_define(hV_HAL_GPIO_s & handle, uint8_t pin)
+{
+    // Default, digitalWrite()
+    handle.pin = pin;
+    handle.mask = 0;
+    handle.setRegister = nullptr;
+    handle.clearRegister = nullptr;
+    handle.inputRegister = nullptr;
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+    // Write-one-to-set and write-one-to-clear registers, atomic
+    if (pin < 32)
+    {
+        handle.mask = 1UL << pin;
+        handle.setRegister = (volatile uint32_t *)GPIO_OUT_W1TS_REG;
+        handle.clearRegister = (volatile uint32_t *)GPIO_OUT_W1TC_REG;
+        handle.inputRegister = (const volatile uint32_t *)GPIO_IN_REG;
+    }
+
+#if defined(GPIO_OUT1_W1TS_REG)
+
+    else if (pin < 64)
+    {
+        handle.mask = 1UL << (pin - 32);
+        handle.setRegister = (volatile uint32_t *)GPIO_OUT1_W1TS_REG;
+        handle.clearRegister = (volatile uint32_t *)GPIO_OUT1_W1TC_REG;
+        handle.inputRegister = (const volatile uint32_t *)GPIO_IN1_REG;
+    }
+
+#endif // GPIO_OUT1_W1TS_REG
+
+#elif defined(ARDUINO_ARCH_RP2040)
+
+    // Single-cycle IO set and clear registers, atomic
+    if (pin < 30)
+    {
+        handle.mask = 1UL << pin;
+        handle.setRegister = (volatile uint32_t *)&sio_hw->gpio_set;
+        handle.clearRegister = (volatile uint32_t *)&sio_hw->gpio_clr;
+        handle.inputRegister = (const volatile uint32_t *)&sio_hw->gpio_in;
+    }
+
+#endif // ARDUINO_ARCH
+}
 //
 // === End of GPIO section
 //
@@ -98,13 +167,169 @@ void waitFor(uint8_t pin, uint8_t state)
 // === End of Time section
 //
 
+//
+// === Trace section
+//
+bool hV_HAL_traceFlag = false;
+
+struct h_trace_t
+{
+    hV_HAL_traceEvent_s * events; // buffer
+    uint32_t size; // number of events in the buffer
+    uint32_t first; // oldest event
+    uint32_t count; // number of events recorded
+    uint32_t dropped; // number of events overwritten or not recorded
+    bool overwrite; // ring buffer or stop when full
+};
+
+static h_trace_t h_trace = {nullptr, 0, 0, 0, 0, true};
+
+bool hV_HAL_trace_begin(uint32_t events, bool overwrite)
+{
+    hV_HAL_trace_end();
+
+    if (events == 0)
+    {
+        return false;
+    }
+
+    h_trace.events = new hV_HAL_traceEvent_s[events];
+    if (h_trace.events == nullptr)
+    {
+        mySerial.println("hV * Trace buffer not allocated");
+        return false;
+    }
+
+    h_trace.size = events;
+    h_trace.overwrite = overwrite;
+    hV_HAL_trace_clear();
+    hV_HAL_traceFlag = true;
+    return true;
+}
+
+void hV_HAL_trace_end()
+{
+    hV_HAL_traceFlag = false;
+    if (h_trace.events != nullptr)
+    {
+        delete[] h_trace.events;
+        h_trace.events = nullptr;
+    }
+    h_trace.size = 0;
+    hV_HAL_trace_clear();
+}
+
+void hV_HAL_trace_clear()
+{
+    h_trace.first = 0;
+    h_trace.count = 0;
+    h_trace.dropped = 0;
+}
+
+uint32_t hV_HAL_trace_count()
+{
+    return h_trace.count;
+}
+
+void hV_HAL_trace_record(uint8_t kind, uint8_t pin, uint32_t value)
+{
+    if (h_trace.events == nullptr)
+    {
+        return;
+    }
+
+    // Same SPI byte as the last event, combined up to 256 times
+    if ((kind == TRACE_SPI) and (h_trace.count > 0))
+    {
+        uint32_t last = h_trace.first + h_trace.count - 1;
+        if (last >= h_trace.size)
+        {
+            last -= h_trace.size;
+        }
+
+        hV_HAL_traceEvent_s & event = h_trace.events[last];
+        if ((event.kind == TRACE_SPI) and ((event.value & 0x00ff) == value) and (event.value < 0xff00))
+        {
+            event.value += 0x0100;
+            return;
+        }
+    }
+
+    uint32_t index;
+    if (h_trace.count < h_trace.size)
+    {
+        index = h_trace.first + h_trace.count;
+        if (index >= h_trace.size)
+        {
+            index -= h_trace.size;
+        }
+        h_trace.count += 1;
+    }
+    else if (h_trace.overwrite)
+    {
+        // Oldest event overwritten
+        index = h_trace.first;
+        h_trace.first += 1;
+        if (h_trace.first == h_trace.size)
+        {
+            h_trace.first = 0;
+        }
+        h_trace.dropped += 1;
+    }
+    else
+    {
+        h_trace.dropped += 1;
+        return;
+    }
+
+    hV_HAL_traceEvent_s & event = h_trace.events[index];
+    event.time = micros();
+    event.kind = kind;
+    event.pin = pin;
+    event.value = (uint16_t)hV_HAL_min(value, (uint32_t)0xffff);
+}
+
+uint32_t hV_HAL_trace_export(Print & output)
+{
+    bool flagSaved = hV_HAL_traceFlag;
+    hV_HAL_traceFlag = false; // Paused
+    char line[48];
+
+    snprintf(line, sizeof(line), "hV trace 1 events %lu dropped %lu", (unsigned long)h_trace.count, (unsigned long)h_trace.dropped);
+    output.println(line);
+
+    uint32_t index = h_trace.first;
+    for (uint32_t i = 0; i < h_trace.count; i += 1)
+    {
+        hV_HAL_traceEvent_s & event = h_trace.events[index];
+        snprintf(line, sizeof(line), "%lu %c %u %u", (unsigned long)event.time, event.kind, event.pin, event.value);
+        output.println(line);
+
+        index += 1;
+        if (index == h_trace.size)
+        {
+            index = 0;
+        }
+    }
+
+    output.println("hV trace end");
+    hV_HAL_traceFlag = flagSaved;
+    return h_trace.count;
+}
+//
+// === End of Trace section
+//
+
 //
 // === SPI section
 //
-bool flagSPI = false; // Some SPI implementations require unique initialisation
+static bool flagSPI = false; // Some SPI implementations require unique initialisation
 
 void hV_HAL_SPI_begin(uint32_t speed)
 {
+    // Pins possibly shared with 3-wire SPI
+    h_pinSPI3.direction = h_directionNone;
+
     if (flagSPI != true)
     {
         _settingScreen = {speed, MSBFIRST, SPI_MODE0};
@@ -153,6 +378,11 @@ void hV_HAL_SPI_end()
 
 uint8_t hV_HAL_SPI_transfer(uint8_t data)
 {
+    if (hV_HAL_traceFlag)
+    {
+        hV_HAL_trace_record(TRACE_SPI, 0, data);
+    }
+
     return SPI.transfer(data);
 }
 
@@ -163,7 +393,7 @@ uint8_t hV_HAL_SPI_transfer(uint8_t data)
 //
 // === Wire section
 //
-bool flagWire = false; // Some Wire implementations require unique initialisation
+static bool flagWire = false; // Some Wire implementations require unique initialisation
 
 void hV_HAL_Wire_begin()
 {
@@ -193,7 +423,7 @@ void hV_HAL_Wire_end()
     if (flagWire == true)
     {
         Wire.end();
-        flagWire = true;
+        flagWire = false;
     }
 }
 
@@ -240,6 +470,89 @@ void hV_HAL_Wire_transfer(uint8_t address, uint8_t * dataWrite, size_t sizeWrite
 //
 // === 3-wire SPI section
 //
+#define SPI3_CALIBRATION_LOOPS 10000 ///< Number of loops for calibration
+
+///
+/// @brief Wait for a number of calibrated loops
+/// @param loops number of loops
+///
+static void h_SPI3_wait(uint16_t loops)
+{
+    for (volatile uint16_t i = 0; i < loops; i += 1)
+    {
+        // Empty
+    }
+}
+
+///
+/// @brief Set the direction of the data pin, only if changed
+/// @param direction INPUT or OUTPUT
+///
+static void h_SPI3_direction(uint8_t direction)
+{
+    if (h_pinSPI3.direction == direction)
+    {
+        return;
+    }
+
+    pinMode(h_pinSPI3.pinClock, OUTPUT);
+    pinMode(h_pinSPI3.pinData, direction);
+    h_pinSPI3.direction = direction;
+}
+
+///
+/// @brief Set a pin HIGH, not recorded by the trace recorder
+/// @param handle handle resolved by hV_HAL_GPIO_define()
+///
+static inline void h_SPI3_set(const hV_HAL_GPIO_s & handle)
+{
+    if (handle.setRegister != nullptr)
+    {
+        *handle.setRegister = handle.mask;
+    }
+    else
+    {
+        digitalWrite(handle.pin, HIGH);
+    }
+}
+
+///
+/// @brief Set a pin LOW, not recorded by the trace recorder
+/// @param handle handle resolved by hV_HAL_GPIO_define()
+///
+static inline void h_SPI3_clear(const hV_HAL_GPIO_s & handle)
+{
+    if (handle.clearRegister != nullptr)
+    {
+        *handle.clearRegister = handle.mask;
+    }
+    else
+    {
+        digitalWrite(handle.pin, LOW);
+    }
+}
+
+///
+/// @brief Read a single byte, fast mode
+/// @return read byte
+/// @note Direction already set
+///
+static uint8_t h_SPI3_readFast()
+{
+    uint8_t value = 0;
+
+    for (uint8_t i = 0; i < 8; i += 1)
+    {
+        h_SPI3_set(h_pinSPI3.fastClock);
+        h_SPI3_wait(h_pinSPI3.loopsRead);
+        value = (value << 1) | hV_HAL_GPIO_read(h_pinSPI3.fastData);
+        h_SPI3_clear(h_pinSPI3.fastClock);
+        h_SPI3_wait(h_pinSPI3.loopsRead);
+    }
+
+    return value;
+}
+
 void hV_HAL_SPI3_begin()
 {
 #if defined(ARDUINO_XIAO_ESP32C3)
@@ -258,18 +571,48 @@ void hV_HAL_SPI3_begin()
     hV_HAL_SPI3_define(SCK, MOSI); // SCK SDA
 
 #endif // ARDUINO
+
+    // Calibrate once, ns per loop, rounded up
+    if (h_pinSPI3.nanosLoop == 0)
+    {
+        uint32_t chrono = micros();
+        h_SPI3_wait(SPI3_CALIBRATION_LOOPS);
+        chrono = micros() - chrono;
+
+        h_pinSPI3.nanosLoop = hV_HAL_max((chrono * 1000 + SPI3_CALIBRATION_LOOPS - 1) / SPI3_CALIBRATION_LOOPS, (uint32_t)1);
+    }
+
+    // Half period, rounded up, time of the GPIO access not deducted
+    h_pinSPI3.loopsWrite = (SPI3_PERIOD_WRITE_NS / 2 + h_pinSPI3.nanosLoop - 1) / h_pinSPI3.nanosLoop;
+    h_pinSPI3.loopsRead = (SPI3_PERIOD_READ_NS / 2 + h_pinSPI3.nanosLoop - 1) / h_pinSPI3.nanosLoop;
 }
 
 void hV_HAL_SPI3_define(uint8_t pinClock, uint8_t pinData)
 {
     h_pinSPI3.pinClock = pinClock;
     h_pinSPI3.pinData = pinData;
+    h_pinSPI3.direction = h_directionNone;
+    hV_HAL_GPIO_define(h_pinSPI3.fastClock, pinClock);
+    hV_HAL_GPIO_define(h_pinSPI3.fastData, pinData);
+}
+
+void hV_HAL_SPI3_setMode(uint8_t mode)
+{
+    h_pinSPI3.mode = mode;
+    h_pinSPI3.direction = h_directionNone;
 }
 
 uint8_t hV_HAL_SPI3_read()
 {
     uint8_t value = 0;
 
+    if (h_pinSPI3.mode == SPI3_MODE_FAST)
+    {
+        h_SPI3_direction(INPUT);
+        return h_SPI3_readFast();
+    }
+
+    h_pinSPI3.direction = h_directionNone;
     pinMode(h_pinSPI3.pinClock, OUTPUT);
     pinMode(h_pinSPI3.pinData, INPUT);
 
@@ -285,8 +628,50 @@ uint8_t hV_HAL_SPI3_read()
     return value;
 }
 
+void hV_HAL_SPI3_readBlock(uint8_t * buffer, uint16_t size)
+{
+    if (h_pinSPI3.mode == SPI3_MODE_FAST)
+    {
+        h_SPI3_direction(INPUT);
+        for (uint16_t index = 0; index < size; index += 1)
+        {
+            buffer[index] = h_SPI3_readFast();
+        }
+    }
+    else
+    {
+        for (uint16_t index = 0; index < size; index += 1)
+        {
+            buffer[index] = hV_HAL_SPI3_read();
+        }
+    }
+}
+
 void hV_HAL_SPI3_write(uint8_t value)
 {
+    if (h_pinSPI3.mode == SPI3_MODE_FAST)
+    {
+        h_SPI3_direction(OUTPUT);
+
+        for (uint8_t i = 0; i < 8; i += 1)
+        {
+            if ((value & (0x80 >> i)) != 0)
+            {
+                h_SPI3_set(h_pinSPI3.fastData);
+            }
+            else
+            {
+                h_SPI3_clear(h_pinSPI3.fastData);
+            }
+            h_SPI3_wait(h_pinSPI3.loopsWrite);
+            h_SPI3_set(h_pinSPI3.fastClock);
+            h_SPI3_wait(h_pinSPI3.loopsWrite);
+            h_SPI3_clear(h_pinSPI3.fastClock);
+        }
+        return;
+    }
+
+    h_pinSPI3.direction = h_directionNone;
     pinMode(h_pinSPI3.pinClock, OUTPUT);
     pinMode(h_pinSPI3.pinData, OUTPUT);
 
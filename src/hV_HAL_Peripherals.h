@@ -63,6 +63,10 @@
 
 ///
 /// @brief General initialisation
+/// @note The bus state is kept in file-scope variables, without lock.
+/// All the bus functions are to be called from the same core,
+/// the one performing flush().
+/// @see @ref Concurrency
 ///
 void hV_HAL_begin();
 
@@ -73,6 +77,239 @@ void hV_HAL_begin();
 ///
 void waitFor(uint8_t pin, uint8_t state = HIGH);
 
+///
+/// @name Trace recorder
+/// @details Timestamped events of the panel bus, recorded into a buffer
+/// allocated by hV_HAL_trace_begin() and exported over a Print or Stream
+/// * TRACE_SPI: byte sent with hV_HAL_SPI_transfer(), consecutive same bytes combined
+/// * TRACE_HIGH, TRACE_LOW: level set with hV_HAL_GPIO_set(), hV_HAL_GPIO_clear() or hV_HAL_GPIO_write()
+/// * TRACE_DELAY_MS, TRACE_DELAY_US: hV_HAL_delayMilliseconds() and hV_HAL_delayMicroseconds()
+/// * TRACE_WAIT, TRACE_READY: start and end of the wait for the BUSY signal
+/// @note When the recorder is off, each function checks one flag only.
+/// When on, each event takes one call to micros() and 8 bytes.
+/// @note The 3-wire SPI used to read the OTP memory is not recorded:
+/// its clock and data pins are set without hV_HAL_GPIO_set() and hV_HAL_GPIO_clear(),
+/// so the recorder neither fills the buffer nor changes the timing.
+/// @see extras/Trace_Replay for the computer tool
+/// @{
+
+#define TRACE_SPI 'S' ///< SPI byte, value = byte + ((count - 1) << 8)
+#define TRACE_HIGH 'H' ///< Pin set HIGH
+#define TRACE_LOW 'L' ///< Pin set LOW
+#define TRACE_DELAY_MS 'D' ///< Delay, value = ms
+#define TRACE_DELAY_US 'U' ///< Delay, value = us
+#define TRACE_WAIT 'W' ///< Start of wait, value = expected level
+#define TRACE_READY 'R' ///< End of wait, value = level reached
+
+///
+/// @brief Trace event
+///
+struct hV_HAL_traceEvent_s
+{
+    uint32_t time; ///< micros() when recorded
+    uint8_t kind; ///< TRACE_SPI, TRACE_HIGH, TRACE_LOW, TRACE_DELAY_MS, TRACE_DELAY_US, TRACE_WAIT or TRACE_READY
+    uint8_t pin; ///< pin for TRACE_HIGH, TRACE_LOW, TRACE_WAIT and TRACE_READY, 0 otherwise
+    uint16_t value; ///< see kind
+};
+
+/// @cond
+extern bool hV_HAL_traceFlag; // read only, set by hV_HAL_trace_begin() and hV_HAL_trace_end()
+/// @endcond
+
+///
+/// @brief Start the trace recorder
+/// @param events number of events in the buffer, 8 bytes each
+/// @param overwrite true = ring buffer, the newest events are kept, default;
+/// false = the recorder stops when the buffer is full
+/// @return true if the buffer is allocated
+///
+bool hV_HAL_trace_begin(uint32_t events, bool overwrite = true);
+
+///
+/// @brief Stop the trace recorder and release the buffer
+///
+void hV_HAL_trace_end();
+
+///
+/// @brief Remove the events recorded
+///
+void hV_HAL_trace_clear();
+
+///
+/// @brief Number of events recorded
+/// @return number of events in the buffer
+///
+uint32_t hV_HAL_trace_count();
+
+///
+/// @brief Record an event
+/// @param kind TRACE_SPI, TRACE_HIGH, TRACE_LOW, TRACE_DELAY_MS, TRACE_DELAY_US, TRACE_WAIT or TRACE_READY
+/// @param pin pin number, or 0
+/// @param value byte, level or duration, capped at 0xffff
+/// @note Called by the HAL functions when the recorder is on
+///
+void hV_HAL_trace_record(uint8_t kind, uint8_t pin, uint32_t value);
+
+///
+/// @brief Export the events as text
+/// @param output destination, for example serial port or file
+/// @return number of events exported
+/// @details One header line, one line per event, oldest first, then one end line
+/// @code
+/// hV trace 1 events 3 dropped 0
+/// 1200345 L 12 0
+/// 1200351 S 0 16
+/// 1200358 H 12 1
+/// hV trace end
+/// @endcode
+/// @note The recorder is paused during the export.
+///
+uint32_t hV_HAL_trace_export(Print & output);
+
+/// @}
+
+///
+/// @name Fast GPIO
+/// @details Handle resolved once, then the pin is set, cleared or read
+/// without the pin table lookup of digitalWrite() and digitalRead()
+/// * ESP32: GPIO_OUT_W1TS, GPIO_OUT_W1TC and GPIO_IN registers
+/// * RP2040: SIO gpio_set, gpio_clr and gpio_in registers
+/// * Other platforms: digitalWrite() and digitalRead()
+/// @note Configure the pin with pinMode() before
+/// @{
+
+///
+/// @brief Fast GPIO handle
+///
+struct hV_HAL_GPIO_s
+{
+    uint8_t pin; ///< pin number, for digitalWrite()
+    uint32_t mask; ///< bit of the pin in the registers
+    volatile uint32_t * setRegister; ///< register to set the pin, nullptr for digitalWrite()
+    volatile uint32_t * clearRegister; ///< register to clear the pin, nullptr for digitalWrite()
+    const volatile uint32_t * inputRegister; ///< register to read the pin, nullptr for digitalRead()
+};
+
+///
+/// @brief Resolve a fast GPIO handle
+/// @param[out] handle handle to resolve
+/// @param pin pin number
+/// @note Falls back to digitalWrite() and digitalRead() if the platform or the pin is not supported
+///
+void hV_HAL_GPIO_define(hV_HAL_GPIO_s & handle, uint8_t pin);
+
+///
+/// @brief Set the pin HIGH
+/// @param handle handle resolved by hV_HAL_GPIO_define()
+///
+inline void hV_HAL_GPIO_set(const hV_HAL_GPIO_s & handle)
+{
+    if (hV_HAL_traceFlag)
+    {
+        hV_HAL_trace_record(TRACE_HIGH, handle.pin, HIGH);
+    }
+
+    if (handle.setRegister != nullptr)
+    {
+        *handle.setRegister = handle.mask;
+    }
+    else
+    {
+        digitalWrite(handle.pin, HIGH);
+    }
+}
+
+///
+/// @brief Set the pin LOW
+/// @param handle handle resolved by hV_HAL_GPIO_define()
+///
+inline void hV_HAL_GPIO_clear(const hV_HAL_GPIO_s & handle)
+{
+    if (hV_HAL_traceFlag)
+    {
+        hV_HAL_trace_record(TRACE_LOW, handle.pin, LOW);
+    }
+
+    if (handle.clearRegister != nullptr)
+    {
+        *handle.clearRegister = handle.mask;
+    }
+    else
+    {
+        digitalWrite(handle.pin, LOW);
+    }
+}
+
+///
+/// @brief Set the level of a pin, recorded by the trace recorder
+/// @param pin pin number
+/// @param level HIGH or LOW
+/// @note Same as digitalWrite() otherwise
+///
+inline void hV_HAL_GPIO_write(uint8_t pin, uint8_t level)
+{
+    if (hV_HAL_traceFlag)
+    {
+        hV_HAL_trace_record((level == LOW) ? TRACE_LOW : TRACE_HIGH, pin, level);
+    }
+
+    digitalWrite(pin, level);
+}
+
+///
+/// @brief Read the pin
+/// @param handle handle resolved by hV_HAL_GPIO_define()
+/// @return HIGH or LOW
+///
+inline uint8_t hV_HAL_GPIO_read(const hV_HAL_GPIO_s & handle)
+{
+    if (handle.inputRegister != nullptr)
+    {
+        return ((*handle.inputRegister & handle.mask) != 0) ? HIGH : LOW;
+    }
+    else
+    {
+        return digitalRead(handle.pin);
+    }
+}
+
+/// @}
+
+///
+/// @name Time
+/// @note Same as delay() and delayMicroseconds(), recorded by the trace recorder
+/// @{
+
+///
+/// @brief Wait
+/// @param ms duration, ms
+///
+inline void hV_HAL_delayMilliseconds(uint32_t ms)
+{
+    if (hV_HAL_traceFlag)
+    {
+        hV_HAL_trace_record(TRACE_DELAY_MS, 0, ms);
+    }
+
+    delay(ms);
+}
+
+///
+/// @brief Wait
+/// @param us duration, us
+///
+inline void hV_HAL_delayMicroseconds(uint32_t us)
+{
+    if (hV_HAL_traceFlag)
+    {
+        hV_HAL_trace_record(TRACE_DELAY_US, 0, us);
+    }
+
+    delayMicroseconds(us);
+}
+
+/// @}
+
 ///
 /// @brief Configure and start SPI
 /// @param speed SPI speed in Hz, 8000000 = default
@@ -103,8 +340,32 @@ uint8_t hV_HAL_SPI_transfer(uint8_t data);
 /// * Arduino does not support 3-wire SPI, bit-bang simulation
 /// * Viewer: For compatibility only, not implemented in Linux
 /// @note hV_HAL_SPI3_begin() sets the pins for 3-wire SPI.
+/// @note Fast mode, default
+/// * Pins resolved as fast GPIO handles
+/// * Pin direction set only when it changes
+/// * Clock period calibrated against the minimum periods of the COG
+/// @note Conservative mode, fallback
+/// * digitalWrite(), digitalRead() and pinMode() for each byte
+/// * 1 us per clock edge
 /// @{
 
+///
+/// @brief Minimum clock period of the COG for write, ns
+///
+#ifndef SPI3_PERIOD_WRITE_NS
+#define SPI3_PERIOD_WRITE_NS 250
+#endif // SPI3_PERIOD_WRITE_NS
+
+///
+/// @brief Minimum clock period of the COG for read, ns
+///
+#ifndef SPI3_PERIOD_READ_NS
+#define SPI3_PERIOD_READ_NS 500
+#endif // SPI3_PERIOD_READ_NS
+
+#define SPI3_MODE_FAST 0 ///< 3-wire SPI with fast GPIO handles and calibrated timing, default
+#define SPI3_MODE_CONSERVATIVE 1 ///< 3-wire SPI with digitalWrite() and 1 us per edge
+
 #if defined(ENERGIA)
 
 #define SCK 7
@@ -115,6 +376,7 @@ uint8_t hV_HAL_SPI_transfer(uint8_t data);
 ///
 /// @brief Configure 3-wire SPI
 /// @note Select default SCK as clock and MOSI as data (SDIO)
+/// @note Calibrate the timing on first call
 ///
 void hV_HAL_SPI3_begin();
 
@@ -123,11 +385,18 @@ void hV_HAL_SPI3_begin();
 /// @param pinClock clock, default = SCK
 /// @param pinData combined data, default = MOSI
 /// @note For manual configuration only
+/// @note Resolve the fast GPIO handles
 /// @warning SCK and MOSI provided by Arduino SDK
 /// * Some boards require manual configuration
 ///
 void hV_HAL_SPI3_define(uint8_t pinClock = SCK, uint8_t pinData = MOSI);
 
+///
+/// @brief Select the 3-wire SPI mode
+/// @param mode SPI3_MODE_FAST default or SPI3_MODE_CONSERVATIVE
+///
+void hV_HAL_SPI3_setMode(uint8_t mode = SPI3_MODE_FAST);
+
 ///
 /// @brief Read a single byte
 /// @return read byte
@@ -136,6 +405,15 @@ void hV_HAL_SPI3_define(uint8_t pinClock = SCK, uint8_t pinData = MOSI);
 ///
 uint8_t hV_HAL_SPI3_read();
 
+///
+/// @brief Read a block of bytes
+/// @param[out] buffer bytes read
+/// @param size number of bytes
+/// @note Direction set once for the whole block
+/// @warning /CS to be managed externally.
+///
+void hV_HAL_SPI3_readBlock(uint8_t * buffer, uint16_t size);
+
 ///
 /// @brief Write a single byte
 /// @param data byte
@@ -94,7 +94,7 @@
 /// @{
 #define POWER_SCOPE_NONE 0x00 ///< Nothing suspended
 #define POWER_SCOPE_GPIO_ONLY 0x01 ///< GPIO only and if panelPower defined
-#define POWER_SCOPE_BUS_GPIO 0x11 ///< Both bus and GPIO suspended
+#define POWER_SCOPE_BUS_GPIO 0x11 ///< Both bus and GPIO suspended, GPIO only if panelPower defined
 /// @}
 
 ///
@@ -103,6 +103,13 @@
 /// @{
 #define POWER_MODE_AUTO 0x00 ///< Managed by the screen library
 #define POWER_MODE_MANUAL 0x01 ///< Managed by the application code
+#define POWER_MODE_KEEP_WARM 0x02 ///< Kept on after the update, suspended after the idle timeout
+/// @}
+
+///
+/// @name Idle timeout for power profile
+/// @{
+#define POWER_IDLE_DEFAULT 10000 ///< Default idle timeout for POWER_MODE_KEEP_WARM, ms
 /// @}
 
 ///
@@ -158,6 +165,83 @@
 /// @}
 ///
 
+///
+/// @name Drawing modes
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define DRAW_MODE_NORMAL 0 ///< Colour replaces existing content
+#define DRAW_MODE_XOR 1 ///< Colour planes exclusive-or'ed with existing content
+#define DRAW_MODE_INVERT 2 ///< Black and white inverted, colour ignored
+/// @}
+///
+
+///
+/// @name Bitmap formats
+/// @details One kind, combined with options
+/// @note Rows along x-axis, most significant bit on the left, (width + 7) / 8 bytes per row
+///
+/// @{
+#define BITMAP_MONO 0x01 ///< One plane, set bits with colour, clear bits with back colour
+#define BITMAP_BWR 0x02 ///< Black plane then red plane, red bits with red, black bits with colour, others with back colour
+#define BITMAP_TRANSPARENT 0x10 ///< Option, pixels with back colour not drawn
+#define BITMAP_FLASH 0x20 ///< Option, data in Flash read with pgm_read_byte()
+/// @}
+///
+
+///
+/// @name Compressed frame format
+/// @details Header, then packets, each packet starting with a control byte
+/// * header: 'h', 'V', 'Z', version, decompressed size on 4 bytes, little endian
+/// * control 0x00..0x7f: literal, (control + 1) bytes follow
+/// * control 0x80..0xbf: short run, one byte follows, repeated (control - 0x80 + 3) times
+/// * control 0xc0..0xff: long run, one length byte and one byte follow,
+/// repeated (((control - 0xc0) << 8) + length + 67) times
+/// @see frameEncode() and frameDecode()
+///
+/// @{
+#define FRAME_CODEC_VERSION 0x01 ///< Version of the format
+#define FRAME_CODEC_HEADER 8 ///< Size of the header, bytes
+#define FRAME_CODEC_LITERAL_MAX 128 ///< Maximum length of a literal
+#define FRAME_CODEC_RUN_MIN 3 ///< Minimum length of a run
+#define FRAME_CODEC_SHORT_MAX 66 ///< Maximum length of a short run
+#define FRAME_CODEC_LONG_MAX 16450 ///< Maximum length of a long run
+/// @}
+///
+
+///
+/// @name Frame-buffer storage
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define FRAMEBUFFER_INTERNAL 0 ///< Internal RAM, allocated by begin(), default
+#define FRAMEBUFFER_STATIC 1 ///< Buffer provided by the application
+#define FRAMEBUFFER_PSRAM 2 ///< ESP32 PSRAM, allocated by begin(), default with BOARD_HAS_PSRAM
+#define FRAMEBUFFER_NONE 3 ///< No frame-buffer, update with the functions without frame-buffer only
+/// @}
+///
+
+///
+/// @name Frame-buffer layout
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define FRAMEBUFFER_LAYOUT_PLANAR 0 ///< Black plane then red plane, default
+#define FRAMEBUFFER_LAYOUT_INTERLEAVED 1 ///< Black and red bytes of the same 8 pixels next to each other
+/// @}
+///
+
+///
+/// @name Export formats
+/// @note Numbers are sequential and exclusive
+///
+/// @{
+#define EXPORT_PBM_BLACK 0 ///< Binary PBM, black plane, 1 = bit set
+#define EXPORT_PBM_RED 1 ///< Binary PBM, red plane, 1 = bit set
+#define EXPORT_PPM 2 ///< Binary PPM, white, black and red pixels
+/// @}
+///
+
 ///
 /// @name Orientation constants
 /// @note Numbers are sequential and exclusive
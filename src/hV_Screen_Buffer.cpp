@@ -21,6 +21,14 @@
 // Release 703: Improved orientation function
 // Release 801: Improved functions names consistency
 // Release 805: Added large variant for gText()
+// Release 821: Added polygon() with edge table, replacing s_triangleArea()
+// Release 821: Added gTextScaled() with integer scaling and spans
+// Release 821: Added char array and Flash string variants for text, gTextf()
+// Release 821: Added gTextUTF8() with streaming decoder
+// Release 821: Added record and replay of drawing commands
+// Release 821: Added getFontSolid()
+// Release 821: Added getPenSolid()
+// Release 821: Each pixel drawn once by the primitives, for the toggling drawing modes
 //
 
 // Library header
@@ -35,6 +43,13 @@ hV_Screen_Buffer::hV_Screen_Buffer()
     f_fontSolid = true;
     f_fontSpaceX = 1;
     v_penSolid = false;
+
+    v_recordBuffer = 0; // nullptr
+    v_recordSize = 0;
+    v_recordLength = 0;
+    v_flagRecord = false;
+    v_recordOverflow = false;
+    v_flagToggle = false;
 }
 
 void hV_Screen_Buffer::begin()
@@ -90,6 +105,11 @@ void hV_Screen_Buffer::setOrientation(uint8_t orientation)
             s_setOrientation(v_orientation);
             break;
     }
+
+    if (v_flagRecord)
+    {
+        s_recordState();
+    }
 }
 
 uint8_t hV_Screen_Buffer::getOrientation()
@@ -149,12 +169,26 @@ uint8_t hV_Screen_Buffer::screenColourBits()
 
 void hV_Screen_Buffer::circle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t colour)
 {
+    if (v_flagRecord)
+    {
+        uint16_t values[] = {x0, y0, radius, colour};
+        s_record(RECORD_CIRCLE, values, 4);
+        return;
+    }
+
     int16_t f = 1 - radius;
     int16_t ddF_x = 1;
     int16_t ddF_y = -2 * radius;
     int16_t x = 0;
     int16_t y = radius;
 
+    if (radius == 0)
+    {
+        point(x0, y0, colour);
+        return;
+    }
+
+    // Each pixel drawn once, as required by the toggling drawing modes
     if (v_penSolid == false)
     {
         point(x0, y0 + radius, colour);
@@ -175,22 +209,62 @@ void hV_Screen_Buffer::circle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_
             ddF_x += 2;
             f += ddF_x;
 
+            // Past the diagonal, same points as the previous step
+            if (x > y)
+            {
+                break;
+            }
+
             point(x0 + x, y0 + y, colour);
             point(x0 - x, y0 + y, colour);
             point(x0 + x, y0 - y, colour);
             point(x0 - x, y0 - y, colour);
-            point(x0 + y, y0 + x, colour);
-            point(x0 - y, y0 + x, colour);
-            point(x0 + y, y0 - x, colour);
-            point(x0 - y, y0 - x, colour);
+
+            // On the diagonal, same points as above
+            if (x < y)
+            {
+                point(x0 + y, y0 + x, colour);
+                point(x0 - y, y0 + x, colour);
+                point(x0 + y, y0 - x, colour);
+                point(x0 - y, y0 - x, colour);
+            }
         }
     }
     else
     {
+        // First pass for the last step, x1 = last x, y1 = last y
+        int16_t x1 = 0;
+        int16_t y1 = radius;
+        while (x1 < y1)
+        {
+            if (f >= 0)
+            {
+                y1--;
+                ddF_y += 2;
+                f += ddF_y;
+            }
+
+            x1++;
+            ddF_x += 2;
+            f += ddF_x;
+        }
+
+        // Second pass, one span per row
+        f = 1 - radius;
+        ddF_x = 1;
+        ddF_y = -2 * radius;
+
         while (x < y)
         {
             if (f >= 0)
             {
+                // Rows beyond the last step, widest at the last x for this y
+                if (y > x1)
+                {
+                    s_fillSpan(x0 - x, x0 + x, y0 + y, colour);
+                    s_fillSpan(x0 - x, x0 + x, y0 - y, colour);
+                }
+
                 y--;
                 ddF_y += 2;
                 f += ddF_y;
@@ -200,14 +274,15 @@ void hV_Screen_Buffer::circle(uint16_t x0, uint16_t y0, uint16_t radius, uint16_
             ddF_x += 2;
             f += ddF_x;
 
-            line(x0 + x, y0 + y, x0 - x, y0 + y, colour); // bottom
-            line(x0 + x, y0 - y, x0 - x, y0 - y, colour); // top
-            line(x0 + y, y0 - x, x0 + y, y0 + x, colour); // right
-            line(x0 - y, y0 - x, x0 - y, y0 + x, colour); // left
+            // Rows up to the last step, widest at this y or at the last x
+            int16_t width = (x <= y1) ? hV_HAL_max(y, x1) : y;
+            if (x == 1)
+            {
+                s_fillSpan(x0 - hV_HAL_max(y, x1), x0 + hV_HAL_max(y, x1), y0, colour);
+            }
+            s_fillSpan(x0 - width, x0 + width, y0 + x, colour);
+            s_fillSpan(x0 - width, x0 + width, y0 - x, colour);
         }
-
-        setPenSolid(true);
-        rectangle(x0 - x, y0 - y, x0 + x, y0 + y, colour);
     }
 }
 
@@ -218,9 +293,28 @@ void hV_Screen_Buffer::dLine(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy,
 
 void hV_Screen_Buffer::line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
 {
+    if (v_flagRecord)
+    {
+        uint16_t values[] = {x1, y1, x2, y2, colour};
+        s_record(RECORD_LINE, values, 5);
+        return;
+    }
+
+    s_drawLine(x1, y1, x2, y2, colour);
+}
+
+void hV_Screen_Buffer::s_drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour, bool flagLast)
+{
+    // Last point, before swaps
+    uint16_t xLast = x2;
+    uint16_t yLast = y2;
+
     if ((x1 == x2) and (y1 == y2))
     {
-        s_setPoint(x1, y1, colour);
+        if (flagLast)
+        {
+            s_setPoint(x1, y1, colour);
+        }
     }
     else if (x1 == x2)
     {
@@ -230,7 +324,10 @@ void hV_Screen_Buffer::line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
         }
         for (uint16_t y = y1; y <= y2; y++)
         {
-            s_setPoint(x1, y, colour);
+            if (flagLast or (y != yLast))
+            {
+                s_setPoint(x1, y, colour);
+            }
         }
     }
     else if (y1 == y2)
@@ -241,7 +338,10 @@ void hV_Screen_Buffer::line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
         }
         for (uint16_t x = x1; x <= x2; x++)
         {
-            s_setPoint(x, y1, colour);
+            if (flagLast or (x != xLast))
+            {
+                s_setPoint(x, y1, colour);
+            }
         }
     }
     else
@@ -280,13 +380,11 @@ void hV_Screen_Buffer::line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
 
         for (; wx1 <= wx2; wx1++)
         {
-            if (flag)
+            uint16_t x = flag ? wy1 : wx1;
+            uint16_t y = flag ? wx1 : wy1;
+            if (flagLast or (x != xLast) or (y != yLast))
             {
-                s_setPoint(wy1, wx1, colour);
-            }
-            else
-            {
-                s_setPoint(wx1, wy1, colour);
+                s_setPoint(x, y, colour);
             }
 
             err -= dy;
@@ -302,40 +400,64 @@ void hV_Screen_Buffer::line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
 void hV_Screen_Buffer::setPenSolid(bool flag)
 {
     v_penSolid = flag;
+
+    if (v_flagRecord)
+    {
+        s_recordState();
+    }
 }
 
 void hV_Screen_Buffer::point(uint16_t x1, uint16_t y1, uint16_t colour)
 {
+    if (v_flagRecord)
+    {
+        uint16_t values[] = {x1, y1, colour};
+        s_record(RECORD_POINT, values, 3);
+        return;
+    }
+
     s_setPoint(x1, y1, colour);
 }
 
 void hV_Screen_Buffer::rectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
 {
-    if (v_penSolid == false)
+    if (v_flagRecord)
     {
-        line(x1, y1, x1, y2, colour);
-        line(x1, y1, x2, y1, colour);
-        line(x1, y2, x2, y2, colour);
-        line(x2, y1, x2, y2, colour);
+        uint16_t values[] = {x1, y1, x2, y2, colour};
+        s_record(RECORD_RECTANGLE, values, 5);
+        return;
     }
-    else
+
+    if (x1 > x2)
     {
-        if (x1 > x2)
-        {
-            hV_HAL_swap(x1, x2);
-        }
-        if (y1 > y2)
+        hV_HAL_swap(x1, x2);
+    }
+    if (y1 > y2)
+    {
+        hV_HAL_swap(y1, y2);
+    }
+
+    if (v_penSolid == false)
+    {
+        // Sides without shared corners, each pixel drawn once
+        s_drawLine(x1, y1, x2, y1, colour);
+        if (y2 > y1)
         {
-            hV_HAL_swap(y1, y2);
+            s_drawLine(x1, y2, x2, y2, colour);
         }
-        for (uint16_t x = x1; x <= x2; x++)
+        if (y2 > y1 + 1)
         {
-            for (uint16_t y = y1; y <= y2; y++)
+            s_drawLine(x1, y1 + 1, x1, y2 - 1, colour);
+            if (x2 > x1)
             {
-                s_setPoint(x, y, colour);
+                s_drawLine(x2, y1 + 1, x2, y2 - 1, colour);
             }
         }
     }
+    else
+    {
+        s_fillArea(x1, y1, x2, y2, colour);
+    }
 }
 
 void hV_Screen_Buffer::dRectangle(uint16_t x0, uint16_t y0, uint16_t dx, uint16_t dy, uint16_t colour)
@@ -343,108 +465,219 @@ void hV_Screen_Buffer::dRectangle(uint16_t x0, uint16_t y0, uint16_t dx, uint16_
     rectangle(x0, y0, x0 + dx - 1, y0 + dy - 1, colour);
 }
 
-void hV_Screen_Buffer::s_triangleArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t colour)
+void hV_Screen_Buffer::s_fillArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour)
 {
-    int16_t wx1 = (int16_t)x1;
-    int16_t wy1 = (int16_t)y1;
-    int16_t wx2 = (int16_t)x2;
-    int16_t wy2 = (int16_t)y2;
-    int16_t wx3 = (int16_t)x3;
-    int16_t wy3 = (int16_t)y3;
-    int16_t wx4 = wx1;
-    int16_t wy4 = wy1;
-    int16_t wx5 = wx1;
-    int16_t wy5 = wy1;
+    for (uint16_t y = y1; y <= y2; y++)
+    {
+        for (uint16_t x = x1; x <= x2; x++)
+        {
+            s_setPoint(x, y, colour);
+        }
+    }
+}
 
-    bool changed1 = false;
-    bool changed2 = false;
+void hV_Screen_Buffer::s_fillSpan(int32_t x1, int32_t x2, int32_t y1, uint16_t colour)
+{
+    int32_t sizeX = screenSizeX();
+    int32_t sizeY = screenSizeY();
 
-    int16_t dx1 = abs(wx2 - wx1);
-    int16_t dy1 = abs(wy2 - wy1);
+    x1 = hV_HAL_max(x1, (int32_t)0);
+    x2 = hV_HAL_min(x2, sizeX - 1);
+    if ((y1 < 0) or (y1 >= sizeY) or (x1 > x2))
+    {
+        return;
+    }
+    s_fillArea(x1, y1, x2, y1, colour);
+}
 
-    int16_t dx2 = abs(wx3 - wx1);
-    int16_t dy2 = abs(wy3 - wy1);
+void hV_Screen_Buffer::polygon(const point_s * points, uint16_t number, uint16_t colour)
+{
+    if (v_flagRecord)
+    {
+        uint16_t values[] = {number, colour};
+        s_record(RECORD_POLYGON, values, 2, points, number * sizeof(point_s));
+        return;
+    }
 
-    int16_t signx1 = (wx2 >= wx1) ? +1 : -1;
-    int16_t signx2 = (wx3 >= wx1) ? +1 : -1;
+    if (number == 0)
+    {
+        return;
+    }
 
-    int16_t signy1 = (wy2 >= wy1) ? +1 : -1;
-    int16_t signy2 = (wy3 >= wy1) ? +1 : -1;
+    // Outline, also closes the spans on the edges
+    // With the toggling drawing modes, solid polygon filled with the spans only
+    if ((v_penSolid == false) or (number < 3) or (v_flagToggle == false))
+    {
+        if (number < 3)
+        {
+            s_drawLine(points[0].x, points[0].y, points[number - 1].x, points[number - 1].y, colour);
+        }
+        else
+        {
+            // Each vertex drawn once, as first point of the next edge
+            for (uint16_t index = 0; index < number; index += 1)
+            {
+                const point_s & pointA = points[index];
+                const point_s & pointB = points[(index + 1) % number];
+                s_drawLine(pointA.x, pointA.y, pointB.x, pointB.y, colour, false);
+            }
+        }
+    }
 
-    if (dy1 > dx1)
+    if ((v_penSolid == false) or (number < 3))
     {
-        hV_HAL_swap(dx1, dy1); // swap values
-        changed1 = true;
+        return;
     }
 
-    if (dy2 > dx2)
+    // Edge table, small polygons on stack
+    // x and slope in 16.16 fixed point
+    struct edge_s
+    {
+        int32_t x; ///< x at current scan-line
+        int32_t slope; ///< x increment per scan-line
+        int16_t yTop; ///< first scan-line, included
+        int16_t yBottom; ///< last scan-line, excluded
+    };
+
+    edge_s edgesLocal[8];
+    uint16_t activeLocal[8];
+    edge_s * edges = edgesLocal;
+    uint16_t * active = activeLocal;
+    if (number > 8)
     {
-        hV_HAL_swap(dx2, dy2); // swap values
-        changed2 = true;
+        edges = new edge_s[number];
+        active = new uint16_t[number];
     }
 
-    int16_t e1 = 2 * dy1 - dx1;
-    int16_t e2 = 2 * dy2 - dx2;
+    uint16_t edgesNumber = 0;
+    int16_t yMin = INT16_MAX;
+    int16_t yMax = INT16_MIN;
 
-    for (int i = 0; i <= dx1; i++)
+    for (uint16_t index = 0; index < number; index += 1)
     {
-        line(wx4, wy4, wx5, wy5, colour);
+        int16_t xa = (int16_t)points[index].x;
+        int16_t ya = (int16_t)points[index].y;
+        int16_t xb = (int16_t)points[(index + 1) % number].x;
+        int16_t yb = (int16_t)points[(index + 1) % number].y;
 
-        while (e1 >= 0)
+        if (ya == yb) // Horizontal edges covered by the outline
         {
-            if (changed1)
-            {
-                wx4 += signx1;
-            }
-            else
-            {
-                wy4 += signy1;
-            }
-            e1 = e1 - 2 * dx1;
+            continue;
+        }
+        if (ya > yb)
+        {
+            hV_HAL_swap(xa, xb);
+            hV_HAL_swap(ya, yb);
         }
 
-        if (changed1)
+        // Insertion by ascending yTop
+        edge_s edge;
+        edge.slope = ((int32_t)(xb - xa) << 16) / (yb - ya);
+        edge.x = ((int32_t)xa << 16) + (1 << 15); // + 0.5 for rounding
+        edge.yTop = ya;
+        edge.yBottom = yb;
+
+        uint16_t position = edgesNumber;
+        while ((position > 0) and (edges[position - 1].yTop > ya))
         {
-            wy4 += signy1;
+            edges[position] = edges[position - 1];
+            position -= 1;
         }
-        else
+        edges[position] = edge;
+        edgesNumber += 1;
+
+        yMin = hV_HAL_min(yMin, ya);
+        yMax = hV_HAL_max(yMax, yb);
+    }
+
+    // Horizontal polygon, without spans
+    if ((edgesNumber == 0) and v_flagToggle)
+    {
+        uint16_t xMin = points[0].x;
+        uint16_t xMax = points[0].x;
+        for (uint16_t index = 1; index < number; index += 1)
         {
-            wx4 += signx1;
+            xMin = hV_HAL_min(xMin, points[index].x);
+            xMax = hV_HAL_max(xMax, points[index].x);
         }
+        s_fillSpan(xMin, xMax, points[0].y, colour);
+    }
 
-        e1 = e1 + 2 * dy1;
+    // Scan-lines, even-odd rule
+    uint16_t nextEdge = 0;
+    uint16_t activeNumber = 0;
 
-        while (wy5 != wy4)
+    for (int16_t y = yMin; y < yMax; y += 1)
+    {
+        // Add edges starting on this scan-line
+        while ((nextEdge < edgesNumber) and (edges[nextEdge].yTop == y))
         {
-            while (e2 >= 0)
+            active[activeNumber] = nextEdge;
+            activeNumber += 1;
+            nextEdge += 1;
+        }
+
+        // Remove edges ending on this scan-line
+        uint16_t kept = 0;
+        for (uint16_t index = 0; index < activeNumber; index += 1)
+        {
+            if (edges[active[index]].yBottom > y)
             {
-                if (changed2)
-                {
-                    wx5 += signx2;
-                }
-                else
-                {
-                    wy5 += signy2;
-                }
-                e2 = e2 - 2 * dx2;
+                active[kept] = active[index];
+                kept += 1;
             }
+        }
+        activeNumber = kept;
 
-            if (changed2)
+        // Sort by ascending x, few edges hence insertion sort
+        for (uint16_t index = 1; index < activeNumber; index += 1)
+        {
+            uint16_t work = active[index];
+            uint16_t position = index;
+            while ((position > 0) and (edges[active[position - 1]].x > edges[work].x))
             {
-                wy5 += signy2;
+                active[position] = active[position - 1];
+                position -= 1;
             }
-            else
+            active[position] = work;
+        }
+
+        // Spans, without the pixel shared by two spans
+        int16_t xDone = -1;
+        for (uint16_t index = 0; index + 1 < activeNumber; index += 2)
+        {
+            int16_t xa = hV_HAL_max((int16_t)(edges[active[index]].x >> 16), (int16_t)(xDone + 1));
+            int16_t xb = edges[active[index + 1]].x >> 16;
+            if ((xb >= xa) and (y >= 0))
             {
-                wx5 += signx2;
+                s_fillArea(hV_HAL_max(xa, 0), y, xb, y, colour);
+                xDone = xb;
             }
+        }
 
-            e2 = e2 + 2 * dy2;
+        // Next scan-line
+        for (uint16_t index = 0; index < activeNumber; index += 1)
+        {
+            edges[active[index]].x += edges[active[index]].slope;
         }
     }
+
+    if (number > 8)
+    {
+        delete [] edges;
+        delete [] active;
+    }
 }
 
 void hV_Screen_Buffer::triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t colour)
 {
+    if (v_flagRecord)
+    {
+        uint16_t values[] = {x1, y1, x2, y2, x3, y3, colour};
+        s_record(RECORD_TRIANGLE, values, 7);
+        return;
+    }
+
     if ((x1 == x2) and (y1 == y2))
     {
         line(x3, y3, x1, y1, colour);
@@ -457,65 +690,11 @@ void hV_Screen_Buffer::triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
     {
         line(x1, y1, x2, y2, colour);
     }
-    else if (v_penSolid)
-    {
-        bool b = true;
-
-        // Graham Scan + Andrew's Monotone Chain Algorithm
-        // Sort by ascending y
-        while (b)
-        {
-            b = false;
-            if ((b == false) and (y1 > y2))
-            {
-                hV_HAL_swap(x1, x2);
-                hV_HAL_swap(y1, y2);
-                b = true;
-            }
-            if ((b == false) and (y2 > y3))
-            {
-                hV_HAL_swap(x3, x2);
-                hV_HAL_swap(y3, y2);
-                b = true;
-            }
-        }
-
-        if (y2 == y3)
-        {
-            s_triangleArea(x1, y1, x2, y2, x3, y3, colour);
-        }
-        else if (y1 == y2)
-        {
-            s_triangleArea(x3, y3, x1, y1, x2, y2, colour);
-        }
-        else
-        {
-            uint16_t x4 = (uint16_t)((int32_t)x1 + (y2 - y1) * (x3 - x1) / (y3 - y1));
-            uint16_t y4 = y2;
-
-            s_triangleArea(x1, y1, x2, y2, x4, y4, colour);
-
-#if defined(ESP8266)
-            delay(1);
-#else
-            delayMicroseconds(1000); // delay(1);
-#endif // ESP8266
-
-            delayMicroseconds(1000); // delay(1);
-            s_triangleArea(x3, y3, x2, y2, x4, y4, colour);
-
-#if defined(ESP8266)
-            delay(1);
-#else
-            delayMicroseconds(1000); // delay(1);
-#endif // ESP8266
-        }
-    }
     else
     {
-        line(x1, y1, x2, y2, colour);
-        line(x2, y2, x3, y3, colour);
-        line(x3, y3, x1, y1, colour);
+        // Solid or outline, each vertex drawn once
+        point_s corners[3] = {{x1, y1}, {x2, y2}, {x3, y3}};
+        polygon(corners, 3, colour);
     }
 }
 
@@ -525,6 +704,21 @@ void hV_Screen_Buffer::triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
 void hV_Screen_Buffer::setFontSolid(bool flag)
 {
     f_setFontSolid(flag);
+
+    if (v_flagRecord)
+    {
+        s_recordState();
+    }
+}
+
+bool hV_Screen_Buffer::getFontSolid()
+{
+    return f_fontSolid;
+}
+
+bool hV_Screen_Buffer::getPenSolid()
+{
+    return v_penSolid;
 }
 
 uint8_t hV_Screen_Buffer::addFont(font_s fontName)
@@ -535,6 +729,11 @@ uint8_t hV_Screen_Buffer::addFont(font_s fontName)
 void hV_Screen_Buffer::selectFont(uint8_t font)
 {
     f_selectFont(font);
+
+    if (v_flagRecord)
+    {
+        s_recordState();
+    }
 }
 
 uint8_t hV_Screen_Buffer::getFont()
@@ -567,19 +766,44 @@ uint16_t hV_Screen_Buffer::characterSizeY()
     return f_characterSizeY();
 }
 
-uint16_t hV_Screen_Buffer::stringSizeX(String text)
+uint16_t hV_Screen_Buffer::stringSizeX(const String & text)
+{
+    return f_stringSizeX(text.c_str(), text.length());
+}
+
+uint16_t hV_Screen_Buffer::stringSizeX(const char * text)
+{
+    return f_stringSizeX(text, strlen(text));
+}
+
+uint16_t hV_Screen_Buffer::stringSizeX(const char * text, size_t length)
 {
-    return f_stringSizeX(text);
+    return f_stringSizeX(text, length);
 }
 
-uint8_t hV_Screen_Buffer::stringLengthToFitX(String text, uint16_t pixels)
+uint8_t hV_Screen_Buffer::stringLengthToFitX(const String & text, uint16_t pixels)
 {
-    return f_stringLengthToFitX(text, pixels);
+    return f_stringLengthToFitX(text.c_str(), text.length(), pixels);
+}
+
+uint8_t hV_Screen_Buffer::stringLengthToFitX(const char * text, uint16_t pixels)
+{
+    return f_stringLengthToFitX(text, strlen(text), pixels);
+}
+
+uint8_t hV_Screen_Buffer::stringLengthToFitX(const char * text, size_t length, uint16_t pixels)
+{
+    return f_stringLengthToFitX(text, length, pixels);
 }
 
 void hV_Screen_Buffer::setFontSpaceX(uint8_t number)
 {
     f_setFontSpaceX(number);
+
+    if (v_flagRecord)
+    {
+        s_recordState();
+    }
 }
 
 void hV_Screen_Buffer::setFontSpaceY(uint8_t number)
@@ -592,345 +816,352 @@ uint8_t hV_Screen_Buffer::s_getCharacter(uint8_t character, uint8_t index)
     return f_getCharacter(character, index);
 }
 
-void hV_Screen_Buffer::gText(uint16_t x0, uint16_t y0,
-                             String text,
-                             uint16_t textColour,
-                             uint16_t backColour)
+void hV_Screen_Buffer::s_drawCharacter(uint16_t x0, uint16_t y0, uint8_t character,
+                                       uint8_t ix, uint8_t iy,
+                                       uint16_t textColour, uint16_t backColour)
 {
 #if (FONT_MODE == USE_FONT_TERMINAL)
 
-    uint8_t c;
-    uint8_t line, line1, line2, line3;
-    uint16_t x, y;
-    uint8_t i, j, k;
-
-#if (MAX_FONT_SIZE > 0)
+    // Terminal fonts: one column is 1 to 3 bytes, least significant bit on top
+    uint8_t c = (character < f_font.first) ? 0 : character - f_font.first;
+    uint8_t bytes = (f_font.height + 7) / 8;
+    uint8_t rows = 8 * bytes;
 
-    if (f_fontSize == 0)
+    for (uint8_t i = 0; i < f_font.maxWidth; i += 1)
     {
-        for (k = 0; k < text.length(); k++)
+        uint32_t bits = 0;
+        for (uint8_t b = 0; b < bytes; b += 1)
         {
-            c = text.charAt(k) - ' ';
+            bits |= (uint32_t)f_getCharacter(c, bytes * i + b) << (8 * b);
+        }
+
+        uint16_t x = x0 + i * ix;
+        uint8_t j = 0;
 
-            for (i = 0; i < 6; i++)
+        // Runs of identical bits merged into one span
+        while (j < rows)
+        {
+            bool flag = bitRead(bits, j);
+            uint8_t start = j;
+            while ((j < rows) and (bitRead(bits, j) == flag))
             {
-                line = f_getCharacter(c, i);
+                j += 1;
+            }
 
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        point(x0 + 6 * k + i, y0 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 6 * k + i, y0 + j, backColour);
-                    }
-                }
+            if (flag)
+            {
+                s_fillArea(x, y0 + start * iy, x + ix - 1, y0 + j * iy - 1, textColour);
+            }
+            else if ((f_fontSolid) and (start < f_font.height))
+            {
+                uint8_t end = hV_HAL_min(j, f_font.height);
+                s_fillArea(x, y0 + start * iy, x + ix - 1, y0 + end * iy - 1, backColour);
             }
         }
     }
 
-#if (MAX_FONT_SIZE > 1)
+#endif // FONT_MODE
+}
 
-    else if (f_fontSize == 1)
+void hV_Screen_Buffer::s_drawText(uint16_t x0, uint16_t y0,
+                                  const char * text, size_t length,
+                                  uint8_t ix, uint8_t iy,
+                                  uint16_t textColour, uint16_t backColour)
+{
+    if (v_flagRecord)
     {
-        for (k = 0; k < text.length(); k++)
-        {
-            c = text.charAt(k) - ' ';
+        uint16_t values[] = {x0, y0, ix, iy, textColour, backColour};
+        s_record(RECORD_TEXT, values, 6, text, length);
+        return;
+    }
 
-            for (i = 0; i < 8; i++)
-            {
-                line = f_getCharacter(c, 2 * i);
-                line1 = f_getCharacter(c, 2 * i + 1);
+    if ((ix == 0) or (iy == 0))
+    {
+        return;
+    }
 
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        point(x0 + 8 * k + i, y0 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 8 * k + i, y0 + j, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        point(x0 + 8 * k + i, y0 + 8 + j, textColour);
-                    }
-                    else if ((f_fontSolid) and (j < 4))
-                    {
-                        point(x0 + 8 * k + i, y0 + 8 + j, backColour);
-                    }
-                }
-            }
-        }
+    for (size_t k = 0; k < length; k += 1)
+    {
+        s_drawCharacter(x0 + f_font.maxWidth * k * ix, y0, text[k], ix, iy, textColour, backColour);
     }
+}
 
-#if (MAX_FONT_SIZE > 2)
+void hV_Screen_Buffer::s_drawTextUTF8(uint16_t x0, uint16_t y0,
+                                      const char * text, size_t length,
+                                      uint16_t textColour, uint16_t backColour)
+{
+    if (v_flagRecord)
+    {
+        uint16_t values[] = {x0, y0, textColour, backColour};
+        s_record(RECORD_TEXT_UTF8, values, 4, text, length);
+        return;
+    }
 
-    else if (f_fontSize == 2)
+    size_t index = 0;
+    uint16_t x = x0;
+
+    while (index < length)
     {
+        s_drawCharacter(x, y0, codePointToIso(utf8Next(text, length, index)), 1, 1, textColour, backColour);
+        x += f_font.maxWidth;
+    }
+}
 
-        for (k = 0; k < text.length(); k++)
-        {
-            c = text.charAt(k) - ' ';
+void hV_Screen_Buffer::gText(uint16_t x0, uint16_t y0,
+                             const String & text,
+                             uint16_t textColour,
+                             uint16_t backColour)
+{
+    s_drawText(x0, y0, text.c_str(), text.length(), 1, 1, textColour, backColour);
+}
 
-            for (i = 0; i < 12; i++)
-            {
-                line = f_getCharacter(c, 2 * i);
-                line1 = f_getCharacter(c, 2 * i + 1);
+void hV_Screen_Buffer::gText(uint16_t x0, uint16_t y0,
+                             const char * text,
+                             uint16_t textColour,
+                             uint16_t backColour)
+{
+    s_drawText(x0, y0, text, strlen(text), 1, 1, textColour, backColour);
+}
 
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        point(x0 + 12 * k + i, y0 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 12 * k + i, y0 + j, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        point(x0 + 12 * k + i, y0 + 8 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 12 * k + i, y0 + 8 + j, backColour);
-                    }
-                }
-            }
-        }
+void hV_Screen_Buffer::gText(uint16_t x0, uint16_t y0,
+                             const char * text, size_t length,
+                             uint16_t textColour,
+                             uint16_t backColour)
+{
+    s_drawText(x0, y0, text, length, 1, 1, textColour, backColour);
+}
+
+#if defined(F)
+
+void hV_Screen_Buffer::gText(uint16_t x0, uint16_t y0,
+                             const __FlashStringHelper * text,
+                             uint16_t textColour,
+                             uint16_t backColour)
+{
+    const char * flash = reinterpret_cast<const char *>(text);
+    char c;
+
+    for (size_t k = 0; (c = pgm_read_byte(flash + k)) != 0x00; k += 1)
+    {
+        s_drawText(x0 + f_font.maxWidth * k, y0, &c, 1, 1, 1, textColour, backColour);
     }
-#if (MAX_FONT_SIZE > 3)
+}
+
+#endif // F
+
+void hV_Screen_Buffer::gTextUTF8(uint16_t x0, uint16_t y0,
+                                 const String & text,
+                                 uint16_t textColour,
+                                 uint16_t backColour)
+{
+    s_drawTextUTF8(x0, y0, text.c_str(), text.length(), textColour, backColour);
+}
 
-    else if (f_fontSize == 3)
+void hV_Screen_Buffer::gTextUTF8(uint16_t x0, uint16_t y0,
+                                 const char * text,
+                                 uint16_t textColour,
+                                 uint16_t backColour)
+{
+    s_drawTextUTF8(x0, y0, text, strlen(text), textColour, backColour);
+}
+
+void hV_Screen_Buffer::gTextf(uint16_t x0, uint16_t y0,
+                              uint16_t textColour, uint16_t backColour,
+                              const char * format, ...)
+{
+    char work[128]; // on stack
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(work, sizeof(work), format, args);
+    va_end(args);
+
+    if (length > 0)
     {
-        for (k = 0; k < text.length(); k++)
-        {
-            c = text.charAt(k) - ' ';
-            for (i = 0; i < 16; i++)
-            {
-                line = f_getCharacter(c, 3 * i);
-                line1 = f_getCharacter(c, 3 * i + 1);
-                line2 = f_getCharacter(c, 3 * i + 2);
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        point(x0 + 16 * k + i, y0 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 16 * k + i, y0 + j, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        point(x0 + 16 * k + i, y0 + 8 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 16 * k + i, y0 + 8 + j, backColour);
-                    }
-                    if (bitRead(line2, j))
-                    {
-                        point(x0 + 16 * k + i, y0 + 16 + j, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        point(x0 + 16 * k + i, y0 + 16 + j, backColour);
-                    }
-                }
-            }
-        }
+        s_drawText(x0, y0, work, hV_HAL_min((size_t)length, sizeof(work) - 1), 1, 1, textColour, backColour);
     }
-#endif // end MAX_FONT_SIZE > 3
-#endif // end MAX_FONT_SIZE > 2
-#endif // end MAX_FONT_SIZE > 1
-#endif // end MAX_FONT_SIZE > 0
-#endif // FONT_MODE
 }
 
 void hV_Screen_Buffer::gTextLarge(uint16_t x0, uint16_t y0,
-                                  String text,
+                                  const String & text,
                                   uint16_t textColour,
                                   uint16_t backColour)
 {
-#if (FONT_MODE == USE_FONT_TERMINAL)
+    s_drawText(x0, y0, text.c_str(), text.length(), 2, 2, textColour, backColour);
+}
+
+void hV_Screen_Buffer::gTextScaled(uint16_t x0, uint16_t y0,
+                                   const String & text,
+                                   uint8_t ix, uint8_t iy,
+                                   uint16_t textColour,
+                                   uint16_t backColour)
+{
+    s_drawText(x0, y0, text.c_str(), text.length(), ix, iy, textColour, backColour);
+}
 
-    uint8_t c;
-    uint8_t line, line1, line2, line3;
-    uint16_t x, y;
-    uint8_t i, j, k;
+void hV_Screen_Buffer::gTextScaled(uint16_t x0, uint16_t y0,
+                                   const char * text,
+                                   uint8_t ix, uint8_t iy,
+                                   uint16_t textColour,
+                                   uint16_t backColour)
+{
+    s_drawText(x0, y0, text, strlen(text), ix, iy, textColour, backColour);
+}
+//
+// === End of Font section
+//
 
-    uint8_t ix = 2;
-    uint8_t iy = 2;
+//
+// === Record section
+//
+void hV_Screen_Buffer::beginRecord(uint8_t * buffer, size_t size)
+{
+    v_recordBuffer = buffer;
+    v_recordSize = size;
+    v_recordLength = 0;
+    v_recordOverflow = false;
+    v_flagRecord = true;
+
+    // Settings at start
+    s_recordState();
+}
 
-    bool oldPenSolid = v_penSolid;
-    setPenSolid(true);
+bool hV_Screen_Buffer::endRecord()
+{
+    v_flagRecord = false;
+    return (v_recordOverflow ? RESULT_ERROR : RESULT_SUCCESS);
+}
 
-#if (MAX_FONT_SIZE > 0)
+void hV_Screen_Buffer::s_record(uint8_t command, const uint16_t * values, uint8_t number, const void * data, size_t length)
+{
+    // command, number, values, length, data
+    size_t needed = 2 + 2 * number + 2 + length;
 
-    if (f_fontSize == 0)
+    // Length stored on 16 bits
+    if (v_recordOverflow or (length > UINT16_MAX) or (v_recordLength + needed > v_recordSize))
     {
-        for (k = 0; k < text.length(); k++)
-        {
-            x = x0 + 6 * k * ix;
-            y = y0;
-            c = text.charAt(k) - ' ';
+        v_recordOverflow = true;
+        return;
+    }
 
-            for (i = 0; i < 6; i++)
-            {
-                line = f_getCharacter(c, i);
+    uint8_t * pointer = v_recordBuffer + v_recordLength;
+    uint16_t length16 = length;
+    pointer[0] = command;
+    pointer[1] = number;
+    memcpy(pointer + 2, values, 2 * number);
+    memcpy(pointer + 2 + 2 * number, &length16, 2);
+    if (length > 0)
+    {
+        memcpy(pointer + 4 + 2 * number, data, length);
+    }
+    v_recordLength += needed;
+}
 
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        dRectangle(x + i * ix, y + j * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y + j * iy, ix, iy, backColour);
-                    }
-                }
-            }
-        }
+void hV_Screen_Buffer::s_recordState()
+{
+    uint16_t values[] = {v_orientation, f_fontSize, v_penSolid, f_fontSolid, f_fontSpaceX};
+    s_record(RECORD_STATE, values, 5);
+}
+
+void hV_Screen_Buffer::replay(hV_Screen_Buffer & source)
+{
+    // Not while recording on this screen
+    if (v_flagRecord)
+    {
+        return;
     }
 
-#if (MAX_FONT_SIZE > 1)
+    const uint8_t * buffer = source.v_recordBuffer;
+    size_t index = 0;
+    uint16_t values[8];
 
-    else if (f_fontSize == 1)
+    while (index + 4 <= source.v_recordLength)
     {
-        for (k = 0; k < text.length(); k++)
+        uint8_t command = buffer[index];
+        uint8_t number = hV_HAL_min(buffer[index + 1], 8);
+        memcpy(values, buffer + index + 2, 2 * number);
+        uint16_t length;
+        memcpy(&length, buffer + index + 2 + 2 * buffer[index + 1], 2);
+        const uint8_t * data = buffer + index + 4 + 2 * buffer[index + 1];
+        index += 4 + 2 * buffer[index + 1] + length;
+
+        switch (command)
         {
-            x = x0 + 8 * k * ix;
-            y = y0;
-            c = text.charAt(k) - ' ';
+            case RECORD_STATE:
 
-            for (i = 0; i < 8; i++)
-            {
-                line = f_getCharacter(c, 2 * i);
-                line1 = f_getCharacter(c, 2 * i + 1);
+                setOrientation(values[0]);
+                selectFont(values[1]);
+                setPenSolid(values[2]);
+                setFontSolid(values[3]);
+                setFontSpaceX(values[4]);
+                break;
 
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, textColour);
-                    }
-                    else if ((f_fontSolid) and (j < 4))
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, backColour);
-                    }
-                }
-            }
-        }
-    }
+            case RECORD_CLEAR:
 
-#if (MAX_FONT_SIZE > 2)
+                clear(values[0]);
+                break;
 
-    else if (f_fontSize == 2)
-    {
+            case RECORD_POINT:
 
-        for (k = 0; k < text.length(); k++)
-        {
-            x = x0 + 12 * k * ix;
-            y = y0;
-            c = text.charAt(k) - ' ';
+                point(values[0], values[1], values[2]);
+                break;
 
-            for (i = 0; i < 12; i++)
-            {
-                line = f_getCharacter(c, 2 * i);
-                line1 = f_getCharacter(c, 2 * i + 1);
+            case RECORD_LINE:
 
-                for (j = 0; j < 8; j++)
-                {
-                    if (bitRead(line, j))
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, backColour);
-                    }
-                }
-            }
-        }
-    }
+                line(values[0], values[1], values[2], values[3], values[4]);
+                break;
 
-#if (MAX_FONT_SIZE > 3)
+            case RECORD_RECTANGLE:
 
-    else if (f_fontSize == 3)
-    {
-        for (k = 0; k < text.length(); k++)
-        {
-            x = x0 + 16 * k * ix;
-            y = y0;
-            c = text.charAt(k) - ' ';
+                rectangle(values[0], values[1], values[2], values[3], values[4]);
+                break;
+
+            case RECORD_CIRCLE:
+
+                circle(values[0], values[1], values[2], values[3]);
+                break;
 
-            for (i = 0; i < 16; i++)
+            case RECORD_TRIANGLE:
+
+                triangle(values[0], values[1], values[2], values[3], values[4], values[5], values[6]);
+                break;
+
+            case RECORD_POLYGON:
             {
-                line = f_getCharacter(c, 3 * i);
-                line1 = f_getCharacter(c, 3 * i + 1);
-                line2 = f_getCharacter(c, 3 * i + 2);
-                for (j = 0; j < 8; j++)
+                // Vertices copied for alignment
+                point_s points[8];
+                point_s * vertices = (values[0] > 8) ? new point_s[values[0]] : points;
+                memcpy(vertices, data, values[0] * sizeof(point_s));
+                polygon(vertices, values[0], values[1]);
+                if (vertices != points)
                 {
-                    if (bitRead(line, j))
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + j * iy, ix, iy, backColour);
-                    }
-                    if (bitRead(line1, j))
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + (8 + j) * iy, ix, iy, backColour);
-                    }
-                    if (bitRead(line2, j))
-                    {
-                        dRectangle(x + i * ix, y0 + (16 + j) * iy, ix, iy, textColour);
-                    }
-                    else if (f_fontSolid)
-                    {
-                        dRectangle(x + i * ix, y0 + (16 + j) * iy, ix, iy, backColour);
-                    }
+                    delete[] vertices;
                 }
+                break;
             }
+
+            case RECORD_TEXT:
+
+                s_drawText(values[0], values[1], (const char *)data, length, values[2], values[3], values[4], values[5]);
+                break;
+
+            case RECORD_TEXT_UTF8:
+
+                s_drawTextUTF8(values[0], values[1], (const char *)data, length, values[2], values[3]);
+                break;
+
+            default:
+
+                s_replay(command, values, data, length);
+                break;
         }
     }
-#endif // end MAX_FONT_SIZE > 3
-#endif // end MAX_FONT_SIZE > 2
-#endif // end MAX_FONT_SIZE > 1
-#endif // end MAX_FONT_SIZE > 0
-
-    setPenSolid(oldPenSolid);
+}
 
-#endif // FONT_MODE
+void hV_Screen_Buffer::s_replay(uint8_t /* command */, const uint16_t * /* values */, const uint8_t * /* data */, uint16_t /* length */)
+{
+    ;
 }
 //
-// === End of Font section
+// === End of Record section
 //
 
@@ -57,6 +57,37 @@
 #error FONT_MODE not defined
 #endif // FONT_MODE
 
+///
+/// @brief Point structure
+/// @details Vertex for polygon()
+///
+struct point_s
+{
+    uint16_t x; ///< x-axis coordinate
+    uint16_t y; ///< y-axis coordinate
+};
+
+///
+/// @name Recorded commands
+/// @details Command codes for beginRecord() and replay()
+/// @{
+///
+#define RECORD_STATE 0x01 ///< orientation, font, pen and font solid, spaceX
+#define RECORD_CLEAR 0x02 ///< clear()
+#define RECORD_POINT 0x03 ///< point()
+#define RECORD_LINE 0x04 ///< line()
+#define RECORD_RECTANGLE 0x05 ///< rectangle()
+#define RECORD_CIRCLE 0x06 ///< circle()
+#define RECORD_TRIANGLE 0x07 ///< triangle()
+#define RECORD_POLYGON 0x08 ///< polygon()
+#define RECORD_TEXT 0x09 ///< gText() and variants
+#define RECORD_TEXT_UTF8 0x0a ///< gTextUTF8()
+#define RECORD_DRAW_MODE 0x0b ///< setDrawMode() of the derived screen
+#define RECORD_INVERT_AREA 0x0c ///< invertArea() of the derived screen
+#define RECORD_BITMAP 0x0d ///< drawBitmap() of the derived screen, pointer to the data
+/// @}
+///
+
 ///
 /// @brief Generic buffered screen class
 /// @details This class provides the text and graphic primitives for the buffered screen
@@ -197,6 +228,12 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     ///
     virtual void setPenSolid(bool flag = true);
 
+    ///
+    /// @brief Get pen opaque
+    /// @return true = opaque = solid, false = wire frame
+    ///
+    virtual bool getPenSolid();
+
     ///
     /// @brief Draw triangle, rectangle coordinates
     /// @param x1 first point coordinate, x-axis
@@ -212,6 +249,18 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     ///
     virtual void triangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t colour);
 
+    ///
+    /// @brief Draw polygon
+    /// @param points array of vertices
+    /// @param number number of vertices
+    /// @param colour 16-bit colour
+    /// @note Convex or concave, filled with the even-odd rule if pen is solid
+    /// @note The last vertex is connected to the first one
+    ///
+    /// @n @b More: @ref Coordinate, @ref Colour
+    ///
+    virtual void polygon(const point_s * points, uint16_t number, uint16_t colour);
+
     ///
     /// @brief Draw rectangle, rectangle coordinates
     /// @param x1 top left coordinate, x-axis
@@ -278,6 +327,12 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     ///
     virtual void setFontSolid(bool flag = true);
 
+    ///
+    /// @brief Get transparent or opaque text
+    /// @return true = opaque = solid, false = transparent
+    ///
+    virtual bool getFontSolid();
+
     ///
     /// @brief Set additional spaces between two characters, horizontal axis
     /// @param number of spaces default = 1 pixel
@@ -316,7 +371,26 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     /// @return horizontal size of the string for current font, in pixels
     /// @n @b More: @ref Fonts
     ///
-    virtual uint16_t stringSizeX(String text);
+    virtual uint16_t stringSizeX(const String & text);
+
+    ///
+    /// @brief String size, x-axis, char array
+    /// @param text char array to evaluate
+    /// @return horizontal size of the string for current font, in pixels
+    /// @note No allocation
+    /// @n @b More: @ref Fonts
+    ///
+    virtual uint16_t stringSizeX(const char * text);
+
+    ///
+    /// @brief String size, x-axis, char array with length
+    /// @param text char array to evaluate, not necessarily null-terminated
+    /// @param length number of characters
+    /// @return horizontal size of the string for current font, in pixels
+    /// @note No allocation
+    /// @n @b More: @ref Fonts
+    ///
+    virtual uint16_t stringSizeX(const char * text, size_t length);
 
     ///
     /// @brief Number of characters to fit a size, x-axis
@@ -325,7 +399,28 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     /// @return number of characters to be displayed inside the pixels
     /// @n @b More: @ref Fonts
     ///
-    virtual uint8_t stringLengthToFitX(String text, uint16_t pixels);
+    virtual uint8_t stringLengthToFitX(const String & text, uint16_t pixels);
+
+    ///
+    /// @brief Number of characters to fit a size, x-axis, char array
+    /// @param text char array to evaluate
+    /// @param pixels number of pixels to fit in
+    /// @return number of characters to be displayed inside the pixels
+    /// @note No allocation
+    /// @n @b More: @ref Fonts
+    ///
+    virtual uint8_t stringLengthToFitX(const char * text, uint16_t pixels);
+
+    ///
+    /// @brief Number of characters to fit a size, x-axis, char array with length
+    /// @param text char array to evaluate, not necessarily null-terminated
+    /// @param length number of characters
+    /// @param pixels number of pixels to fit in
+    /// @return number of characters to be displayed inside the pixels
+    /// @note No allocation
+    /// @n @b More: @ref Fonts
+    ///
+    virtual uint8_t stringLengthToFitX(const char * text, size_t length, uint16_t pixels);
 
     ///
     /// @brief Number of fonts
@@ -347,10 +442,116 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     /// @n @b More: @ref Colour, @ref Fonts, @ref Coordinate
     ///
     virtual void gText(uint16_t x0, uint16_t y0,
-                       String text,
+                       const String & text,
+                       uint16_t textColour = myColours.black,
+                       uint16_t backColour = myColours.white);
+
+    ///
+    /// @brief Draw ASCII Text (pixel coordinates), char array
+    /// @param x0 point coordinate, x-axis
+    /// @param y0 point coordinate, y-axis
+    /// @param text char array
+    /// @param textColour 16-bit colour, default = white
+    /// @param backColour 16-bit colour, default = black
+    /// @note No allocation
+    ///
+    /// @n @b More: @ref Colour, @ref Fonts, @ref Coordinate
+    ///
+    virtual void gText(uint16_t x0, uint16_t y0,
+                       const char * text,
                        uint16_t textColour = myColours.black,
                        uint16_t backColour = myColours.white);
 
+    ///
+    /// @brief Draw ASCII Text (pixel coordinates), char array with length
+    /// @param x0 point coordinate, x-axis
+    /// @param y0 point coordinate, y-axis
+    /// @param text char array, not necessarily null-terminated
+    /// @param length number of characters
+    /// @param textColour 16-bit colour
+    /// @param backColour 16-bit colour
+    /// @note No allocation
+    /// @note No default colours, to avoid ambiguity with the other forms
+    ///
+    /// @n @b More: @ref Colour, @ref Fonts, @ref Coordinate
+    ///
+    virtual void gText(uint16_t x0, uint16_t y0,
+                       const char * text, size_t length,
+                       uint16_t textColour,
+                       uint16_t backColour);
+
+#if defined(F)
+
+    ///
+    /// @brief Draw ASCII Text (pixel coordinates), Flash string
+    /// @param x0 point coordinate, x-axis
+    /// @param y0 point coordinate, y-axis
+    /// @param text Flash string, as F("text")
+    /// @param textColour 16-bit colour, default = white
+    /// @param backColour 16-bit colour, default = black
+    /// @note No allocation, characters read one by one from Flash
+    ///
+    /// @n @b More: @ref Colour, @ref Fonts, @ref Coordinate
+    ///
+    virtual void gText(uint16_t x0, uint16_t y0,
+                       const __FlashStringHelper * text,
+                       uint16_t textColour = myColours.black,
+                       uint16_t backColour = myColours.white);
+
+#endif // F
+
+    ///
+    /// @brief Draw UTF-8 Text (pixel coordinates)
+    /// @param x0 point coordinate, x-axis
+    /// @param y0 point coordinate, y-axis
+    /// @param text UTF-8 string
+    /// @param textColour 16-bit colour, default = white
+    /// @param backColour 16-bit colour, default = black
+    /// @note Decoded on the fly, no allocation and no length limit
+    /// @note Characters without glyph are displayed as UTF8_REPLACEMENT_GLYPH
+    ///
+    /// @n @b More: @ref Colour, @ref Fonts, @ref Coordinate
+    ///
+    virtual void gTextUTF8(uint16_t x0, uint16_t y0,
+                           const String & text,
+                           uint16_t textColour = myColours.black,
+                           uint16_t backColour = myColours.white);
+
+    ///
+    /// @brief Draw UTF-8 Text (pixel coordinates), char array
+    /// @param x0 point coordinate, x-axis
+    /// @param y0 point coordinate, y-axis
+    /// @param text UTF-8 char array
+    /// @param textColour 16-bit colour, default = white
+    /// @param backColour 16-bit colour, default = black
+    /// @note Decoded on the fly, no allocation and no length limit
+    /// @note Characters without glyph are displayed as UTF8_REPLACEMENT_GLYPH
+    ///
+    /// @n @b More: @ref Colour, @ref Fonts, @ref Coordinate
+    ///
+    virtual void gTextUTF8(uint16_t x0, uint16_t y0,
+                           const char * text,
+                           uint16_t textColour = myColours.black,
+                           uint16_t backColour = myColours.white);
+
+    ///
+    /// @brief Draw formatted ASCII Text (pixel coordinates)
+    /// @param x0 point coordinate, x-axis
+    /// @param y0 point coordinate, y-axis
+    /// @param textColour 16-bit colour
+    /// @param backColour 16-bit colour
+    /// @param format format with standard codes
+    /// @param ... list of values
+    /// @note Formatted on the stack, no allocation
+    /// @warning Text limited to 127 characters
+    /// @see http://www.cplusplus.com/reference/cstdio/printf/?kw=printf for codes
+    ///
+    /// @n @b More: @ref Colour, @ref Fonts, @ref Coordinate
+    ///
+    virtual void gTextf(uint16_t x0, uint16_t y0,
+                        uint16_t textColour, uint16_t backColour,
+                        const char * format, ...);
+
     ///
     /// @brief Draw ASCII Text (pixel coordinates) with selection of size
     /// @param x0 point coordinate, x-axis
@@ -363,9 +564,77 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     /// @n @b More: @ref Colour, @ref Fonts, @ref Coordinate
     ///
     virtual void gTextLarge(uint16_t x0, uint16_t y0,
-                            String text,
+                            const String & text,
                             uint16_t textColour = myColours.black,
                             uint16_t backColour = myColours.white);
+
+    ///
+    /// @brief Draw ASCII Text (pixel coordinates) with integer scaling
+    /// @param x0 point coordinate, x-axis
+    /// @param y0 point coordinate, y-axis
+    /// @param text text string
+    /// @param ix scale factor, x-axis, 1..
+    /// @param iy scale factor, y-axis, 1..
+    /// @param textColour 16-bit colour, default = white
+    /// @param backColour 16-bit colour, default = black
+    /// @note gText() and gTextLarge() are gTextScaled() with 1x1 and 2x2 scaling
+    ///
+    /// @n @b More: @ref Colour, @ref Fonts, @ref Coordinate
+    ///
+    virtual void gTextScaled(uint16_t x0, uint16_t y0,
+                             const String & text,
+                             uint8_t ix, uint8_t iy,
+                             uint16_t textColour = myColours.black,
+                             uint16_t backColour = myColours.white);
+
+    ///
+    /// @brief Draw ASCII Text (pixel coordinates) with integer scaling, char array
+    /// @param x0 point coordinate, x-axis
+    /// @param y0 point coordinate, y-axis
+    /// @param text char array
+    /// @param ix scale factor, x-axis, 1..
+    /// @param iy scale factor, y-axis, 1..
+    /// @param textColour 16-bit colour, default = white
+    /// @param backColour 16-bit colour, default = black
+    /// @note No allocation
+    ///
+    /// @n @b More: @ref Colour, @ref Fonts, @ref Coordinate
+    ///
+    virtual void gTextScaled(uint16_t x0, uint16_t y0,
+                             const char * text,
+                             uint8_t ix, uint8_t iy,
+                             uint16_t textColour = myColours.black,
+                             uint16_t backColour = myColours.white);
+    /// @}
+
+    ///
+    /// @name Record and replay
+    /// @details Record the drawing commands once, and replay them on
+    /// one or more screens, for example one per core, each clipped to its own band
+    /// @{
+
+    ///
+    /// @brief Start recording the drawing commands
+    /// @param buffer caller-provided buffer
+    /// @param size size of the buffer, in bytes
+    /// @note While recording, the drawing commands are stored but not performed.
+    /// The settings, as orientation and font, are stored and performed.
+    ///
+    virtual void beginRecord(uint8_t * buffer, size_t size);
+
+    ///
+    /// @brief Stop recording the drawing commands
+    /// @return RESULT_SUCCESS if all the commands are recorded, RESULT_ERROR otherwise
+    ///
+    virtual bool endRecord();
+
+    ///
+    /// @brief Replay the recorded drawing commands
+    /// @param source screen with the recorded commands, possibly the same screen
+    /// @note The buffer of the source is only read, so several screens can replay it at the same time.
+    /// @note The settings of the screen are those at the end of the recording.
+    ///
+    virtual void replay(hV_Screen_Buffer & source);
     /// @}
 
     //
@@ -408,20 +677,84 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     // Write and Read
 
     // Other functions
-    // required by triangle()
+    // required by rectangle() and polygon()
     ///
-    /// @brief Triangle utility
-    /// @param x1 first point coordinate, x-axis
-    /// @param y1 first point coordinate, y-axis
-    /// @param x2 second point coordinate, x-axis
-    /// @param y2 second point coordinate, y-axis
-    /// @param x3 third point coordinate, x-axis
-    /// @param y3 third point coordinate, y-axis
+    /// @brief Fill area utility
+    /// @param x1 top left coordinate, x-axis
+    /// @param y1 top left coordinate, y-axis
+    /// @param x2 bottom right coordinate, x-axis
+    /// @param y2 bottom right coordinate, y-axis
+    /// @param colour 16-bit colour
+    /// @note x1 <= x2 and y1 <= y2 assumed
+    /// @note Default implementation calls s_setPoint() for each pixel
+    ///
+    virtual void s_fillArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour);
+
+    ///
+    /// @brief Fill one row, clipped to the screen
+    /// @param x1 left coordinate, x-axis, may be negative
+    /// @param x2 right coordinate, x-axis, may be beyond the screen
+    /// @param y1 coordinate, y-axis, may be outside the screen
+    /// @param colour 16-bit colour
+    ///
+    void s_fillSpan(int32_t x1, int32_t x2, int32_t y1, uint16_t colour);
+
+    ///
+    /// @brief Draw line, optionally without the last point
+    /// @param x1 first coordinate, x-axis
+    /// @param y1 first coordinate, y-axis
+    /// @param x2 last coordinate, x-axis
+    /// @param y2 last coordinate, y-axis
     /// @param colour 16-bit colour
+    /// @param flagLast false to exclude the last point, shared with the next edge
     ///
-    void s_triangleArea(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t x3, uint16_t y3, uint16_t colour);
+    void s_drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t colour, bool flagLast = true);
 
     // required by gText()
+    ///
+    /// @brief Draw text with integer scaling
+    /// @param x0 point coordinate, x-axis
+    /// @param y0 point coordinate, y-axis
+    /// @param text char array, not necessarily null-terminated
+    /// @param length number of characters
+    /// @param ix scale factor, x-axis
+    /// @param iy scale factor, y-axis
+    /// @param textColour 16-bit colour
+    /// @param backColour 16-bit colour, only if font is solid
+    ///
+    void s_drawText(uint16_t x0, uint16_t y0,
+                    const char * text, size_t length,
+                    uint8_t ix, uint8_t iy,
+                    uint16_t textColour, uint16_t backColour);
+
+    ///
+    /// @brief Draw UTF-8 text, decoded on the fly
+    /// @param x0 point coordinate, x-axis
+    /// @param y0 point coordinate, y-axis
+    /// @param text UTF-8 char array
+    /// @param length number of bytes
+    /// @param textColour 16-bit colour
+    /// @param backColour 16-bit colour, only if font is solid
+    ///
+    void s_drawTextUTF8(uint16_t x0, uint16_t y0,
+                        const char * text, size_t length,
+                        uint16_t textColour, uint16_t backColour);
+
+    ///
+    /// @brief Draw one character with integer scaling
+    /// @param x0 point coordinate, x-axis
+    /// @param y0 point coordinate, y-axis
+    /// @param character character 32~255
+    /// @param ix scale factor, x-axis
+    /// @param iy scale factor, y-axis
+    /// @param textColour 16-bit colour
+    /// @param backColour 16-bit colour, only if font is solid
+    /// @note Runs of set or clear bits of each column are drawn as one area
+    ///
+    void s_drawCharacter(uint16_t x0, uint16_t y0, uint8_t character,
+                         uint8_t ix, uint8_t iy,
+                         uint16_t textColour, uint16_t backColour);
+
     ///
     /// @brief Get definition for line of character
     /// @param character character 32~255
@@ -430,6 +763,42 @@ class hV_Screen_Buffer : protected hV_Font_Terminal
     ///
     uint8_t s_getCharacter(uint8_t character, uint8_t index);
 
+    ///
+    /// @brief Record a command
+    /// @param command RECORD_* code
+    /// @param values parameters
+    /// @param number number of parameters
+    /// @param data variable part, as text or vertices, optional
+    /// @param length number of bytes of the variable part
+    /// @note Recording stops at the first command that does not fit,
+    /// including a variable part longer than UINT16_MAX bytes
+    ///
+    void s_record(uint8_t command, const uint16_t * values, uint8_t number, const void * data = 0, size_t length = 0);
+
+    ///
+    /// @brief Record the settings
+    /// @details Orientation, font, pen solid, font solid and spaceX
+    ///
+    void s_recordState();
+
+    ///
+    /// @brief Replay a command of the derived screen
+    /// @param command RECORD_* code
+    /// @param values parameters
+    /// @param data variable part
+    /// @param length number of bytes of the variable part
+    /// @note Called by replay() for the codes not performed by hV_Screen_Buffer
+    ///
+    virtual void s_replay(uint8_t command, const uint16_t * values, const uint8_t * data, uint16_t length);
+
+    uint8_t * v_recordBuffer; ///< buffer with recorded commands
+    size_t v_recordSize; ///< size of the buffer
+    size_t v_recordLength; ///< recorded bytes
+    bool v_flagRecord; ///< recording on-going
+    bool v_recordOverflow; ///< buffer too small
+
+    bool v_flagToggle; ///< drawing mode toggles pixels, each primitive draws each pixel once
+
     uint8_t * s_newImage;
 
     // Variables provided by hV_Screen_Virtual
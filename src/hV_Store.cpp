@@ -0,0 +1,113 @@
+//
+// hV_Store.cpp
+// Library C++ code
+// ----------------------------------
+//
+// Project Pervasive Displays Library Suite
+// Based on highView technology
+//
+// Created by Rei Vilo, 21 Feb 2025
+//
+// Copyright (c) Rei Vilo, 2010-2025
+// Licence Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+// For exclusive use with Pervasive Displays screens
+//
+// See hV_Store.h for references
+//
+// Release 821: Added backing store for frames
+//
+
+// Library header
+#include "hV_Store.h"
+
+hV_Store_RAM::hV_Store_RAM(uint16_t slots)
+{
+    m_data = nullptr;
+    m_slotSize = 0;
+    m_slots = 0;
+    m_slotsRequested = slots;
+}
+
+hV_Store_RAM::~hV_Store_RAM()
+{
+    end();
+}
+
+uint8_t hV_Store_RAM::begin(uint32_t slotSize)
+{
+    end();
+
+    if ((slotSize == 0) or (m_slotsRequested == 0))
+    {
+        return RESULT_ERROR;
+    }
+
+#if defined(BOARD_HAS_PSRAM) // ESP32 PSRAM specific case
+
+    m_data = (uint8_t *) ps_malloc(slotSize * m_slotsRequested);
+
+#else // default case
+
+    m_data = new uint8_t[slotSize * m_slotsRequested];
+
+#endif // ESP32 BOARD_HAS_PSRAM
+
+    if (m_data == nullptr)
+    {
+        mySerial.println(formatString("hV * Store %i x %i bytes not allocated", m_slotsRequested, slotSize));
+        return RESULT_ERROR;
+    }
+
+    m_slotSize = slotSize;
+    m_slots = m_slotsRequested;
+    return RESULT_SUCCESS;
+}
+
+void hV_Store_RAM::end()
+{
+    if (m_data != nullptr)
+    {
+
+#if defined(BOARD_HAS_PSRAM) // ESP32 PSRAM specific case
+
+        free(m_data);
+
+#else // default case
+
+        delete[] m_data;
+
+#endif // ESP32 BOARD_HAS_PSRAM
+
+        m_data = nullptr;
+    }
+    m_slotSize = 0;
+    m_slots = 0;
+}
+
+uint16_t hV_Store_RAM::slots()
+{
+    return m_slots;
+}
+
+uint32_t hV_Store_RAM::m_available(uint16_t slot, uint32_t offset, uint32_t size)
+{
+    if ((slot >= m_slots) or (offset >= m_slotSize))
+    {
+        return 0;
+    }
+    return hV_HAL_min(size, m_slotSize - offset);
+}
+
+uint32_t hV_Store_RAM::read(uint16_t slot, uint32_t offset, uint8_t * buffer, uint32_t size)
+{
+    uint32_t count = m_available(slot, offset, size);
+    memcpy(buffer, m_data + slot * m_slotSize + offset, count);
+    return count;
+}
+
+uint32_t hV_Store_RAM::write(uint16_t slot, uint32_t offset, const uint8_t * buffer, uint32_t size)
+{
+    uint32_t count = m_available(slot, offset, size);
+    memcpy(m_data + slot * m_slotSize + offset, buffer, count);
+    return count;
+}
@@ -0,0 +1,173 @@
+///
+/// @file hV_Store.h
+/// @brief Backing store for frames
+///
+/// @details Project Pervasive Displays Library Suite
+/// @n Based on highView technology
+///
+/// @author Rei Vilo
+/// @date 21 Feb 2025
+/// @version 821
+///
+/// @copyright (c) Rei Vilo, 2010-2025
+/// @copyright All rights reserved
+/// @copyright For exclusive use with Pervasive Displays screens
+/// @copyright Portions (c) Pervasive Displays, 2010-2025
+///
+/// * Basic edition: for hobbyists and for basic usage
+/// @n Creative Commons Attribution-ShareAlike 4.0 International (CC BY-SA 4.0)
+/// @see https://creativecommons.org/licenses/by-sa/4.0/
+///
+/// @n Consider the Evaluation or Commercial editions for professionals or organisations and for commercial usage
+///
+/// * Evaluation edition: for professionals or organisations, evaluation only, no commercial usage
+/// @n All rights reserved
+///
+/// * Commercial edition: for professionals or organisations, commercial usage
+/// @n All rights reserved
+///
+/// * Viewer edition: for professionals or organisations
+/// @n All rights reserved
+///
+/// * Documentation
+/// @n All rights reserved
+///
+
+// SDK
+#include "hV_HAL_Peripherals.h"
+
+// Configuration
+#include "hV_Configuration.h"
+
+// Utilities
+#include "hV_Utilities_Common.h"
+
+#ifndef hV_STORE_RELEASE
+///
+/// @brief Library release number
+///
+#define hV_STORE_RELEASE 821
+
+///
+/// @brief Backing store for frames
+/// @details Slots of the same size, each one holding a whole frame
+/// @note Derive a class to use another memory, for example an external SPI flash or a file.
+///
+class hV_Store
+{
+  public:
+    ///
+    /// @brief Destructor
+    ///
+    virtual ~hV_Store() {};
+
+    ///
+    /// @brief Initialise the store
+    /// @param slotSize size of each slot, bytes
+    /// @return RESULT_SUCCESS or RESULT_ERROR
+    ///
+    virtual uint8_t begin(uint32_t slotSize) = 0;
+
+    ///
+    /// @brief Release the store
+    ///
+    virtual void end() = 0;
+
+    ///
+    /// @brief Number of slots
+    /// @return number of slots, 0 if not initialised
+    ///
+    virtual uint16_t slots() = 0;
+
+    ///
+    /// @brief Read from a slot
+    /// @param slot slot, 0..slots()-1
+    /// @param offset first byte
+    /// @param buffer buffer to fill
+    /// @param size number of bytes
+    /// @return number of bytes read
+    ///
+    virtual uint32_t read(uint16_t slot, uint32_t offset, uint8_t * buffer, uint32_t size) = 0;
+
+    ///
+    /// @brief Write into a slot
+    /// @param slot slot, 0..slots()-1
+    /// @param offset first byte
+    /// @param buffer bytes to write
+    /// @param size number of bytes
+    /// @return number of bytes written
+    ///
+    virtual uint32_t write(uint16_t slot, uint32_t offset, const uint8_t * buffer, uint32_t size) = 0;
+};
+
+///
+/// @brief Backing store in RAM
+/// @note On ESP32 with PSRAM, the slots are allocated in PSRAM.
+///
+class hV_Store_RAM : public hV_Store
+{
+  public:
+    ///
+    /// @brief Constructor
+    /// @param slots number of slots
+    ///
+    hV_Store_RAM(uint16_t slots);
+
+    ///
+    /// @brief Destructor
+    ///
+    ~hV_Store_RAM();
+
+    ///
+    /// @brief Initialise the store
+    /// @param slotSize size of each slot, bytes
+    /// @return RESULT_SUCCESS or RESULT_ERROR if the memory is not allocated
+    ///
+    uint8_t begin(uint32_t slotSize);
+
+    ///
+    /// @brief Release the memory
+    ///
+    void end();
+
+    ///
+    /// @brief Number of slots
+    /// @return number of slots, 0 if not initialised
+    ///
+    uint16_t slots();
+
+    ///
+    /// @brief Read from a slot
+    /// @param slot slot, 0..slots()-1
+    /// @param offset first byte
+    /// @param buffer buffer to fill
+    /// @param size number of bytes
+    /// @return number of bytes read
+    ///
+    uint32_t read(uint16_t slot, uint32_t offset, uint8_t * buffer, uint32_t size);
+
+    ///
+    /// @brief Write into a slot
+    /// @param slot slot, 0..slots()-1
+    /// @param offset first byte
+    /// @param buffer bytes to write
+    /// @param size number of bytes
+    /// @return number of bytes written
+    ///
+    uint32_t write(uint16_t slot, uint32_t offset, const uint8_t * buffer, uint32_t size);
+
+  protected:
+    /// @cond
+
+    // Bytes available in a slot from offset
+    uint32_t m_available(uint16_t slot, uint32_t offset, uint32_t size);
+
+    uint8_t * m_data;
+    uint32_t m_slotSize;
+    uint16_t m_slots;
+    uint16_t m_slotsRequested;
+
+    /// @endcond
+};
+
+#endif // hV_STORE_RELEASE
@@ -16,6 +16,9 @@
 //
 // Release 700: Refactored screen and board functions
 // Release 803: Added types for string and frame-buffer
+// Release 821: Added streaming UTF-8 decoder, utf2iso() without buffer
+// Release 821: Removed global buffers, added reentrant functions
+// Release 821: Added hashFNV()
 //
 
 // Library header
@@ -29,21 +32,39 @@ void delay_ms(uint32_t ms)
     while (millis() < chrono);
 }
 
-char bufferIn[128];
-char bufferOut[128];
-
 // Code
 // Utilities
 
 STRING_TYPE formatString(const char * format, ...)
 {
-    memset(&bufferOut, 0x00, sizeof(bufferOut));
+    char work[128]; // on stack, reentrant
+    va_list args;
+    va_start(args, format);
+    vsnprintf(work, sizeof(work), format, args);
+    va_end(args);
+
+    return String(work);
+}
+
+size_t formatBuffer(char * buffer, size_t size, const char * format, ...)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
     va_list args;
     va_start(args, format);
-    vsnprintf(bufferOut, 127, format, args);
+    int length = vsnprintf(buffer, size, format, args);
     va_end(args);
 
-    return String(bufferOut);
+    if (length < 0)
+    {
+        buffer[0] = 0x00;
+        return 0;
+    }
+
+    return hV_HAL_min((size_t)length, size - 1);
 }
 
 STRING_TYPE trimString(STRING_TYPE text)
@@ -157,42 +178,132 @@ int32_t sin32x100(int32_t degreesX100)
     return cos32x100(degreesX100 + 27000);
 }
 
-STRING_TYPE utf2iso(STRING_TYPE s)
+uint32_t utf8Next(const char * text, size_t length, size_t & index)
 {
-    uint8_t c;
+    uint8_t c = (uint8_t)text[index];
+    index += 1;
 
-    s.toCharArray(bufferIn, s.length() + 1);
-    // strcpy(bufferIn, s.c_str());
+    if (c < 0x80)
+    {
+        return c;
+    }
 
-    memset(&bufferOut, 0x00, sizeof(bufferOut));
+    uint8_t remaining;
+    uint32_t codePoint;
+    uint32_t minimum;
 
-    for (uint8_t i = 0; i < strlen(bufferIn); i++)
+    if ((c & 0xe0) == 0xc0)
     {
-        c = (uint8_t)bufferIn[i];
+        remaining = 1;
+        codePoint = c & 0x1f;
+        minimum = 0x80;
+    }
+    else if ((c & 0xf0) == 0xe0)
+    {
+        remaining = 2;
+        codePoint = c & 0x0f;
+        minimum = 0x800;
+    }
+    else if ((c & 0xf8) == 0xf0)
+    {
+        remaining = 3;
+        codePoint = c & 0x07;
+        minimum = 0x10000;
+    }
+    else
+    {
+        // Continuation byte without lead byte, or invalid lead byte
+        return UTF8_REPLACEMENT_CODEPOINT;
+    }
 
-        if (c < 0x80)
-        {
-            bufferOut[strlen(bufferOut)] = c;
-        }
-        else if (c == 0xc3)
-        {
-            bufferOut[strlen(bufferOut)] = (bufferIn[++i] + 64);
-        }
-        else if (c == 0xc2)
+    while (remaining > 0)
+    {
+        // Truncated sequence, next byte left for next call
+        if ((index >= length) or (((uint8_t)text[index] & 0xc0) != 0x80))
         {
-            bufferOut[strlen(bufferOut)] = bufferIn[++i];
+            return UTF8_REPLACEMENT_CODEPOINT;
         }
-        else if (c == 0xe2)
+
+        codePoint = (codePoint << 6) | ((uint8_t)text[index] & 0x3f);
+        index += 1;
+        remaining -= 1;
+    }
+
+    if ((codePoint < minimum) or (codePoint > 0x10ffff) or ((codePoint >= 0xd800) and (codePoint <= 0xdfff)))
+    {
+        return UTF8_REPLACEMENT_CODEPOINT;
+    }
+
+    return codePoint;
+}
+
+// Windows-1252 0x80..0x9f, 0x0000 = undefined
+static const uint16_t codePoint1252[32] =
+{
+    0x20ac, 0x0000, 0x201a, 0x0192, 0x201e, 0x2026, 0x2020, 0x2021,
+    0x02c6, 0x2030, 0x0160, 0x2039, 0x0152, 0x0000, 0x017d, 0x0000,
+    0x0000, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+    0x02dc, 0x2122, 0x0161, 0x203a, 0x0153, 0x0000, 0x017e, 0x0178
+};
+
+uint8_t codePointToIso(uint32_t codePoint)
+{
+    // ASCII and ISO-8859-1, except C1 controls
+    if ((codePoint < 0x80) or ((codePoint >= 0xa0) and (codePoint <= 0xff)))
+    {
+        return (uint8_t)codePoint;
+    }
+
+    // Sparse Windows-1252 symbols
+    if ((codePoint > 0xff) and (codePoint <= 0xffff))
+    {
+        for (uint8_t index = 0; index < 32; index += 1)
         {
-            if ((bufferIn[i + 1] == 0x82) && (bufferIn[i + 2] == 0xac))
+            if (codePoint1252[index] == codePoint)
             {
-                bufferOut[strlen(bufferOut)] = 0x80;
-                i += 2;
+                return 0x80 + index;
             }
         }
     }
 
-    return bufferOut;
+    return UTF8_REPLACEMENT_GLYPH;
+}
+
+STRING_TYPE utf2iso(STRING_TYPE s)
+{
+    String work = "";
+    size_t length = s.length();
+    const char * text = s.c_str();
+
+    work.reserve(length);
+    size_t index = 0;
+    while (index < length)
+    {
+        work += (char)codePointToIso(utf8Next(text, length, index));
+    }
+
+    return work;
+}
+
+size_t utf2iso(const char * text, char * buffer, size_t size)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    size_t length = strlen(text);
+    size_t index = 0;
+    size_t count = 0;
+
+    while ((index < length) and (count < size - 1))
+    {
+        buffer[count] = (char)codePointToIso(utf8Next(text, length, index));
+        count += 1;
+    }
+    buffer[count] = 0x00;
+
+    return count;
 }
 
 uint16_t checkRange(uint16_t value, uint16_t valueMin, uint16_t valueMax)
@@ -224,3 +335,13 @@ uint32_t roundUp(uint32_t value, uint16_t modulo)
     }
     return result;
 }
+
+uint32_t hashFNV(const uint8_t * data, size_t size, uint32_t hash)
+{
+    for (size_t index = 0; index < size; index += 1)
+    {
+        hash ^= data[index];
+        hash *= 0x01000193;
+    }
+    return hash;
+}
@@ -81,10 +81,42 @@ int32_t cos32x100(int32_t degreesX100);
 ///
 int32_t sin32x100(int32_t degreesX100);
 
+///
+/// @brief Replacement glyph for code points outside the font range
+/// @note Question mark, available on all the Terminal fonts.
+/// The Terminal fonts have no solid block glyph, and glyph 0x7f differs between fonts.
+///
+#define UTF8_REPLACEMENT_GLYPH '?'
+
+///
+/// @brief Replacement code point for malformed UTF-8 sequences
+///
+#define UTF8_REPLACEMENT_CODEPOINT 0xfffd
+
+///
+/// @brief Streaming UTF-8 decoder
+/// @param text UTF-8 char array
+/// @param length number of bytes of the char array
+/// @param index position of the next byte to decode, updated
+/// @return Unicode code point, or UTF8_REPLACEMENT_CODEPOINT if malformed
+/// @note Stateless and without buffer, index moves forward by at least one byte.
+/// Overlong forms, surrogates and code points above U+10FFFF are malformed.
+///
+uint32_t utf8Next(const char * text, size_t length, size_t & index);
+
+///
+/// @brief Glyph of the Terminal fonts for a code point
+/// @param codePoint Unicode code point
+/// @return ISO-8859-1 character, or UTF8_REPLACEMENT_GLYPH if not available
+/// @note Windows-1252 symbols for 0x80..0x9f, as Euro sign, are also mapped.
+///
+uint8_t codePointToIso(uint32_t codePoint);
+
 ///
 /// @brief UTF-8 to ISO-8859-1 Converter
 /// @param s UTF-8 string, input
 /// @return ISO-8859-1 string, output
+/// @note Code points without glyph are replaced by UTF8_REPLACEMENT_GLYPH
 ///
 /// @see The Unicode Consortium. The Unicode Standard, Version 6.2.0,
 /// (Mountain View, CA: The Unicode Consortium, 2012. ISBN 978-1-936213-07-8)
@@ -92,6 +124,16 @@ int32_t sin32x100(int32_t degreesX100);
 ///
 STRING_TYPE utf2iso(STRING_TYPE s);
 
+///
+/// @brief UTF-8 to ISO-8859-1 Converter, caller-provided buffer
+/// @param text UTF-8 char array, input
+/// @param buffer ISO-8859-1 char array, output, null-terminated
+/// @param size size of the buffer, including the null terminator
+/// @return number of characters written, without the null terminator
+/// @note Reentrant, output truncated to size - 1 characters
+///
+size_t utf2iso(const char * text, char * buffer, size_t size);
+
 ///
 /// @brief Format string
 /// @details Based on vsprint
@@ -102,6 +144,19 @@ STRING_TYPE utf2iso(STRING_TYPE s);
 ///
 STRING_TYPE formatString(const char * format, ...);
 
+///
+/// @brief Format string, caller-provided buffer
+/// @details Based on vsnprint
+/// @param buffer char array, output, null-terminated
+/// @param size size of the buffer, including the null terminator
+/// @param format format with standard codes
+/// @param ... list of values
+/// @return number of characters written, without the null terminator
+/// @note Reentrant, output truncated to size - 1 characters
+/// @see http://www.cplusplus.com/reference/cstdio/printf/?kw=printf for codes
+///
+size_t formatBuffer(char * buffer, size_t size, const char * format, ...);
+
 ///
 /// @brief Remove leading and ending characters
 /// @param text input text
@@ -151,6 +206,16 @@ void setMinMax(uint16_t value, uint16_t & valueMin, uint16_t & valueMax);
 ///
 uint32_t roundUp(uint32_t value, uint16_t modulo);
 
+///
+/// @brief Hash
+/// @param data bytes to hash
+/// @param size number of bytes
+/// @param hash previous hash, to chain several calls, default = initial value
+/// @return FNV-1a hash, 32 bits
+/// @note Not cryptographic
+///
+uint32_t hashFNV(const uint8_t * data, size_t size, uint32_t hash = 0x811c9dc5);
+
 /// @}
 
 #endif // hV_UTILITIES_RELEASE
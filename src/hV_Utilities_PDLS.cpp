@@ -18,6 +18,7 @@
 // Release 805: Improved stability
 // Release 806: New library for Wide temperature only
 // Release 810: Added support for EXT4 and EPDK-Matter
+// Release 821: Added keep-warm power mode and bus suspend
 //
 
 // Library header
@@ -288,15 +289,21 @@ uint8_t hV_Utilities_PDLS::checkTemperatureMode(uint8_t updateMode)
     return updateMode;
 }
 
-void hV_Utilities_PDLS::setPowerProfile(uint8_t mode, uint8_t scope)
+void hV_Utilities_PDLS::setPowerProfile(uint8_t mode, uint8_t scope, uint32_t timeout)
 {
     u_suspendMode = mode;
     u_suspendScope = scope;
+    u_suspendTimeout = timeout;
 
     if (b_pin.panelPower == NOT_CONNECTED)
+    {
+        // Bus only
+        u_suspendScope &= ~FSM_GPIO_MASK;
+    }
+
+    if (u_suspendScope == POWER_SCOPE_NONE)
     {
         u_suspendMode = POWER_MODE_MANUAL;
-        u_suspendScope = POWER_SCOPE_NONE;
     }
 }
 
@@ -103,11 +103,18 @@ class hV_Utilities_PDLS : public hV_Board
     uint8_t checkTemperatureMode(uint8_t updateMode);
 
     /// @brief Set the power profile
-    /// @param mode default = POWER_MODE_AUTO, otherwise POWER_MODE_MANUAL
-    /// @param scope default = POWER_SCOPE_GPIO_ONLY, otherwise POWER_SCOPE_NONE
-    /// @note If panelPower is NOT_CONNECTED, (POWER_MODE_AUTO, POWER_SCOPE_GPIO_ONLY) defaults to (POWER_MODE_MANUAL, POWER_SCOPE_NONE)
+    /// @param mode default = POWER_MODE_AUTO, otherwise POWER_MODE_MANUAL or POWER_MODE_KEEP_WARM
+    /// @param scope default = POWER_SCOPE_GPIO_ONLY, otherwise POWER_SCOPE_NONE or POWER_SCOPE_BUS_GPIO
+    /// @param timeout idle timeout for POWER_MODE_KEEP_WARM, ms, default = POWER_IDLE_DEFAULT
+    /// @details With POWER_MODE_AUTO, the scope is suspended after each update.
+    /// With POWER_MODE_KEEP_WARM, the scope is suspended once the timeout has elapsed since the last update,
+    /// so closely spaced updates save the GPIO configuration, the reset and the SPI initialisation.
+    /// @note If panelPower is NOT_CONNECTED, the GPIO part is removed from the scope,
+    /// and a mode with nothing left to suspend defaults to POWER_MODE_MANUAL,
+    /// for example (POWER_MODE_AUTO, POWER_SCOPE_GPIO_ONLY) defaults to (POWER_MODE_MANUAL, POWER_SCOPE_NONE)
+    /// @note To be called after begin(), which sets (POWER_MODE_AUTO, POWER_SCOPE_GPIO_ONLY) if panelPower is defined
     ///
-    void setPowerProfile(uint8_t mode = POWER_MODE_AUTO, uint8_t scope = POWER_SCOPE_GPIO_ONLY);
+    void setPowerProfile(uint8_t mode = POWER_MODE_AUTO, uint8_t scope = POWER_SCOPE_GPIO_ONLY, uint32_t timeout = POWER_IDLE_DEFAULT);
 
     ///
     /// @brief Invert screen
@@ -173,6 +180,7 @@ class hV_Utilities_PDLS : public hV_Board
     bool u_flagOTP = false;
     uint8_t u_suspendMode = POWER_MODE_AUTO;
     uint8_t u_suspendScope = POWER_SCOPE_GPIO_ONLY;
+    uint32_t u_suspendTimeout = POWER_IDLE_DEFAULT; // ms, POWER_MODE_KEEP_WARM
 
     /// @endcond
 };